@@ -0,0 +1,32 @@
+/*
+ * BenchmarkUtils.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef BENCHMARKUTILS_H_
+#define BENCHMARKUTILS_H_
+
+#include <chrono>
+
+/**
+ * @brief Keeps the compiler from discarding a result that is never read.
+ *
+ * @param [in] pointer Result.
+ */
+inline void doNotOptimize(const void* pointer) {
+	asm volatile("" : : "r"(pointer) : "memory");
+}
+
+/**
+ * @brief Seconds elapsed since a steady clock time point.
+ *
+ * @param [in] start Start of the measured interval.
+ */
+inline double secondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+}
+
+#endif /* BENCHMARKUTILS_H_ */
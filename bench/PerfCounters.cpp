@@ -0,0 +1,139 @@
+/*
+ * PerfCounters.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "PerfCounters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/// @cond
+namespace {
+
+#ifdef __linux__
+struct EventConfig {
+	uint32_t type;
+	uint64_t config;
+};
+
+const EventConfig eventConfigs[PerfCounters::EventCount] = {
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+				| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES } };
+
+int openEvent(const EventConfig& config) {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = config.type;
+	attr.config = config.config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+			| PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+const char* const eventNames[PerfCounters::EventCount] = { "cycles", "instr",
+		"br-miss", "L1d-miss", "LLC-miss" };
+
+} // namespace
+/// @endcond
+
+PerfCounters::PerfCounters() {
+	for (int event = 0; event < EventCount; ++event) {
+		values[event] = 0;
+#ifdef __linux__
+		fds[event] = openEvent(eventConfigs[event]);
+		if (fds[event] < 0 && reason.empty()) {
+			reason = std::string("perf_event_open(") + eventNames[event]
+					+ "): " + std::strerror(errno);
+		}
+#else
+		fds[event] = -1;
+		reason = "perf_event_open is only available on Linux";
+#endif
+	}
+}
+
+PerfCounters::~PerfCounters() {
+	for (int fd : fds) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+}
+
+bool PerfCounters::available() const {
+	for (int fd : fds) {
+		if (fd >= 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PerfCounters::available(Event event) const {
+	return fds[event] >= 0;
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+	for (int fd : fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+void PerfCounters::stop() {
+#ifdef __linux__
+	for (int fd : fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	for (int event = 0; event < EventCount; ++event) {
+		values[event] = 0;
+		uint64_t data[3];
+		if (fds[event] < 0
+				|| read(fds[event], data, sizeof(data))
+						!= static_cast<ssize_t>(sizeof(data))) {
+			continue;
+		}
+		// data: value, time enabled, time running
+		if (data[2] != 0 && data[2] < data[1]) {
+			values[event] = static_cast<uint64_t>(static_cast<double>(data[0])
+					* data[1] / data[2]);
+		} else {
+			values[event] = data[0];
+		}
+	}
+#endif
+}
+
+uint64_t PerfCounters::value(Event event) const {
+	return values[event];
+}
+
+const char* PerfCounters::name(Event event) {
+	return eventNames[event];
+}
@@ -0,0 +1,92 @@
+/*
+ * PerfCounters.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Hardware counters read with perf_event_open around a benchmark.
+ *
+ * Each counter is opened on its own for the calling thread, user space only.
+ * Counters the kernel refuses (no PMU in the container or VM,
+ * perf_event_paranoid, seccomp) are reported as unavailable while the others
+ * keep working. Values are scaled when the kernel multiplexes counters.
+ */
+class PerfCounters {
+public:
+	/**
+	 * @brief Counted events.
+	 */
+	enum Event {
+		Cycles, //!< CPU cycles
+		Instructions, //!< Retired instructions
+		BranchMisses, //!< Mispredicted branches
+		L1dMisses, //!< L1 data cache read misses
+		LlcMisses, //!< Last level cache misses
+		EventCount
+	};
+
+	PerfCounters();
+	~PerfCounters();
+
+	/**
+	 * @brief true if at least one counter could be opened.
+	 */
+	bool available() const;
+
+	/**
+	 * @brief true if a counter could be opened.
+	 *
+	 * @param [in] event Counted event.
+	 */
+	bool available(Event event) const;
+
+	/**
+	 * @brief Why the counters are not available, empty if they all are.
+	 */
+	const std::string& error() const {
+		return reason;
+	}
+
+	/**
+	 * @brief Resets and starts every counter.
+	 */
+	void start();
+
+	/**
+	 * @brief Stops every counter.
+	 */
+	void stop();
+
+	/**
+	 * @brief Counter value between the last start() and stop().
+	 *
+	 * @param [in] event Counted event.
+	 * @return Scaled count, 0 if the counter is not available.
+	 */
+	uint64_t value(Event event) const;
+
+	/**
+	 * @brief Short column name of an event.
+	 *
+	 * @param [in] event Counted event.
+	 */
+	static const char* name(Event event);
+
+private:
+	int fds[EventCount];
+	uint64_t values[EventCount];
+	std::string reason;
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+};
+
+#endif /* PERFCOUNTERS_H_ */
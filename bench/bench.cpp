@@ -0,0 +1,279 @@
+/*
+ * bench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaComposer.h"
+#include "NmeaJsonDelta.h"
+#include "NmeaSentencePlan.h"
+#include "BenchmarkUtils.h"
+#include "PerfCounters.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @cond
+namespace {
+
+struct Benchmark {
+	std::string name;
+	std::function<void(std::size_t sentences)> run; // composes that many sentences
+};
+
+const std::string talker = "GP";
+const NmeaComposerValid validity = 0L;
+
+/*
+ * Value varying over the iterations, so that the formatted digits do too.
+ */
+inline double vary(std::size_t i, double scale) {
+	return static_cast<double>(i % 3600) * scale;
+}
+
+std::vector<Benchmark> composerBenchmarks() {
+	static const boost::posix_time::time_duration mtime(12, 34, 56, 789000);
+	static const boost::gregorian::date mdate(2026, 10, 18);
+	static const std::vector<TransducerMeasurement> measurements = { { 'C',
+			23.4f, 'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "BARO" }, { 'H',
+			55.0f, 'P', "HUMIDITY" } };
+
+	std::vector<Benchmark> benchmarks;
+	benchmarks.push_back( { "composeRMC(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeRMC(buffer, sizeof(buffer), talker, validity,
+					mtime, -12.0461 + vary(i, 1e-5), -77.0428, vary(i, 0.01),
+					vary(i, 0.1), mdate, -2.3);
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composeRMC(string)", [](std::size_t n) {
+		std::string nmea;
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeRMC(nmea, talker, validity, mtime,
+					-12.0461 + vary(i, 1e-5), -77.0428, vary(i, 0.01),
+					vary(i, 0.1), mdate, -2.3);
+			doNotOptimize(nmea.data());
+		}
+	} });
+	benchmarks.push_back( { "composeXDR(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeXDR(buffer, sizeof(buffer), talker, validity,
+					measurements);
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composeMWV(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeMWV(buffer, sizeof(buffer), talker, validity,
+					vary(i, 0.1), Nmea_AngleReference_Relative, vary(i, 0.01),
+					'N', 'A');
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composeMWD(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeMWD(buffer, sizeof(buffer), talker, validity,
+					vary(i, 0.1), vary(i, 0.1), vary(i, 0.01), vary(i, 0.005));
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composeHDT(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeHDT(buffer, sizeof(buffer), talker, validity,
+					vary(i, 0.1));
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composeHDT(string)", [](std::size_t n) {
+		std::string nmea;
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeHDT(nmea, talker, validity, vary(i, 0.1));
+			doNotOptimize(nmea.data());
+		}
+	} });
+	benchmarks.push_back( { "composeVLW(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeVLW(buffer, sizeof(buffer), talker, validity,
+					1000 + vary(i, 0.01), vary(i, 0.01));
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composeVHW(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composeVHW(buffer, sizeof(buffer), talker, validity,
+					vary(i, 0.1), vary(i, 0.1), vary(i, 0.01), vary(i, 0.02));
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composePRDID(buffer)", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposer::composePRDID(buffer, sizeof(buffer), validity,
+					vary(i, 0.01) - 18, vary(i, 0.01) - 18, vary(i, 0.1));
+			doNotOptimize(buffer);
+		}
+	} });
+
+	// Runtime definitions against the hand-written core composer
+	benchmarks.push_back( { "core composePRDID", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposerCore::composePRDID(buffer, sizeof(buffer), validity,
+					vary(i, 0.01) - 18, vary(i, 0.01) - 18, vary(i, 0.1));
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composePlan(PRDID)", [](std::size_t n) {
+		NmeaSentencePlan plan;
+		plan.compile("PRDID,%+06.2f,%+06.2f,%06.2f");
+		char buffer[128];
+		double values[3];
+		for (std::size_t i = 0; i < n; ++i) {
+			values[0] = vary(i, 0.01) - 18;
+			values[1] = vary(i, 0.01) - 18;
+			values[2] = vary(i, 0.1);
+			NmeaComposerCore::composePlan(buffer, sizeof(buffer), plan, "",
+					validity, values, 3);
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "composePlan(GGA)", [](std::size_t n) {
+		NmeaSentencePlan plan;
+		plan.compile("--GGA,time,lat,lon,%d,%02d,%.1f,%.1f,M,%.1f,M,,");
+		char buffer[128];
+		double values[] = { 0, -12.0461, -77.0428, 1, 9, 0.8, 0, 17.2 };
+		for (std::size_t i = 0; i < n; ++i) {
+			values[0] = 45296 + vary(i, 1);
+			values[6] = 150 + vary(i, 0.1);
+			NmeaComposerCore::composePlan(buffer, sizeof(buffer), plan, "GP",
+					validity, values, 8);
+			doNotOptimize(buffer);
+		}
+	} });
+
+	// Sentence and JSON delta from the same formatted digits
+	benchmarks.push_back( { "core composeVHW", [](std::size_t n) {
+		char buffer[128];
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposerCore::composeVHW(buffer, sizeof(buffer), "VW", validity,
+					vary(i, 0.1), vary(i, 0.1), 11.2, 20.7);
+			doNotOptimize(buffer);
+		}
+	} });
+	benchmarks.push_back( { "core composeVHW+json", [](std::size_t n) {
+		char buffer[128], json[512];
+		NmeaJsonDelta delta(json, sizeof(json));
+		for (std::size_t i = 0; i < n; ++i) {
+			NmeaComposerCore::composeVHW(buffer, sizeof(buffer), "VW", validity,
+					vary(i, 0.1), vary(i, 0.1), 11.2, 20.7, &delta);
+			doNotOptimize(buffer);
+			doNotOptimize(json);
+		}
+	} });
+	return benchmarks;
+}
+
+void printHeader(const PerfCounters& counters) {
+	if (!counters.available()) {
+		std::printf("Hardware counters unavailable (%s), reporting time only\n",
+				counters.error().c_str());
+	}
+	std::printf("%-28s %10s", "benchmark", "ns/sent");
+	for (int event = 0; event < PerfCounters::EventCount; ++event) {
+		std::printf(" %9s",
+				PerfCounters::name(static_cast<PerfCounters::Event>(event)));
+	}
+	std::printf(" %6s\n", "IPC");
+}
+
+/*
+ * Grows the sentence count until a run lasts minSeconds, then measures one
+ * more run with the counters enabled.
+ */
+void run(const Benchmark& benchmark, double minSeconds,
+		PerfCounters& counters) {
+	std::size_t sentences = 1;
+	for (;;) {
+		std::chrono::steady_clock::time_point start =
+				std::chrono::steady_clock::now();
+		benchmark.run(sentences);
+		double elapsed = secondsSince(start);
+		if (elapsed >= minSeconds / 10) {
+			sentences = static_cast<std::size_t>(sentences * minSeconds
+					/ elapsed) + 1;
+			break;
+		}
+		sentences *= 10;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	counters.start();
+	benchmark.run(sentences);
+	counters.stop();
+	double elapsed = secondsSince(start);
+
+	std::printf("%-28s %10.1f", benchmark.name.c_str(),
+			elapsed * 1e9 / sentences);
+	for (int event = 0; event < PerfCounters::EventCount; ++event) {
+		PerfCounters::Event e = static_cast<PerfCounters::Event>(event);
+		if (counters.available(e)) {
+			std::printf(" %9.2f",
+					static_cast<double>(counters.value(e)) / sentences);
+		} else {
+			std::printf(" %9s", "-");
+		}
+	}
+	if (counters.available(PerfCounters::Cycles)
+			&& counters.available(PerfCounters::Instructions)
+			&& counters.value(PerfCounters::Cycles) != 0) {
+		std::printf(" %6.2f\n",
+				static_cast<double>(counters.value(PerfCounters::Instructions))
+						/ counters.value(PerfCounters::Cycles));
+	} else {
+		std::printf(" %6s\n", "-");
+	}
+}
+
+} // namespace
+/// @endcond
+
+/*
+ * Usage: bench.libNmeaComposer [--min-time SECONDS] [FILTER]
+ *
+ * Runs the benchmarks whose name contains FILTER and prints, per sentence,
+ * the wall clock time and the hardware counters.
+ */
+int main(int argc, char* argv[]) {
+	double minSeconds = 0.5;
+	const char* filter = "";
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			minSeconds = std::atof(argv[++i]);
+		} else {
+			filter = argv[i];
+		}
+	}
+
+	PerfCounters counters;
+	printHeader(counters);
+	for (const Benchmark& benchmark : composerBenchmarks()) {
+		if (benchmark.name.find(filter) != std::string::npos) {
+			run(benchmark, minSeconds, counters);
+		}
+	}
+	return 0;
+}
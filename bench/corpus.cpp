@@ -0,0 +1,424 @@
+/*
+ * corpus.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaComposer.h"
+#include "NmeaAisReceivers.h"
+#include "NmeaFleetEncoder.h"
+#include "NmeaJournal.h"
+#include "BenchmarkUtils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+
+/// @cond
+namespace {
+
+/*
+ * Inputs of one compose call. Which values are used depends on the type.
+ */
+struct Input {
+	Nmea_SentenceType type;
+	uint32_t second; // voyage time
+	uint32_t xdr; // index of the XDR measurements
+	double values[6];
+};
+
+/*
+ * Simulated sensor feed of one vessel, generated before the measurement.
+ */
+struct Corpus {
+	std::vector<Input> inputs;
+	std::vector<std::vector<TransducerMeasurement> > measurements;
+};
+
+const unsigned prdidHz = 20;
+const unsigned hdtHz = 10;
+const unsigned xdrTransducers = 16;
+
+const std::string talkerGP = "GP";
+const std::string talkerHE = "HE";
+const std::string talkerWI = "WI";
+const std::string talkerVW = "VW";
+const std::string talkerYX = "YX";
+const NmeaComposerValid validity = 0L;
+const boost::gregorian::date voyageStart(2026, 10, 18);
+
+/*
+ * A vessel steaming at about 12 knots with some yaw, roll and pitch, under a
+ * slowly veering wind.
+ */
+Corpus generate(unsigned vessel, unsigned seconds) {
+	std::mt19937 random(vessel);
+	std::normal_distribution<double> noise(0, 1);
+	Corpus corpus;
+	double latitude = -12.0 - vessel * 0.1;
+	double longitude = -77.2;
+	double course = 240 + vessel;
+	double distance = 1000 + vessel;
+	for (unsigned second = 0; second < seconds; ++second) {
+		double speed = 12 + 0.3 * noise(random);
+		course += 0.05 * noise(random);
+		latitude += speed / 3600 / 60 * std::cos(course * M_PI / 180);
+		longitude += speed / 3600 / 60 * std::sin(course * M_PI / 180);
+		distance += speed / 3600;
+		double windDirection = 300 + 20 * std::sin(second / 600.0);
+		double windSpeed = 15 + 2 * noise(random);
+
+		corpus.inputs.push_back( { Nmea_SentenceType_RMC, second, 0, {
+				latitude, longitude, speed, course, -2.3 } });
+		for (unsigned i = 0; i < prdidHz; ++i) {
+			double t = second + static_cast<double>(i) / prdidHz;
+			corpus.inputs.push_back( { Nmea_SentenceType_PRDID, second, 0, {
+					3 * std::sin(t * 2 * M_PI / 7), 12 * std::sin(t * 2 * M_PI / 11),
+					course + std::sin(t) } });
+		}
+		for (unsigned i = 0; i < hdtHz; ++i) {
+			corpus.inputs.push_back( { Nmea_SentenceType_HDT, second, 0, {
+					std::fmod(course + 0.2 * noise(random) + 360, 360) } });
+		}
+
+		std::vector<TransducerMeasurement> measurements;
+		for (unsigned i = 0; i < xdrTransducers; ++i) {
+			static const char types[] = "CPHA";
+			static const char units[] = "CBPD";
+			TransducerMeasurement measurement;
+			measurement.transducerType = types[i % 4];
+			measurement.unitsOfMeasurement = units[i % 4];
+			measurement.measurementData = static_cast<float>(
+					(i % 4 == 1 ? 1.013 : 20.0) + 0.01 * noise(random));
+			measurement.nameOfTransducer = "SENSOR" + std::to_string(i);
+			measurements.push_back(measurement);
+		}
+		corpus.inputs.push_back( { Nmea_SentenceType_XDR, second,
+				static_cast<uint32_t>(corpus.measurements.size()), { } });
+		corpus.measurements.push_back(measurements);
+
+		corpus.inputs.push_back( { Nmea_SentenceType_MWV, second, 0, {
+				std::fmod(windDirection - course + 360, 360), windSpeed } });
+		corpus.inputs.push_back( { Nmea_SentenceType_MWD, second, 0, {
+				windDirection, windDirection + 2.3, windSpeed, windSpeed
+						* 0.5144 } });
+		corpus.inputs.push_back( { Nmea_SentenceType_VHW, second, 0, { course,
+				course + 2.3, speed, speed * 1.852 } });
+		corpus.inputs.push_back( { Nmea_SentenceType_VLW, second, 0, {
+				distance, distance - 1000 } });
+	}
+	return corpus;
+}
+
+std::size_t compose(const Corpus& corpus, const Input& input, char* buffer,
+		std::size_t size) {
+	const double* v = input.values;
+	switch (input.type) {
+	case Nmea_SentenceType_RMC:
+		return NmeaComposer::composeRMC(buffer, size, talkerGP, validity,
+				boost::posix_time::seconds(input.second % 86400), v[0], v[1],
+				v[2], v[3], voyageStart + boost::gregorian::days(input.second / 86400),
+				v[4]);
+	case Nmea_SentenceType_XDR:
+		return NmeaComposer::composeXDR(buffer, size, talkerYX, validity,
+				corpus.measurements[input.xdr]);
+	case Nmea_SentenceType_MWV:
+		return NmeaComposer::composeMWV(buffer, size, talkerWI, validity, v[0],
+				Nmea_AngleReference_Relative, v[1], 'N', 'A');
+	case Nmea_SentenceType_MWD:
+		return NmeaComposer::composeMWD(buffer, size, talkerWI, validity, v[0],
+				v[1], v[2], v[3]);
+	case Nmea_SentenceType_HDT:
+		return NmeaComposer::composeHDT(buffer, size, talkerHE, validity, v[0]);
+	case Nmea_SentenceType_VLW:
+		return NmeaComposer::composeVLW(buffer, size, talkerVW, validity, v[0],
+				v[1]);
+	case Nmea_SentenceType_VHW:
+		return NmeaComposer::composeVHW(buffer, size, talkerVW, validity, v[0],
+				v[1], v[2], v[3]);
+	case Nmea_SentenceType_PRDID:
+		return NmeaComposer::composePRDID(buffer, size, validity, v[0], v[1],
+				v[2]);
+	default:
+		return 0;
+	}
+}
+
+class NullSink: public NmeaSink {
+protected:
+	void writeSentence(const char* sentence, std::size_t) override {
+		doNotOptimize(sentence);
+	}
+
+	void flushSentences() override {
+	}
+};
+
+struct Result {
+	double seconds;
+	uint64_t sentences;
+	uint64_t bytes;
+	std::vector<int64_t> latencies; // compose and sink write, sampled
+};
+
+const std::size_t latencySampling = 16;
+
+int64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Every thread composes the corpus of its own vessel into the shared sink.
+ */
+Result run(const std::vector<Corpus>& corpora, unsigned threads,
+		NmeaSink& sink) {
+	std::vector<uint64_t> bytes(threads);
+	std::vector<std::vector<int64_t> > latencies(threads);
+	std::atomic<unsigned> ready(0);
+	std::atomic<bool> go(false);
+
+	std::vector<std::thread> workers;
+	for (unsigned t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t] {
+			const Corpus& corpus = corpora[t];
+			std::vector<int64_t>& sampled = latencies[t];
+			sampled.reserve(corpus.inputs.size() / latencySampling + 1);
+			char buffer[1024];
+			uint64_t total = 0;
+			ready.fetch_add(1);
+			while (!go.load()) {
+			}
+			for (std::size_t i = 0; i < corpus.inputs.size(); ++i) {
+				int64_t start = i % latencySampling == 0 ? nowNs() : 0;
+				std::size_t length = compose(corpus, corpus.inputs[i], buffer,
+						sizeof(buffer));
+				sink.write(buffer, length);
+				if (start != 0) {
+					sampled.push_back(nowNs() - start);
+				}
+				total += length;
+			}
+			bytes[t] = total;
+		});
+	}
+	while (ready.load() != threads) {
+		std::this_thread::yield();
+	}
+	std::chrono::steady_clock::time_point start =
+			std::chrono::steady_clock::now();
+	go = true;
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+	sink.flush();
+
+	Result result;
+	result.seconds = secondsSince(start);
+	result.sentences = 0;
+	result.bytes = 0;
+	for (unsigned t = 0; t < threads; ++t) {
+		result.sentences += corpora[t].inputs.size();
+		result.bytes += bytes[t];
+		result.latencies.insert(result.latencies.end(), latencies[t].begin(),
+				latencies[t].end());
+	}
+	std::sort(result.latencies.begin(), result.latencies.end());
+	return result;
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, double quantile) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	return sorted[std::min(sorted.size() - 1,
+			static_cast<std::size_t>(quantile * sorted.size()))];
+}
+
+void print(const char* sink, unsigned threads, const Result& result) {
+	std::printf("%-8s %7u %14.0f %10.1f %9lld %9lld %9lld\n", sink, threads,
+			result.sentences / result.seconds,
+			result.bytes / result.seconds / 1e6,
+			static_cast<long long>(percentile(result.latencies, 0.5)),
+			static_cast<long long>(percentile(result.latencies, 0.99)),
+			static_cast<long long>(percentile(result.latencies, 0.999)));
+}
+
+void removeJournal(const std::string& directory) {
+	if (DIR* dir = opendir(directory.c_str())) {
+		while (dirent* entry = readdir(dir)) {
+			if (entry->d_name[0] != '.') {
+				unlink((directory + "/" + entry->d_name).c_str());
+			}
+		}
+		closedir(dir);
+	}
+	rmdir(directory.c_str());
+}
+
+/*
+ * AIS traffic of a busy area, one third Class B, in slot time order.
+ */
+std::vector<NmeaAisTarget> generateFleet(std::size_t count) {
+	std::mt19937 random(count);
+	std::uniform_real_distribution<float> uniform(0, 1);
+	std::vector<NmeaAisTarget> fleet(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		NmeaAisTarget& target = fleet[i];
+		target.slotTime = i * 2250 / count;
+		target.channel = i % 2 ? 'B' : 'A';
+		uint mmsi = 200000000 + random() % 500000000;
+		float longitude = -78 + 2 * uniform(random);
+		float latitude = -13 + 2 * uniform(random);
+		float speed = 20 * uniform(random);
+		float course = 360 * uniform(random);
+		if (i % 3) {
+			target.messageType = Nmea_AisMessageType_PositionReportClassA;
+			target.positionReportClassA = { 0, mmsi,
+					Nmea_NavigationStatus_UnderWayUsingEngine, 0, speed,
+					Nmea_PositionAccuracy_DGPSQualityFix, longitude, latitude,
+					course, static_cast<uint>(course), 30,
+					Nmea_ManeuverIndicator_NotAvailable, Nmea_RAIM_NotInUse };
+		} else {
+			target.messageType =
+					Nmea_AisMessageType_StandardClassBCSPositionReport;
+			target.standardClassBCSPositionReport = { 0, mmsi, speed,
+					Nmea_PositionAccuracy_UnaugmentedGNSSFix, longitude,
+					latitude, course, 511, 30 };
+		}
+	}
+	return fleet;
+}
+
+/*
+ * Encodes the fleet repeatedly for about a second.
+ */
+void runFleet(const std::vector<NmeaAisTarget>& fleet, unsigned threads,
+		NmeaFleetOrder order, const char* name) {
+	NmeaFleetEncoder encoder(threads);
+	NullSink sink;
+	encoder.encode(fleet.data(), fleet.size(), order, sink);
+	std::chrono::steady_clock::time_point start =
+			std::chrono::steady_clock::now();
+	uint64_t sentences = 0;
+	unsigned rounds = 0;
+	do {
+		sentences += encoder.encode(fleet.data(), fleet.size(), order, sink);
+		++rounds;
+	} while (secondsSince(start) < 1);
+	double seconds = secondsSince(start);
+	std::printf("%-8s %7u %14.0f %10.2f\n", name, threads, sentences / seconds,
+			seconds / rounds * 1e3);
+}
+
+/*
+ * Broadcasts the fleet to receivers spread over its area for about a second.
+ */
+void runReceivers(const std::vector<NmeaAisTarget>& fleet, unsigned count) {
+	NmeaAisReceivers network(20);
+	NullSink sink;
+	std::mt19937 random(count);
+	std::uniform_real_distribution<double> uniform(0, 1);
+	for (unsigned r = 0; r < count; ++r) {
+		network.addReceiver(-13 + 2 * uniform(random), -78 + 2 * uniform(random),
+				20, sink);
+	}
+	std::chrono::steady_clock::time_point start =
+			std::chrono::steady_clock::now();
+	uint64_t sentences = 0;
+	unsigned rounds = 0;
+	do {
+		sentences += network.broadcast(fleet.data(), fleet.size());
+		++rounds;
+	} while (secondsSince(start) < 1);
+	double seconds = secondsSince(start);
+	std::printf("%9u %14.0f %14.0f %10.2f\n", count, sentences / seconds,
+			static_cast<double>(sentences) / rounds, seconds / rounds * 1e3);
+}
+
+} // namespace
+/// @endcond
+
+/*
+ * Usage: corpus.libNmeaComposer [--seconds VOYAGE_SECONDS] [--journal DIRECTORY]
+ *
+ * Composes the simulated sensor feed of one vessel per thread, at 1, 2, 4 and
+ * 8 threads, into a null sink and into an NmeaJournal, and prints sustained
+ * throughput and the latency percentiles of compose plus sink write. Then
+ * encodes the position reports of a 20000 target AIS fleet with
+ * NmeaFleetEncoder at the same thread counts, and broadcasts it to growing
+ * numbers of NmeaAisReceivers.
+ */
+int main(int argc, char* argv[]) {
+	unsigned seconds = 1800;
+	std::string journalParent = "/tmp";
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (std::strcmp(argv[i], "--seconds") == 0) {
+			seconds = std::atoi(argv[i + 1]);
+		} else if (std::strcmp(argv[i], "--journal") == 0) {
+			journalParent = argv[i + 1];
+		}
+	}
+
+	const unsigned threadCounts[] = { 1, 2, 4, 8 };
+	std::vector<Corpus> corpora;
+	for (unsigned vessel = 0; vessel < 8; ++vessel) {
+		corpora.push_back(generate(vessel, seconds));
+	}
+	std::printf("Corpus: %u s of voyage per vessel, %zu sentences/s: RMC 1 Hz, "
+			"PRDID %u Hz, HDT %u Hz, XDR with %u transducers, MWV, MWD, VHW "
+			"and VLW 1 Hz\n", seconds, corpora[0].inputs.size() / seconds,
+			prdidHz, hdtHz, xdrTransducers);
+	std::printf("%-8s %7s %14s %10s %9s %9s %9s\n", "sink", "threads",
+			"sentences/s", "MB/s", "p50 ns", "p99 ns", "p99.9 ns");
+
+	NullSink nullSink;
+	for (unsigned threads : threadCounts) {
+		print("null", threads, run(corpora, threads, nullSink));
+	}
+
+	for (unsigned threads : threadCounts) {
+		std::string directory = journalParent + "/nmeacorpus.XXXXXX";
+		if (mkdtemp(&directory[0]) == NULL) {
+			std::perror("mkdtemp");
+			return 1;
+		}
+		Result result;
+		{
+			NmeaJournal journal(directory);
+			result = run(corpora, threads, journal);
+		}
+		removeJournal(directory);
+		print("journal", threads, result);
+	}
+
+	std::vector<NmeaAisTarget> fleet = generateFleet(20000);
+	std::printf("\nAIS fleet: %zu targets\n", fleet.size());
+	std::printf("%-8s %7s %14s %10s\n", "order", "threads", "sentences/s",
+			"ms/fleet");
+	for (unsigned threads : threadCounts) {
+		runFleet(fleet, threads, NmeaFleetOrder_SlotTime, "slot");
+	}
+	for (unsigned threads : threadCounts) {
+		runFleet(fleet, threads, NmeaFleetOrder_Mmsi, "mmsi");
+	}
+
+	std::printf("\nAIS receivers of 20 NM range over the fleet\n");
+	std::printf("%9s %14s %14s %10s\n", "receivers", "sentences/s",
+			"sentences/tick", "ms/tick");
+	for (unsigned receivers : { 10u, 100u, 1000u }) {
+		runReceivers(fleet, receivers);
+	}
+	return 0;
+}
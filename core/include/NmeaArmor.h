@@ -0,0 +1,84 @@
+/*
+ * NmeaArmor.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAARMOR_H_
+#define NMEAARMOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Implementation of the 6 bit armoring.
+ */
+enum NmeaArmorKernel {
+	NmeaArmorKernel_Scalar, //!< Portable C++, 3 bytes to 4 characters at a time
+	NmeaArmorKernel_SSE4,   //!< SSE4.1, 12 bytes to 16 characters at a time
+	NmeaArmorKernel_AVX2    //!< AVX2, 24 bytes to 32 characters at a time
+};
+
+/**
+ * @brief AIS payload armoring.
+ *
+ * Converts a packed bit buffer, most significant bit first, into the 6 bit
+ * ASCII of the !AIVDM payload field: values 0 to 39 become '0' to 'W' and 40
+ * to 63 become '`' to 'w'. The XOR of the characters produced, their
+ * contribution to the sentence checksum, is computed in the same pass.
+ *
+ * The SIMD kernels are selected at run time from the CPU features, and only
+ * built on x86. Every kernel produces the same output.
+ */
+class NmeaArmor {
+public:
+
+	/**
+	 * @brief Armors with the fastest kernel the CPU supports.
+	 *
+	 * @param [in]  bits Packed bits, (bitCount + 7) / 8 bytes are read.
+	 * @param [in]  bitCount Number of bits. The last character is padded with
+	 * zero bits when bitCount is not a multiple of 6.
+	 * @param [out] payload Receives (bitCount + 5) / 6 characters, not null terminated.
+	 * @param [out] checksum XOR of the characters.
+	 *
+	 * @return Number of characters.
+	 */
+	static std::size_t armor(const uint8_t* bits, std::size_t bitCount,
+			char* payload, uint8_t& checksum);
+
+	/**
+	 * @brief Armors with a given kernel.
+	 *
+	 * Same as armor(), the kernel must be supported().
+	 *
+	 * @param [in]  kernel Kernel.
+	 * @param [in]  bits Packed bits.
+	 * @param [in]  bitCount Number of bits.
+	 * @param [out] payload Receives (bitCount + 5) / 6 characters.
+	 * @param [out] checksum XOR of the characters.
+	 *
+	 * @return Number of characters.
+	 */
+	static std::size_t armor(NmeaArmorKernel kernel, const uint8_t* bits,
+			std::size_t bitCount, char* payload, uint8_t& checksum);
+
+	/**
+	 * @brief Whether a kernel is built and runs on this CPU.
+	 */
+	static bool supported(NmeaArmorKernel kernel);
+
+	/**
+	 * @brief Kernel used by armor().
+	 */
+	static NmeaArmorKernel kernel();
+
+private:
+	/**
+	 * @brief Private constructor. Prevents creating of class instance.
+	 */
+	NmeaArmor();
+};
+
+#endif /* NMEAARMOR_H_ */
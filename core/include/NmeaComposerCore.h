@@ -0,0 +1,296 @@
+/*
+ * NmeaComposerCore.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEACOMPOSERCORE_H_
+#define NMEACOMPOSERCORE_H_
+
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include "NmeaCoreEnums.h"
+
+class NmeaJsonDelta;
+class NmeaSentencePlan;
+
+typedef std::bitset<16> NmeaComposerValid; //!<  Bitset. Each index represents the validity of each input parameter.
+
+/**
+ * @brief UTC calendar date of an RMC sentence.
+ */
+struct NmeaDate {
+	int year; //!< Year, e.g. 2026
+	int month; //!< Month, 1 to 12
+	int day; //!< Day of the month, 1 to 31
+};
+
+/**
+ * @brief Transducer Measurement of an XDR sentence, without any owned storage.
+ */
+struct NmeaTransducer {
+	char transducerType; //!< Transducer Type
+	float measurementData; //!< Measurement Data
+	char unitsOfMeasurement; //!< Measurement Units
+	const char* nameOfTransducer; //!< Name of transducer, null terminated
+};
+
+/**
+ * @brief Freestanding NMEA composers.
+ *
+ * The sentences are the same as the ones of NmeaComposer, which is a wrapper
+ * around this class. Only the C++ standard library is used: the sentence is
+ * formatted into a caller supplied buffer, nothing is allocated and nothing
+ * is thrown, so the library builds with -fno-exceptions -fno-rtti. There are
+ * no statistics nor logging at this level.
+ *
+ * Like snprintf, every composer truncates the sentence to size - 1
+ * characters, always null terminates it, and returns the length of the
+ * complete sentence. The sentence was truncated if the returned length is not
+ * smaller than size. A talker identifier that is not 2 characters long leaves
+ * the address field out.
+ */
+class NmeaComposerCore {
+public:
+
+	/**
+	 * @brief RMC NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in] 	utcTime UTC time of day
+	 * @param [in] 	latitude Latitude
+	 * @param [in] 	longitude Longitude
+	 * @param [in] 	speedknots Speed in Knots
+	 * @param [in] 	coursetrue Course relative to true north
+	 * @param [in] 	utcDate UTC date
+	 * @param [in] 	magneticvar Magnetic variation
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeRMC(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const std::chrono::microseconds utcTime, const double latitude,
+			const double longitude, const double speedknots,
+			const double coursetrue, const NmeaDate& utcDate,
+			const double magneticvar, NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief XDR NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  measurements Array of measurements
+	 * @param [in]  count Number of measurements
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeXDR(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const NmeaTransducer* measurements, std::size_t count,
+			NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief MWV NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  windAngle Wind Angle in degrees
+	 * @param [in]  reference Reference True or Relative
+	 * @param [in]  windSpeed Wind Speed
+	 * @param [in]  windSpeedUnits Wind Speed Units, K = km/hr, M = m/sec, N = kt
+	 * @param [in]  sensorStatus Sensor Status, A = Valid, V = Void
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeMWV(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const double windAngle, const Nmea_AngleReference reference,
+			const double windSpeed, const char windSpeedUnits,
+			const char sensorStatus, NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief MWD NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  trueWindDirection True Wind Direction in degrees
+	 * @param [in]  magneticWindDirection Magnetic Wind Direction in degrees
+	 * @param [in]  windSpeedKnots Wind Speed in knots
+	 * @param [in]  windSpeedMeters Wind Speed in meters per second
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeMWD(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const double trueWindDirection, const double magneticWindDirection,
+			const double windSpeedKnots, const double windSpeedMeters,
+			NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief HDT NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  headingDegreesTrue Heading in degrees relative to true north
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeHDT(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const double headingDegreesTrue, NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief VLW NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  totalCumulativeDistance Total cumulative distance in nautical miles
+	 * @param [in]  distanceSinceReset Distance since reset in nautical miles
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeVLW(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const double totalCumulativeDistance,
+			const double distanceSinceReset, NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief VHW NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  headingTrue Heading in degrees relative to true north
+	 * @param [in]  headingMagnetic Heading in degrees relative to magnetic north
+	 * @param [in]  speedInKnots Speed in knots
+	 * @param [in]  speedInKmH Speed in kilometers per hour
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeVHW(char* buffer, std::size_t size,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const double headingTrue, const double headingMagnetic,
+			const double speedInKnots, const double speedInKmH,
+			NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief PRDID NMEA Message composer
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in] 	validity Each field validity
+	 * @param [in]  pitch Pitch in degrees
+	 * @param [in]  roll Roll in degrees
+	 * @param [in]  heading Heading in degrees
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composePRDID(char* buffer, std::size_t size,
+			const NmeaComposerValid& validity, const double pitch,
+			const double roll, const double heading, NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief AIS Position Report Class A (message 1) composer
+	 *
+	 * Encodes the report into a single fragment !AIVDM sentence. NaN rate of
+	 * turn, speed, course, longitude or latitude are encoded as not available.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  report Position report, rate of turn in degrees per minute
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeAISPositionReportClassA(char* buffer,
+			std::size_t size, const AISPositionReportClassA& report,
+			char channel);
+
+	/**
+	 * @brief AIS Standard Class B CS Position Report (message 18) composer
+	 *
+	 * Encodes the report into a single fragment !AIVDM sentence, as sent by a
+	 * Class B CS unit. NaN speed, course, longitude or latitude are encoded as
+	 * not available.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  report Position report
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeAISStandardClassBCSPositionReport(char* buffer,
+			std::size_t size, const AISStandardClassBCSPositionReport& report,
+			char channel);
+
+	/**
+	 * @brief AIS Meteorological and Hydrological Data (message 8, DAC 1, FI 31) composer
+	 *
+	 * Encodes the report into a single fragment !AIVDM binary broadcast, in
+	 * the IMO SN.1/Circ.289 layout. Observations are rounded to the
+	 * resolution of the message and limited to its range; NaN observations,
+	 * longitude or latitude are encoded as not available.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  report Station and observations
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composeAISMeteorologicalHydrologicalData(char* buffer,
+			std::size_t size, const AISMeteorologicalHydrologicalData& report,
+			char channel);
+
+	/**
+	 * @brief Composer of a sentence defined at run time
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  plan Compiled sentence definition
+	 * @param [in]  talkerid Talker Identifier (2 characters), unused if the
+	 * address of the definition does not start with --
+	 * @param [in] 	validity Validity of each slot of the definition
+	 * @param [in]  values Inputs of the definition, in order
+	 * @param [in]  count Number of values. Missing inputs are left empty.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 */
+	static std::size_t composePlan(char* buffer, std::size_t size,
+			const NmeaSentencePlan& plan, const char* talkerid,
+			const NmeaComposerValid& validity, const double* values,
+			std::size_t count);
+
+private:
+	/**
+	 * @brief Private constructor. Prevents creating of class instance.
+	 */
+	NmeaComposerCore();
+};
+
+#endif /* NMEACOMPOSERCORE_H_ */
@@ -0,0 +1,305 @@
+/*
+ * NmeaCoreEnums.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEACOREENUMS_H_
+#define NMEACOREENUMS_H_
+
+#include <sys/types.h>
+#include "NmeaEnumNames.h"
+
+/**
+ * @brief Angle Reference in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
+ */
+enum Nmea_AngleReference {
+	Nmea_AngleReference_True,   //!< Nmea_AngleReference_True
+	Nmea_AngleReference_Relative//!< Nmea_AngleReference_Relative
+};
+
+/**
+ * @brief Names of Nmea_AngleReference values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_AngleReference> {
+	static constexpr std::size_t count = 2; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = { "True", "Relative" };
+};
+
+/**
+ * @brief Sentence types produced by NmeaComposer. New types are only ever appended, archived data refers to them by value.
+ */
+enum Nmea_SentenceType {
+	Nmea_SentenceType_RMC,  //!< Recommended Minimum Navigation Information
+	Nmea_SentenceType_XDR,  //!< Transducer Measurement
+	Nmea_SentenceType_MWV,  //!< Wind Speed and Angle
+	Nmea_SentenceType_MWD,  //!< Wind Direction & Speed
+	Nmea_SentenceType_HDT,  //!< Heading - True
+	Nmea_SentenceType_VLW,  //!< Distance Traveled through Water
+	Nmea_SentenceType_VHW,  //!< Water speed and heading
+	Nmea_SentenceType_PRDID,//!< Proprietary Heading, Pitch, Roll
+	Nmea_SentenceType_VDM,  //!< AIS VHF Data-link Message
+	Nmea_SentenceType_Count //!< Number of sentence types
+};
+
+/**
+ * @brief Names of Nmea_SentenceType values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_SentenceType> {
+	static constexpr std::size_t count = Nmea_SentenceType_Count; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"RMC",
+			"XDR",
+			"MWV",
+			"MWD",
+			"HDT",
+			"VLW",
+			"VHW",
+			"PRDID",
+			"VDM" };
+};
+
+/**
+ * @brief Navigation Status for AIS Class A. Used in AISPositionReportClassA
+ */
+enum Nmea_NavigationStatus {
+	Nmea_NavigationStatus_UnderWayUsingEngine,       //!< Under Way Using Engine
+	Nmea_NavigationStatus_AtAnchor,                  //!< At Anchor
+	Nmea_NavigationStatus_NotUnderCommand,           //!< Not Under Command
+	Nmea_NavigationStatus_RestrictedManeuverability, //!< Restricted Maneuverability
+	Nmea_NavigationStatus_ConstrainedByHerDraught,   //!< Constrained By Her Draught
+	Nmea_NavigationStatus_Moored,                    //!< Moored
+	Nmea_NavigationStatus_Aground,                   //!< Aground
+	Nmea_NavigationStatus_EngagedInFishing,          //!< Engaged In Fishing
+	Nmea_NavigationStatus_UnderWaySailing,           //!< Under Way Sailing
+	Nmea_NavigationStatus_Reserved_HSC,              //!< Reserved HSC
+	Nmea_NavigationStatus_Reserved_WIG,              //!< Reserved WIG
+	Nmea_NavigationStatus_Reserved1,                 //!< Reserved
+	Nmea_NavigationStatus_Reserved2,                 //!< Reserved
+	Nmea_NavigationStatus_Reserved3,                 //!< Reserved
+	Nmea_NavigationStatus_AIS_SART,                  //!< AIS SART
+	Nmea_NavigationStatus_NotDefined                 //!< Not Defined
+};
+
+/**
+ * @brief Names of Nmea_NavigationStatus values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_NavigationStatus> {
+	static constexpr std::size_t count = 16; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"UnderWayUsingEngine",
+			"AtAnchor",
+			"NotUnderCommand",
+			"RestrictedManeuverability",
+			"ConstrainedByHerDraught",
+			"Moored",
+			"Aground",
+			"EngagedInFishing",
+			"UnderWaySailing",
+			"Reserved_HSC",
+			"Reserved_WIG",
+			"Reserved1",
+			"Reserved2",
+			"Reserved3",
+			"AIS_SART",
+			"NotDefined" };
+};
+
+/**
+ * @brief Position Accuracy for AIS. Used in AISPositionReportClassA, AISBaseStationReport and AISStandardClassBCSPositionReport.
+ */
+enum Nmea_PositionAccuracy {
+	Nmea_PositionAccuracy_UnaugmentedGNSSFix,//!< Unaugmented GNSS Fix
+	Nmea_PositionAccuracy_DGPSQualityFix     //!< DGPS Quality Fix
+};
+
+/**
+ * @brief Names of Nmea_PositionAccuracy values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_PositionAccuracy> {
+	static constexpr std::size_t count = 2; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"UnaugmentedGNSSFix",
+			"DGPSQualityFix" };
+};
+
+/**
+ * @brief Maneuver Indicator for AIS. Used in AISPositionReportClassA.
+ */
+enum Nmea_ManeuverIndicator {
+	Nmea_ManeuverIndicator_NotAvailable,     //!< Not Available
+	Nmea_ManeuverIndicator_NoSpecialManeuver,//!< No Special Maneuver
+	Nmea_ManeuverIndicator_SpecialManeuver   //!< Special Maneuver
+};
+
+/**
+ * @brief Names of Nmea_ManeuverIndicator values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_ManeuverIndicator> {
+	static constexpr std::size_t count = 3; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"NotAvailable",
+			"NoSpecialManeuver",
+			"SpecialManeuver" };
+};
+
+/**
+ * @brief RAIM for AIS. Used in AISPositionReportClassA and AISBaseStationReport.
+ */
+enum Nmea_RAIM {
+	Nmea_RAIM_NotInUse,//!< Not In Use
+	Nmea_RAIM_InUse    //!< In Use
+};
+
+/**
+ * @brief Names of Nmea_RAIM values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_RAIM> {
+	static constexpr std::size_t count = 2; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = { "NotInUse", "InUse" };
+};
+
+/**
+ * @brief Struct used to parse Position Report Class A Ais Message. Used in NmeaParser::parseAISPositionReportClassA().
+ */
+struct AISPositionReportClassA {
+	int repeatIndicator; //!< Message repeat count
+	uint mmsi; //!< 9 decimal digits ID
+	Nmea_NavigationStatus navigationStatus; //!< Navigation Status
+	float rateOfTurn; //!< Rate of Turn
+	float speedOverGround; //!< Speed Over Ground
+	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+	float courseOverGround; //!< Course Over Ground
+	uint trueHeading; //!< True Heading
+	uint timestapUTCSecond; //!< Timestamp UTC second
+	Nmea_ManeuverIndicator maneuverIndicator; //!< Maneuver Indicator
+	Nmea_RAIM raim; //!< RAIM
+};
+
+/**
+ * @brief Struct used to parse Standard Class B CS Position Report Ais Message. Used in NmeaParser::parseAISStandardClassBCSPositionReport().
+ */
+struct AISStandardClassBCSPositionReport {
+	int repeatIndicator; //!< Message repeat count
+	uint mmsi; //!< 9 decimal digits ID
+	float speedOverGround; //!< Speed Over Ground
+	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+	float courseOverGround; //!< Course Over Ground
+	uint trueHeading; //!< True Heading
+	uint timestapUTCSecond; //!< Timestamp UTC second
+};
+
+/**
+ * @brief Observations of the AIS Meteorological and Hydrological Data binary
+ * broadcast (message 8, DAC 1, FI 31), in the order of the message. Used in
+ * AISMeteorologicalHydrologicalData.
+ */
+enum Nmea_MetHydroField {
+	Nmea_MetHydroField_AverageWindSpeed,       //!< Average wind speed of the last 10 minutes, knots
+	Nmea_MetHydroField_WindGust,               //!< Maximum wind gust of the last 10 minutes, knots
+	Nmea_MetHydroField_WindDirection,          //!< Wind direction, degrees true
+	Nmea_MetHydroField_WindGustDirection,      //!< Wind gust direction, degrees true
+	Nmea_MetHydroField_AirTemperature,         //!< Dry bulb air temperature, degrees Celsius
+	Nmea_MetHydroField_RelativeHumidity,       //!< Relative humidity, percent
+	Nmea_MetHydroField_DewPoint,               //!< Dew point, degrees Celsius
+	Nmea_MetHydroField_AirPressure,            //!< Air pressure, hPa
+	Nmea_MetHydroField_PressureTendency,       //!< 0 steady, 1 decreasing, 2 increasing
+	Nmea_MetHydroField_HorizontalVisibility,   //!< Horizontal visibility, nautical miles
+	Nmea_MetHydroField_WaterLevel,             //!< Water level including tide, metres
+	Nmea_MetHydroField_WaterLevelTrend,        //!< 0 steady, 1 decreasing, 2 increasing
+	Nmea_MetHydroField_SurfaceCurrentSpeed,    //!< Surface current speed, knots
+	Nmea_MetHydroField_SurfaceCurrentDirection,//!< Surface current direction, degrees true
+	Nmea_MetHydroField_Current2Speed,          //!< Current 2 speed, knots
+	Nmea_MetHydroField_Current2Direction,      //!< Current 2 direction, degrees true
+	Nmea_MetHydroField_Current2Level,          //!< Current 2 measuring level, metres below the surface
+	Nmea_MetHydroField_Current3Speed,          //!< Current 3 speed, knots
+	Nmea_MetHydroField_Current3Direction,      //!< Current 3 direction, degrees true
+	Nmea_MetHydroField_Current3Level,          //!< Current 3 measuring level, metres below the surface
+	Nmea_MetHydroField_WaveHeight,             //!< Significant wave height, metres
+	Nmea_MetHydroField_WavePeriod,             //!< Wave period, seconds
+	Nmea_MetHydroField_WaveDirection,          //!< Wave direction, degrees true
+	Nmea_MetHydroField_SwellHeight,            //!< Swell height, metres
+	Nmea_MetHydroField_SwellPeriod,            //!< Swell period, seconds
+	Nmea_MetHydroField_SwellDirection,         //!< Swell direction, degrees true
+	Nmea_MetHydroField_SeaState,               //!< Sea state, Beaufort scale
+	Nmea_MetHydroField_WaterTemperature,       //!< Water temperature, degrees Celsius
+	Nmea_MetHydroField_PrecipitationType,      //!< Precipitation type, WMO code 0 to 6
+	Nmea_MetHydroField_Salinity,               //!< Salinity, per mille
+	Nmea_MetHydroField_Ice,                    //!< 0 no, 1 yes
+	Nmea_MetHydroField_Count                   //!< Number of observations
+};
+
+/**
+ * @brief Names of Nmea_MetHydroField values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_MetHydroField> {
+	static constexpr std::size_t count = Nmea_MetHydroField_Count; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"AverageWindSpeed",
+			"WindGust",
+			"WindDirection",
+			"WindGustDirection",
+			"AirTemperature",
+			"RelativeHumidity",
+			"DewPoint",
+			"AirPressure",
+			"PressureTendency",
+			"HorizontalVisibility",
+			"WaterLevel",
+			"WaterLevelTrend",
+			"SurfaceCurrentSpeed",
+			"SurfaceCurrentDirection",
+			"Current2Speed",
+			"Current2Direction",
+			"Current2Level",
+			"Current3Speed",
+			"Current3Direction",
+			"Current3Level",
+			"WaveHeight",
+			"WavePeriod",
+			"WaveDirection",
+			"SwellHeight",
+			"SwellPeriod",
+			"SwellDirection",
+			"SeaState",
+			"WaterTemperature",
+			"PrecipitationType",
+			"Salinity",
+			"Ice" };
+};
+
+/**
+ * @brief Struct used to compose Meteorological and Hydrological Data Ais Message (message 8, DAC 1, FI 31).
+ */
+struct AISMeteorologicalHydrologicalData {
+	int repeatIndicator; //!< Message repeat count
+	uint mmsi; //!< 9 decimal digits ID of the station
+	float longitude; //!< Longitude of the station
+	float latitude; //!< Latitude of the station
+	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
+	uint utcDay; //!< UTC day of the observations, 0 when not available
+	uint utcHour; //!< UTC hour of the observations, 24 when not available
+	uint utcMinute; //!< UTC minute of the observations, 60 when not available
+	float observations[Nmea_MetHydroField_Count]; //!< Observations by Nmea_MetHydroField, NaN when not available
+};
+
+#endif /* NMEACOREENUMS_H_ */
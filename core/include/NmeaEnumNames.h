@@ -0,0 +1,72 @@
+/*
+ * NmeaEnumNames.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAENUMNAMES_H_
+#define NMEAENUMNAMES_H_
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Name of an enumerator value with its length, pointing to a string literal.
+ */
+struct NmeaEnumName {
+	/**
+	 * @brief Name from a string literal.
+	 * @param text String literal.
+	 */
+	template<std::size_t N>
+	constexpr NmeaEnumName(const char (&text)[N]) :
+			name(text), length(N - 1) {
+	}
+
+	const char* name; //!< Null terminated name
+	std::size_t length; //!< Length of name, not counting the terminator
+};
+
+/**
+ * @brief Name table of an enumerator, specialized next to each enum.
+ *
+ * A specialization has a count of values, numbered from 0, and a constexpr
+ * array of their names. The names are the enumerators without the enum
+ * prefix, e.g. "UnderWayUsingEngine" for Nmea_NavigationStatus_UnderWayUsingEngine.
+ */
+template<typename E>
+struct NmeaEnumTraits;
+
+/**
+ * @brief Name of an enumerator value, without iostream.
+ * @param value Enumerator value.
+ * @return Name and length, "Unknown" for a value out of range.
+ */
+template<typename E>
+constexpr NmeaEnumName nmeaEnumName(E value) {
+	return static_cast<std::size_t>(value) < NmeaEnumTraits<E>::count ?
+			NmeaEnumTraits<E>::names[value] : NmeaEnumName("Unknown");
+}
+
+/**
+ * @brief Enumerator value of a name, the reverse of nmeaEnumName().
+ * @param [in] name Name, not necessarily null terminated.
+ * @param [in] length Length of name.
+ * @param [out] value Enumerator value, unchanged if the name is unknown.
+ * @return true if the name was found.
+ */
+template<typename E>
+bool nmeaEnumFromName(const char* name, std::size_t length, E& value) {
+	for (std::size_t i = 0; i < NmeaEnumTraits<E>::count; ++i) {
+		const NmeaEnumName& candidate = NmeaEnumTraits<E>::names[i];
+		if (candidate.length == length
+				&& std::memcmp(candidate.name, name, length) == 0) {
+			value = static_cast<E>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif /* NMEAENUMNAMES_H_ */
@@ -0,0 +1,131 @@
+/*
+ * NmeaJsonDelta.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAJSONDELTA_H_
+#define NMEAJSONDELTA_H_
+
+#include <chrono>
+#include <cstddef>
+
+struct NmeaDate;
+
+/**
+ * @brief Signal K style JSON delta written along with a sentence.
+ *
+ * Given to a composer of NmeaComposerCore, it receives in the same call a
+ * delta holding the values of the sentence:
+ * @code
+ * {"updates":[{"source":{"label":"nmea","talker":"HE","sentence":"HDT"},
+ *   "values":[{"path":"navigation.headingTrue","value":57.34}]}]}
+ * @endcode
+ * without the line breaks. Each value is formatted once, for the sentence
+ * field, and the same digits are copied to the delta, leading zeros and
+ * plus sign removed. Values are therefore in the units of the sentence
+ * (degrees, knots, the units of a transducer), not the SI units of Signal K.
+ * The position, written as degrees and minutes in sentences, is the one
+ * value formatted again, in decimal degrees. RMC gives the delta its
+ * timestamp. Invalid fields are left out.
+ *
+ * Each composition replaces the delta. Like the sentences, it is truncated
+ * to size - 1 characters, always null terminated, and length() is the one
+ * of the complete delta. Nothing is allocated.
+ *
+ * The paths of XDR measurements are "transducers." followed by the name of
+ * the transducer. The source label and the names are escaped as JSON
+ * strings: quotes, backslashes and control characters.
+ */
+class NmeaJsonDelta {
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated delta.
+	 * @param [in] size Size of buffer.
+	 * @param [in] label Label of the source, which must outlive the delta.
+	 */
+	NmeaJsonDelta(char* buffer, std::size_t size, const char* label = "nmea");
+
+	/**
+	 * @brief The delta of the last composition.
+	 */
+	const char* data() const {
+		return buffer;
+	}
+
+	/**
+	 * @brief Length of the complete delta, not counting the terminator.
+	 *
+	 * The delta was truncated if it is not smaller than the buffer size.
+	 */
+	std::size_t length() const {
+		return count;
+	}
+
+	/**
+	 * @brief Starts a delta, discarding the previous one.
+	 *
+	 * @param [in] talkerid Talker identifier, left out if not 2 characters.
+	 * @param [in] sentence Sentence formatter, e.g. "HDT".
+	 */
+	void begin(const char* talkerid, const char* sentence);
+
+	/**
+	 * @brief Adds a value from the characters of its sentence field.
+	 *
+	 * @param [in] path Signal K style path.
+	 * @param [in] text Number as formatted in the sentence, e.g. "+005.20".
+	 * @param [in] textLength Number of characters.
+	 * @param [in] negative Whether the value is negative although written
+	 * without sign, as a magnetic variation to the West.
+	 */
+	void value(const char* path, const char* text, std::size_t textLength,
+			bool negative = false);
+
+	/**
+	 * @brief Adds the navigation.position value.
+	 *
+	 * @param [in] latitude Latitude, degrees.
+	 * @param [in] longitude Longitude, degrees.
+	 */
+	void position(double latitude, double longitude);
+
+	/**
+	 * @brief Sets the timestamp of the delta.
+	 *
+	 * @param [in] date UTC date.
+	 * @param [in] time UTC time of day.
+	 */
+	void timestamp(const NmeaDate& date, std::chrono::microseconds time);
+
+	/**
+	 * @brief Completes the delta.
+	 *
+	 * @return Length of the complete delta.
+	 */
+	std::size_t finish();
+
+private:
+	NmeaJsonDelta(const NmeaJsonDelta&) = delete;
+	NmeaJsonDelta& operator=(const NmeaJsonDelta&) = delete;
+
+	void separate();
+	void append(const char* text, std::size_t textLength);
+	void append(const char* text);
+	void appendEscaped(const char* text);
+	void format(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+	char* buffer;
+	std::size_t size;
+	std::size_t count;
+	const char* label;
+	std::size_t valueCount;
+	bool hasTimestamp;
+	int year, month, day;
+	long long microseconds;
+};
+
+#endif /* NMEAJSONDELTA_H_ */
@@ -0,0 +1,83 @@
+/*
+ * NmeaMetHydro.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAMETHYDRO_H_
+#define NMEAMETHYDRO_H_
+
+#include <cstddef>
+#include "NmeaComposerCore.h"
+
+/**
+ * @brief Maps XDR transducer measurements to the observations of the AIS
+ * Meteorological and Hydrological Data message.
+ *
+ * A measurement goes to the observation assigned to its transducer name.
+ * Names are compared exactly; the default table holds the usual ones:
+ * - AIRTEMP, ENV_OUTAIR_T: AirTemperature
+ * - WATERTEMP, ENV_WATER_T: WaterTemperature
+ * - DEWPOINT, ENV_DEWPOINT: DewPoint
+ * - BARO, ENV_ATMOS_P: AirPressure
+ * - RH, ENV_OUTSIDE_H: RelativeHumidity
+ * - SALINITY: Salinity
+ *
+ * A measurement with a name not in the table goes by its transducer type:
+ * 'C' to AirTemperature, 'P' to AirPressure and 'H' to RelativeHumidity,
+ * unless a named measurement of the same set gave that observation. Other
+ * measurements are ignored.
+ *
+ * Values are converted to the units of the message from the XDR units:
+ * temperatures from 'K', pressure from 'B' (bar) and 'P' (pascal), speeds
+ * from 'M' (m/s) and 'K' (km/h), visibility from 'M' (metres) and 'K' (km).
+ * Any other unit is taken to be the one of the message.
+ *
+ * Like NmeaComposerCore, nothing is allocated and nothing is thrown.
+ */
+class NmeaMetHydro {
+public:
+	static const std::size_t maxNames = 32; //!< Names the table holds
+	static const std::size_t maxNameLength = 23; //!< Longest name in the table
+
+	/**
+	 * @brief Starts with the default name table.
+	 */
+	NmeaMetHydro();
+
+	/**
+	 * @brief Assigns a transducer name to an observation, replacing its previous assignment.
+	 *
+	 * @param [in] nameOfTransducer Name of transducer, null terminated.
+	 * @param [in] field Observation receiving the measurements of that name.
+	 * @return false if the name is longer than maxNameLength or the table is full.
+	 */
+	bool assign(const char* nameOfTransducer, Nmea_MetHydroField field);
+
+	/**
+	 * @brief Stores the measurements in the observations of a report.
+	 *
+	 * Observations without a measurement keep their value, so a report can
+	 * also hold e.g. the wind of an MWV sentence.
+	 *
+	 * @param [in] measurements Array of measurements
+	 * @param [in] count Number of measurements
+	 * @param [in,out] report Report receiving the observations
+	 * @return Number of observations stored, a later measurement replacing
+	 * an earlier one of the same observation counted once.
+	 */
+	std::size_t map(const NmeaTransducer* measurements, std::size_t count,
+			AISMeteorologicalHydrologicalData& report) const;
+
+private:
+	struct Name {
+		char text[maxNameLength + 1];
+		Nmea_MetHydroField field;
+	};
+
+	Name names[maxNames];
+	std::size_t nameCount;
+};
+
+#endif /* NMEAMETHYDRO_H_ */
@@ -0,0 +1,129 @@
+/*
+ * NmeaSentencePlan.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASENTENCEPLAN_H_
+#define NMEASENTENCEPLAN_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sentence defined at run time, compiled into an execution plan.
+ *
+ * A definition is the comma separated list of the sentence fields, the first
+ * one being the address:
+ * - <b>--XXX</b> Talker identifier given when composing, then XXX. Left out
+ * like in the other composers when the talker identifier is not 2 characters.
+ * - <b>PXXXX</b>, or any address not starting with --, is written as is, as
+ * for proprietary sentences.
+ *
+ * Every other field is one of:
+ * - <b>%[flags][width][.precision]f</b>, also e or g: the next input, formatted as with printf.
+ * - <b>%[flags][width]d</b>: the next input rounded to an integer.
+ * - Either of them followed by <b>:XY</b>, e.g. <b>%.1f:EW</b>: the absolute
+ * value of the next input, then a field with X if it is positive or zero and
+ * Y if it is negative.
+ * - <b>time</b>, <b>time0</b> to <b>time3</b>: the next input, UTC seconds
+ * since midnight, as hhmmss with 2 or the given number of decimals.
+ * - <b>lat</b>, <b>lon</b>, or with 0 to 7 decimals such as <b>lat4</b>: the
+ * next input, degrees, as ddmm.mmmm or dddmm.mmmm and its hemisphere field.
+ * 4 decimals when not given.
+ * - Anything else, e.g. <b>T</b> or an empty field, is written as is. Quotes
+ * make a literal of a keyword: <b>'time'</b>.
+ *
+ * Each input has a validity slot, the index of its bit in NmeaComposerValid,
+ * numbered from 0 in order. A field ending with <b>@n</b> uses slot n
+ * instead; a literal ending with @n is only written while slot n is valid.
+ * An invalid input leaves its fields empty.
+ *
+ * Compiling parses the definition once, checks the formats and stores the
+ * fields, formats and literals in the plan itself. Composing with
+ * NmeaComposerCore::composePlan() then only runs the steps: no parsing, no
+ * lookups and no allocation, the same work a hand-written composer does.
+ *
+ * For instance "--HDT,%06.2f,T" composes the same sentence as
+ * NmeaComposerCore::composeHDT() and "--GLL,lat,lon,time,A,A" a GLL
+ * sentence from latitude, longitude and time.
+ */
+class NmeaSentencePlan {
+public:
+	static const std::size_t maxSteps = 48; //!< Fields a plan holds, address included
+	static const std::size_t maxText = 384; //!< Characters of the address, formats and literals
+
+	/**
+	 * @brief Empty plan, composing nothing until compiled.
+	 */
+	NmeaSentencePlan();
+
+	/**
+	 * @brief Compiles a definition, replacing the plan.
+	 *
+	 * @param [in] definition Null terminated definition.
+	 * @return false if the definition is not valid, the plan is then empty.
+	 */
+	bool compile(const char* definition);
+
+	/**
+	 * @brief Whether the plan holds a compiled definition.
+	 */
+	bool compiled() const {
+		return stepCount != 0;
+	}
+
+	/**
+	 * @brief Offset in the definition of the field that failed to compile.
+	 */
+	std::size_t errorOffset() const {
+		return error;
+	}
+
+	/**
+	 * @brief Number of inputs a sentence takes.
+	 */
+	std::size_t inputs() const {
+		return inputCount;
+	}
+
+private:
+	friend class NmeaComposerCore;
+
+	enum Operation {
+		Operation_Address,      // text, preceded by the talker if talker
+		Operation_Literal,      // text
+		Operation_Float,        // printf format in text
+		Operation_Integer,      // printf format in text
+		Operation_Time,         // digits decimals
+		Operation_Latitude,     // digits decimals
+		Operation_Longitude     // digits decimals
+	};
+
+	struct Step {
+		uint8_t operation;
+		uint8_t slot; // validity slot, noSlot for an unconditional literal
+		uint8_t input;
+		uint8_t digits;
+		uint16_t text; // offset in text
+		uint8_t textLength;
+		uint8_t textChecksum;
+		bool signLetters; // the two letters follow the format in text
+	};
+
+	static const uint8_t noSlot = 0xFF;
+
+	bool compileField(const char* field, std::size_t length);
+	bool addText(const char* field, std::size_t length, Step& step);
+
+	Step steps[maxSteps];
+	std::size_t stepCount;
+	char text[maxText];
+	std::size_t textLength;
+	std::size_t inputCount;
+	bool talker;
+	std::size_t error;
+};
+
+#endif /* NMEASENTENCEPLAN_H_ */
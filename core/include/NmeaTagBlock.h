@@ -0,0 +1,104 @@
+/*
+ * NmeaTagBlock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEATAGBLOCK_H_
+#define NMEATAGBLOCK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Unit of the TAG block c: timestamp.
+ */
+enum NmeaTagTime {
+	NmeaTagTime_Seconds,     //!< Unix seconds, as in NMEA 4.10
+	NmeaTagTime_Milliseconds //!< Unix milliseconds, as written by some equipment
+};
+
+/**
+ * @brief NMEA 4.10 TAG blocks of one source.
+ *
+ * Writes <b>\\s:SOURCE,d:DESTINATION,c:TIME,n:LINE*hh\\</b> in front of the
+ * sentences of a source. The source and destination part, and its share of
+ * the TAG block checksum, are formatted once at construction; per sentence
+ * only the time and line count digits are produced. The line count starts at
+ * 1 and is an atomic counter, so a source may be shared by several threads
+ * without locks; lines are then numbered in the order they were tagged.
+ *
+ * Buffers behave like the NmeaComposerCore ones: truncated to size - 1
+ * characters, always null terminated, and the complete length returned.
+ */
+class NmeaTagBlock {
+public:
+	static const std::size_t maxPrefix = 64; //!< Longest source and destination part
+
+	/**
+	 * @brief Formats the static part of the TAG blocks.
+	 *
+	 * Identifiers are cut so that the static part fits in maxPrefix characters.
+	 *
+	 * @param [in] source Source identifier, e.g. "GP0001". Null or "" leaves s: out.
+	 * @param [in] destination Destination identifier. Null or "" leaves d: out.
+	 * @param [in] time Unit of the c: timestamp.
+	 */
+	explicit NmeaTagBlock(const char* source, const char* destination = 0,
+			NmeaTagTime time = NmeaTagTime_Seconds);
+
+	/**
+	 * @brief Writes the TAG block of the next line.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated TAG block
+	 * @param [in]  size Size of buffer
+	 * @param [in]  utcNs UTC time in nanoseconds since the Unix epoch, negative leaves c: out.
+	 *
+	 * @return Length of the complete TAG block, not counting the terminator.
+	 */
+	std::size_t write(char* buffer, std::size_t size, int64_t utcNs);
+
+	/**
+	 * @brief Writes the TAG block of the next line followed by a sentence.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated tagged sentence
+	 * @param [in]  size Size of buffer
+	 * @param [in]  utcNs UTC time in nanoseconds since the Unix epoch.
+	 * @param [in]  composer Buffer composer, called as composer(buffer, size) and
+	 * returning the length of the complete sentence like the NmeaComposerCore
+	 * composers.
+	 *
+	 * @return Length of the complete tagged sentence, not counting the terminator.
+	 */
+	template<typename Compose>
+	std::size_t compose(char* buffer, std::size_t size, int64_t utcNs,
+			Compose composer) {
+		std::size_t length = write(buffer, size, utcNs);
+		if (length < size) {
+			return length + composer(buffer + length, size - length);
+		}
+		return length + composer(static_cast<char*>(0), 0);
+	}
+
+	/**
+	 * @brief Number of lines tagged so far.
+	 */
+	uint64_t lines() const {
+		return lineCount.load(std::memory_order_relaxed);
+	}
+
+private:
+	char prefix[maxPrefix + 1]; //!< '\\' and the static fields
+	std::size_t prefixLength;
+	uint8_t prefixChecksum; //!< XOR of the static fields, without the '\\'
+	bool separator; //!< Whether a ',' precedes the next field
+	NmeaTagTime time;
+	std::atomic<uint64_t> lineCount;
+
+	NmeaTagBlock(const NmeaTagBlock&) = delete;
+	NmeaTagBlock& operator=(const NmeaTagBlock&) = delete;
+};
+
+#endif /* NMEATAGBLOCK_H_ */
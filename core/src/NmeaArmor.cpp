@@ -0,0 +1,210 @@
+/*
+ * NmeaArmor.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaArmor.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NP_ARMOR_X86 1
+#include <immintrin.h>
+#endif
+
+/// @cond
+namespace {
+
+inline char armorChar(unsigned sixBits) {
+	return static_cast<char>(sixBits < 40 ? sixBits + 48 : sixBits + 56);
+}
+
+/*
+ * Armors characters [first, count) and XORs them into checksum. first must
+ * be a multiple of 4.
+ */
+std::size_t armorScalar(const uint8_t* bits, std::size_t bitCount,
+		std::size_t first, char* payload, uint8_t& checksum) {
+	std::size_t count = (bitCount + 5) / 6;
+	std::size_t byteCount = (bitCount + 7) / 8;
+	uint8_t sum = checksum;
+	std::size_t i = first;
+
+	// 3 bytes to 4 characters
+	for (; (i + 4) * 6 <= bitCount; i += 4) {
+		const uint8_t* in = bits + i / 4 * 3;
+		char c0 = armorChar(in[0] >> 2);
+		char c1 = armorChar(((in[0] & 0x03) << 4) | (in[1] >> 4));
+		char c2 = armorChar(((in[1] & 0x0F) << 2) | (in[2] >> 6));
+		char c3 = armorChar(in[2] & 0x3F);
+		payload[i] = c0;
+		payload[i + 1] = c1;
+		payload[i + 2] = c2;
+		payload[i + 3] = c3;
+		sum ^= c0 ^ c1 ^ c2 ^ c3;
+	}
+
+	// Last characters, the bits past bitCount read as 0
+	for (; i < count; ++i) {
+		std::size_t bit = i * 6;
+		unsigned word = bits[bit / 8] << 8;
+		if (bit / 8 + 1 < byteCount) {
+			word |= bits[bit / 8 + 1];
+		}
+		unsigned sixBits = (word >> (10 - bit % 8)) & 0x3F;
+		if (bit + 6 > bitCount) {
+			sixBits &= (0x3F << (bit + 6 - bitCount)) & 0x3F;
+		}
+		payload[i] = armorChar(sixBits);
+		sum ^= payload[i];
+	}
+
+	checksum = sum;
+	return count;
+}
+
+#ifdef NP_ARMOR_X86
+
+/*
+ * 16 sextets of 12 bytes, one per byte, by the multiply shift of
+ * W. Mula's base64 encoder.
+ */
+__attribute__((target("sse4.1")))
+inline __m128i unpackSSE4(__m128i in) {
+	in = _mm_shuffle_epi8(in,
+			_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	__m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)),
+			_mm_set1_epi32(0x04000040));
+	__m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)),
+			_mm_set1_epi32(0x01000010));
+	return _mm_or_si128(high, low);
+}
+
+__attribute__((target("sse4.1")))
+inline __m128i armorCharsSSE4(__m128i sixBits) {
+	__m128i above = _mm_and_si128(_mm_cmpgt_epi8(sixBits, _mm_set1_epi8(39)),
+			_mm_set1_epi8(8));
+	return _mm_add_epi8(sixBits, _mm_add_epi8(above, _mm_set1_epi8(48)));
+}
+
+__attribute__((target("sse4.1")))
+inline uint8_t xorBytes(__m128i sum) {
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 8));
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 4));
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 2));
+	sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 1));
+	return static_cast<uint8_t>(_mm_extract_epi8(sum, 0));
+}
+
+/*
+ * Armors blocks of 16 characters from character first while 16 bytes can be
+ * loaded, returns the next character.
+ */
+__attribute__((target("sse4.1")))
+inline std::size_t blocksSSE4(const uint8_t* bits, std::size_t bitCount,
+		std::size_t first, char* payload, __m128i& sum) {
+	std::size_t byteCount = (bitCount + 7) / 8;
+	std::size_t i = first;
+	for (; (i + 16) * 6 <= bitCount && i / 4 * 3 + 16 <= byteCount; i += 16) {
+		__m128i in = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(bits + i / 4 * 3));
+		__m128i out = armorCharsSSE4(unpackSSE4(in));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(payload + i), out);
+		sum = _mm_xor_si128(sum, out);
+	}
+	return i;
+}
+
+__attribute__((target("sse4.1")))
+std::size_t armorSSE4(const uint8_t* bits, std::size_t bitCount,
+		char* payload, uint8_t& checksum) {
+	__m128i sum = _mm_setzero_si128();
+	std::size_t i = blocksSSE4(bits, bitCount, 0, payload, sum);
+	checksum = xorBytes(sum);
+	return armorScalar(bits, bitCount, i, payload, checksum);
+}
+
+__attribute__((target("avx2")))
+std::size_t armorAVX2(const uint8_t* bits, std::size_t bitCount,
+		char* payload, uint8_t& checksum) {
+	std::size_t byteCount = (bitCount + 7) / 8;
+	__m256i sum = _mm256_setzero_si256();
+	std::size_t i = 0;
+	// 12 bytes per lane, the second load ends 28 bytes in
+	for (; (i + 32) * 6 <= bitCount && i / 4 * 3 + 28 <= byteCount; i += 32) {
+		const uint8_t* in = bits + i / 4 * 3;
+		__m256i packed = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(
+						_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)), 1);
+		packed = _mm256_shuffle_epi8(packed,
+				_mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11,
+						10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+		__m256i high = _mm256_mulhi_epu16(
+				_mm256_and_si256(packed, _mm256_set1_epi32(0x0FC0FC00)),
+				_mm256_set1_epi32(0x04000040));
+		__m256i low = _mm256_mullo_epi16(
+				_mm256_and_si256(packed, _mm256_set1_epi32(0x003F03F0)),
+				_mm256_set1_epi32(0x01000010));
+		__m256i sixBits = _mm256_or_si256(high, low);
+		__m256i above = _mm256_and_si256(
+				_mm256_cmpgt_epi8(sixBits, _mm256_set1_epi8(39)),
+				_mm256_set1_epi8(8));
+		__m256i out = _mm256_add_epi8(sixBits,
+				_mm256_add_epi8(above, _mm256_set1_epi8(48)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(payload + i), out);
+		sum = _mm256_xor_si256(sum, out);
+	}
+	__m128i half = _mm_xor_si128(_mm256_castsi256_si128(sum),
+			_mm256_extracti128_si256(sum, 1));
+	i = blocksSSE4(bits, bitCount, i, payload, half);
+	checksum = xorBytes(half);
+	return armorScalar(bits, bitCount, i, payload, checksum);
+}
+
+#endif
+
+NmeaArmorKernel detect() {
+#ifdef NP_ARMOR_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return NmeaArmorKernel_AVX2;
+	}
+	if (__builtin_cpu_supports("sse4.1")) {
+		return NmeaArmorKernel_SSE4;
+	}
+#endif
+	return NmeaArmorKernel_Scalar;
+}
+
+} // namespace
+/// @endcond
+
+std::size_t NmeaArmor::armor(const uint8_t* bits, std::size_t bitCount,
+		char* payload, uint8_t& checksum) {
+	return armor(kernel(), bits, bitCount, payload, checksum);
+}
+
+std::size_t NmeaArmor::armor(NmeaArmorKernel kernel, const uint8_t* bits,
+		std::size_t bitCount, char* payload, uint8_t& checksum) {
+	switch (kernel) {
+#ifdef NP_ARMOR_X86
+	case NmeaArmorKernel_AVX2:
+		return armorAVX2(bits, bitCount, payload, checksum);
+	case NmeaArmorKernel_SSE4:
+		return armorSSE4(bits, bitCount, payload, checksum);
+#endif
+	default:
+		checksum = 0;
+		return armorScalar(bits, bitCount, 0, payload, checksum);
+	}
+}
+
+bool NmeaArmor::supported(NmeaArmorKernel kernel) {
+	return kernel <= NmeaArmor::kernel();
+}
+
+NmeaArmorKernel NmeaArmor::kernel() {
+	static const NmeaArmorKernel best = detect();
+	return best;
+}
@@ -0,0 +1,1122 @@
+/*
+ * NmeaComposerCore.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaComposerCore.h"
+#include "NmeaArmor.h"
+#include "NmeaJsonDelta.h"
+#include "NmeaProbes.h"
+#include "NmeaSentencePlan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/// @cond
+namespace {
+
+/*
+ * Formats a sentence field by field straight into the caller buffer, keeping
+ * the checksum as it goes. Past the end of the buffer only the length is
+ * kept, like snprintf does.
+ */
+class SentenceWriter {
+public:
+	SentenceWriter(Nmea_SentenceType type, char* buffer, std::size_t size,
+			char start = '$') :
+			type(type), buffer(buffer), size(size), length(0), checksum(0), fieldCount(
+					0), json(NULL) {
+		NP_PROBE1(compose_entry, type);
+		put(start);
+	}
+
+	/*
+	 * Writes the values of the sentence to json as well, when not null.
+	 */
+	void delta(NmeaJsonDelta* json, const char* talkerid,
+			const char* sentence) {
+		this->json = json;
+		if (json != NULL) {
+			json->begin(talkerid, sentence);
+		}
+	}
+
+	NmeaJsonDelta* jsonDelta() const {
+		return json;
+	}
+
+	/*
+	 * Address field, omitted when the talker identifier is not 2 characters.
+	 */
+	void address(const char* talkerid, const char* sentence) {
+		if (std::strlen(talkerid) == 2) {
+			char head[5] = { talkerid[0], talkerid[1], sentence[0], sentence[1],
+					sentence[2] };
+			field(head, sizeof(head));
+		}
+	}
+
+	void field(const char* text, std::size_t textLength) {
+		separate();
+		append(text, textLength);
+	}
+
+	void field(const char* text) {
+		field(text, std::strlen(text));
+	}
+
+	void field(char c) {
+		field(&c, 1);
+	}
+
+	/*
+	 * Field of which the XOR of the characters is already known.
+	 */
+	void field(const char* text, std::size_t textLength, uint8_t textChecksum) {
+		separate();
+		checksum ^= textChecksum;
+		if (length < size) {
+			std::memcpy(buffer + length, text,
+					std::min(textLength, size - length));
+		}
+		length += textLength;
+	}
+
+	void formatField(const char* format, ...)
+			__attribute__((format(printf, 2, 3))) {
+		va_list args;
+		va_start(args, format);
+		vformatField(format, args);
+		va_end(args);
+	}
+
+	/*
+	 * Field of a value, of which the digits also go to the JSON delta under
+	 * path. A null path keeps the value out of the delta.
+	 */
+	void valueField(const char* path, const char* format, ...)
+			__attribute__((format(printf, 3, 4))) {
+		va_list args;
+		va_start(args, format);
+		vvalueField(path, false, format, args);
+		va_end(args);
+	}
+
+	/*
+	 * Same, for a value written without its sign.
+	 */
+	void signedValueField(const char* path, bool negative, const char* format,
+			...) __attribute__((format(printf, 4, 5))) {
+		va_list args;
+		va_start(args, format);
+		vvalueField(path, negative, format, args);
+		va_end(args);
+	}
+
+	/*
+	 * Appends the checksum and terminates the sentence.
+	 */
+	std::size_t finish() {
+		if (json != NULL) {
+			json->finish();
+		}
+		NP_PROBE2(nmea_entry, type, fieldCount);
+		// A sentence without any field has never had the '*' delimiter
+		if (fieldCount != 0) {
+			put('*');
+		}
+		char digits[8];
+		int count = std::snprintf(digits, sizeof(digits), "%02X",
+				static_cast<uint16_t>(checksum));
+		for (int i = 0; i < count; ++i) {
+			put(digits[i]);
+		}
+		if (size != 0) {
+			buffer[std::min(length, size - 1)] = '\0';
+		}
+		NP_PROBE3(nmea_return, type, length, buffer);
+		NP_PROBE3(compose_return, type, length, buffer);
+		return length;
+	}
+
+private:
+	void separate() {
+		if (fieldCount++ != 0) {
+			append(",", 1);
+		}
+	}
+
+	void vformatField(const char* format, va_list args) {
+		separate();
+		std::size_t room = length < size ? size - length : 0;
+		int printed = std::vsnprintf(room != 0 ? buffer + length : NULL, room,
+				format, args);
+		std::size_t count = printed > 0 ? printed : 0;
+		for (std::size_t i = 0; i < std::min(count, room); ++i) {
+			checksum ^= buffer[length + i];
+		}
+		length += count;
+	}
+
+	void vvalueField(const char* path, bool negative, const char* format,
+			va_list args) {
+		if (json == NULL || path == NULL) {
+			vformatField(format, args);
+			return;
+		}
+		// Formatted once, the digits copied to both outputs
+		char digits[64];
+		va_list copy;
+		va_copy(copy, args);
+		int printed = std::vsnprintf(digits, sizeof(digits), format, args);
+		if (printed >= 0 && static_cast<std::size_t>(printed) < sizeof(digits)) {
+			field(digits, printed);
+			json->value(path, digits, printed, negative);
+		} else {
+			vformatField(format, copy);
+			json->value(path, "", 0);
+		}
+		va_end(copy);
+	}
+
+	/*
+	 * Writes a character left out of the checksum.
+	 */
+	void put(char c) {
+		if (length < size) {
+			buffer[length] = c;
+		}
+		++length;
+	}
+
+	void append(const char* text, std::size_t textLength) {
+		for (std::size_t i = 0; i < textLength; ++i) {
+			checksum ^= text[i];
+		}
+		if (length < size) {
+			std::memcpy(buffer + length, text,
+					std::min(textLength, size - length));
+		}
+		length += textLength;
+	}
+
+	Nmea_SentenceType type;
+	char* buffer;
+	std::size_t size;
+	std::size_t length;
+	int16_t checksum;
+	std::size_t fieldCount;
+	NmeaJsonDelta* json;
+};
+
+/*
+ * Packs AIS message fields most significant bit first, a byte at a time.
+ */
+class BitWriter {
+public:
+	BitWriter() :
+			pending(0), pendingBits(0), bitCount(0) {
+	}
+
+	void put(uint32_t value, unsigned width) {
+		if (bitCount + width > sizeof(bytes) * 8) {
+			return;
+		}
+		pending = (pending << width)
+				| (value & static_cast<uint32_t>((uint64_t(1) << width) - 1));
+		pendingBits += width;
+		bitCount += width;
+		for (; pendingBits >= 8; pendingBits -= 8) {
+			bytes[(bitCount - pendingBits) / 8] = static_cast<uint8_t>(pending
+					>> (pendingBits - 8));
+		}
+		// Bits of the last byte so far, the rest of it zero
+		if (pendingBits != 0) {
+			bytes[bitCount / 8] = static_cast<uint8_t>(pending
+					<< (8 - pendingBits));
+		}
+	}
+
+	void putSigned(int32_t value, unsigned width) {
+		put(static_cast<uint32_t>(value), width);
+	}
+
+	/*
+	 * Armors the message into 6 bit ASCII, returns the number of characters.
+	 */
+	std::size_t armor(char* payload, uint8_t& checksum) const {
+		return NmeaArmor::armor(bytes, bitCount, payload, checksum);
+	}
+
+private:
+	uint8_t bytes[128]; // 1008 bits of a 5 slot message
+	uint64_t pending;
+	unsigned pendingBits;
+	unsigned bitCount;
+};
+
+/*
+ * Whether the field at index is flagged invalid. Fields past the size of the
+ * bitset, like those of the seventeenth and later transducers, are valid.
+ */
+bool invalid(const NmeaComposerValid& validity, std::size_t index) {
+	return index < validity.size() && validity[index];
+}
+
+/*
+ * Rounds a scaled value, or returns notAvailable for NaN.
+ */
+int32_t scaled(float value, double scale, int32_t notAvailable) {
+	if (std::isnan(value)) {
+		return notAvailable;
+	}
+	return static_cast<int32_t>(std::lround(value * scale));
+}
+
+/*
+ * Speed over ground in 1/10 knot, 1022 for 102.2 knots or more, 1023 only
+ * when NaN.
+ */
+uint32_t speedOverGround(float knots) {
+	if (std::isnan(knots)) {
+		return 1023;
+	}
+	if (!(knots < 102.2f)) {
+		return 1022;
+	}
+	int32_t sog = scaled(knots, 10, 1023);
+	return sog < 0 ? 0 : std::min(sog, 1022);
+}
+
+/*
+ * Course over ground in 1/10 degree, wrapped into [0, 3600). 3600 only when
+ * not finite.
+ */
+uint32_t courseOverGround(float degrees) {
+	if (!std::isfinite(degrees)) {
+		return 3600;
+	}
+	int32_t cog = static_cast<int32_t>(std::lround(
+			std::fmod(static_cast<double>(degrees), 360) * 10)) % 3600;
+	return cog < 0 ? cog + 3600 : cog;
+}
+
+/*
+ * Rate of turn indicator, 4.733 sqrt(degrees per minute), -128 when NaN.
+ */
+int32_t rateOfTurn(float degreesPerMinute) {
+	if (std::isnan(degreesPerMinute)) {
+		return -128;
+	}
+	int32_t rot = static_cast<int32_t>(std::lround(
+			4.733 * std::sqrt(std::abs(degreesPerMinute))));
+	rot = std::min(rot, 126);
+	return degreesPerMinute < 0 ? -rot : rot;
+}
+
+/*
+ * How an observation of message 8 FI 31 is coded: the value plus offset,
+ * times scale, rounded and limited to [minimum, maximum]. Directions wrap
+ * instead, visibility past maximum sets its "greater than" bit.
+ */
+struct MetHydroCode {
+	enum Kind {
+		Limited, Direction, Visibility
+	};
+
+	unsigned width;
+	Kind kind;
+	double offset;
+	double scale;
+	int32_t minimum;
+	int32_t maximum;
+	int32_t notAvailable;
+};
+
+const MetHydroCode metHydroCodes[Nmea_MetHydroField_Count] = {
+		{ 7, MetHydroCode::Limited, 0, 1, 0, 126, 127 },       // AverageWindSpeed
+		{ 7, MetHydroCode::Limited, 0, 1, 0, 126, 127 },       // WindGust
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // WindDirection
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // WindGustDirection
+		{ 11, MetHydroCode::Limited, 0, 10, -600, 600, -1024 },// AirTemperature
+		{ 7, MetHydroCode::Limited, 0, 1, 0, 100, 101 },       // RelativeHumidity
+		{ 10, MetHydroCode::Limited, 0, 10, -200, 500, 501 },  // DewPoint
+		{ 9, MetHydroCode::Limited, -799, 1, 0, 402, 511 },    // AirPressure
+		{ 2, MetHydroCode::Limited, 0, 1, 0, 2, 3 },           // PressureTendency
+		{ 8, MetHydroCode::Visibility, 0, 10, 0, 126, 127 },   // HorizontalVisibility
+		{ 12, MetHydroCode::Limited, 10, 100, 0, 4000, 4001 }, // WaterLevel
+		{ 2, MetHydroCode::Limited, 0, 1, 0, 2, 3 },           // WaterLevelTrend
+		{ 8, MetHydroCode::Limited, 0, 10, 0, 250, 255 },      // SurfaceCurrentSpeed
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // SurfaceCurrentDirection
+		{ 8, MetHydroCode::Limited, 0, 10, 0, 250, 255 },      // Current2Speed
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // Current2Direction
+		{ 5, MetHydroCode::Limited, 0, 1, 0, 30, 31 },         // Current2Level
+		{ 8, MetHydroCode::Limited, 0, 10, 0, 250, 255 },      // Current3Speed
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // Current3Direction
+		{ 5, MetHydroCode::Limited, 0, 1, 0, 30, 31 },         // Current3Level
+		{ 8, MetHydroCode::Limited, 0, 10, 0, 250, 255 },      // WaveHeight
+		{ 6, MetHydroCode::Limited, 0, 1, 0, 60, 63 },         // WavePeriod
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // WaveDirection
+		{ 8, MetHydroCode::Limited, 0, 10, 0, 250, 255 },      // SwellHeight
+		{ 6, MetHydroCode::Limited, 0, 1, 0, 60, 63 },         // SwellPeriod
+		{ 9, MetHydroCode::Direction, 0, 1, 0, 359, 360 },     // SwellDirection
+		{ 4, MetHydroCode::Limited, 0, 1, 0, 12, 13 },         // SeaState
+		{ 10, MetHydroCode::Limited, 0, 10, -100, 500, 501 },  // WaterTemperature
+		{ 3, MetHydroCode::Limited, 0, 1, 0, 6, 7 },           // PrecipitationType
+		{ 9, MetHydroCode::Limited, 0, 10, 0, 500, 501 },      // Salinity
+		{ 2, MetHydroCode::Limited, 0, 1, 0, 1, 3 } };         // Ice
+
+int32_t metHydroValue(const MetHydroCode& code, float observation) {
+	if (std::isnan(observation)) {
+		return code.notAvailable;
+	}
+	double value = (observation + code.offset) * code.scale;
+	if (code.kind == MetHydroCode::Direction) {
+		value = std::fmod(value, 360);
+		int32_t direction = static_cast<int32_t>(std::lround(
+				value < 0 ? value + 360 : value));
+		return direction == 360 ? 0 : direction;
+	}
+	if (code.kind == MetHydroCode::Visibility && value > code.maximum + 0.5) {
+		return 0x80 | code.maximum;
+	}
+	value = std::max<double>(std::min<double>(value, code.maximum),
+			code.minimum);
+	return static_cast<int32_t>(std::lround(value));
+}
+
+std::size_t writeVDM(SentenceWriter& writer, const BitWriter& bits,
+		char channel) {
+	char payload[172];
+	uint8_t payloadChecksum;
+	std::size_t length = bits.armor(payload, payloadChecksum);
+
+	/*------------ Field 00 ---------------*/
+	writer.field("AIVDM");
+
+	/*------------ Field 01,02,03 ---------------*/
+	writer.field('1');
+	writer.field('1');
+	writer.field("");
+
+	/*------------ Field 04 ---------------*/
+	writer.field(channel);
+
+	/*------------ Field 05 ---------------*/
+	writer.field(payload, length, payloadChecksum);
+
+	/*------------ Field 06 ---------------*/
+	writer.field('0');
+
+	return writer.finish();
+}
+
+std::size_t writeRMC(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity,
+		const std::chrono::microseconds utcTime, const double latitude,
+		const double longitude, const double speedknots,
+		const double coursetrue, const NmeaDate& utcDate,
+		const double magneticvar) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "RMC");
+
+	/*------------ Field 01 ---------------*/
+	if (!validity[idxVar]) {
+		long long us = utcTime.count();
+		writer.formatField("%02lld%02lld%02lld.%03lld", us / 3600000000LL,
+				us / 60000000LL % 60, us / 1000000LL % 60,
+				us % 1000000LL / 1000);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 02 ---------------*/
+	writer.field('A');
+
+	/*------------ Field 03,04 ---------------*/
+	if (!validity[idxVar]) {
+		double abslatitude = std::abs(latitude);
+		double degrees;
+		double minutes;
+		minutes = std::modf(abslatitude, &degrees) * 60.0f;
+
+		writer.formatField("%02d%010.7f", static_cast<int>(degrees), minutes);
+		if (writer.jsonDelta() != NULL && !validity[idxVar + 1]) {
+			writer.jsonDelta()->position(latitude, longitude);
+		}
+
+		if (latitude < 0) {
+			writer.field('S');
+		} else {
+			writer.field('N');
+		}
+	} else {
+		writer.field("");
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 05,06 ---------------*/
+	if (!validity[idxVar]) {
+		double abslongitude = std::abs(longitude);
+		double degrees;
+		double minutes;
+		minutes = std::modf(abslongitude, &degrees) * 60.0f;
+
+		writer.formatField("%03d%010.7f", static_cast<int>(degrees), minutes);
+
+		if (longitude < 0) {
+			writer.field('W');
+		} else {
+			writer.field('E');
+		}
+	} else {
+		writer.field("");
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 07 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.speedOverGround", "%.2f", speedknots);
+	}
+	++idxVar;
+
+	/*------------ Field 08 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.courseOverGroundTrue", "%.2f",
+				coursetrue);
+	}
+	++idxVar;
+
+	/*------------ Field 09 ---------------*/
+	if (!validity[idxVar]) {
+		writer.formatField("%02d%02d%02d", utcDate.day, utcDate.month,
+				utcDate.year % 100);
+		if (writer.jsonDelta() != NULL && !validity[0]) {
+			writer.jsonDelta()->timestamp(utcDate, utcTime);
+		}
+	}
+	++idxVar;
+
+	/*------------ Field 10,11 ---------------*/
+	if (!validity[idxVar]) {
+		double absmagneticvar = std::abs(magneticvar);
+
+		writer.signedValueField("navigation.magneticVariation",
+				magneticvar < 0, "%.1f", absmagneticvar);
+
+		if (magneticvar < 0) {
+			writer.field('W');
+		} else {
+			writer.field('E');
+		}
+	}
+
+	/*------------ Field 12 ---------------*/
+	writer.field('A');
+
+	return writer.finish();
+}
+
+std::size_t writeXDR(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity,
+		const NmeaTransducer* measurements, std::size_t count) {
+	std::size_t idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "XDR");
+
+	for (std::size_t i = 0; i < count; ++i) {
+		const NmeaTransducer& tm = measurements[i];
+		/*------------ Field 01 ---------------*/
+		if (!invalid(validity, idxVar)) {
+			writer.field(tm.transducerType);
+		} else {
+			writer.field("");
+		}
+		++idxVar;
+
+		/*------------ Field 02 ---------------*/
+		if (!invalid(validity, idxVar)) {
+			const char* format;
+			if (tm.unitsOfMeasurement == 'C') {
+				format = "%+06.1f";
+			} else if (tm.unitsOfMeasurement == 'B') {
+				format = "%6.4f";
+			} else if (tm.unitsOfMeasurement == 'P') {
+				format = "%05.1f";
+			} else {
+				format = "%.1f";
+			}
+
+			char path[64];
+			const char* jsonPath = NULL;
+			if (writer.jsonDelta() != NULL && !invalid(validity, idxVar + 2)
+					&& tm.nameOfTransducer[0] != '\0') {
+				std::snprintf(path, sizeof(path), "transducers.%s",
+						tm.nameOfTransducer);
+				jsonPath = path;
+			}
+			writer.valueField(jsonPath, format, tm.measurementData);
+		} else {
+			writer.field("");
+		}
+		++idxVar;
+
+		/*------------ Field 03 ---------------*/
+		if (!invalid(validity, idxVar)) {
+			writer.field(tm.unitsOfMeasurement);
+		} else {
+			writer.field("");
+		}
+		++idxVar;
+
+		/*------------ Field 04 ---------------*/
+		if (!invalid(validity, idxVar)) {
+			writer.field(tm.nameOfTransducer);
+		} else {
+			writer.field("");
+		}
+		++idxVar;
+	}
+
+	return writer.finish();
+}
+
+std::size_t writeMWV(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity, const double windAngle,
+		const Nmea_AngleReference reference, const double windSpeed,
+		const char windSpeedUnits, const char sensorStatus) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "MWV");
+
+	/*------------ Field 01 ---------------*/
+	bool trueWind = reference == Nmea_AngleReference_True;
+	if (!validity[idxVar]) {
+		writer.valueField(
+				trueWind ?
+						"environment.wind.angleTrueWater" :
+						"environment.wind.angleApparent", "%05.1f", windAngle);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 02 ---------------*/
+	if (!validity[idxVar]) {
+		if (reference == Nmea_AngleReference_True) {
+			writer.field('T');
+		} else {
+			writer.field('R');
+		}
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 03 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField(
+				trueWind ?
+						"environment.wind.speedTrue" :
+						"environment.wind.speedApparent", "%05.1f", windSpeed);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 03 ---------------*/
+	if (!validity[idxVar]) {
+		writer.field(windSpeedUnits);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 04 ---------------*/
+	if (!validity[idxVar]) {
+		writer.field(sensorStatus);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	return writer.finish();
+}
+
+std::size_t writeMWD(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity, const double trueWindDirection,
+		const double magneticWindDirection, const double windSpeedKnots,
+		const double windSpeedMeters) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "MWD");
+
+	/*------------ Field 01 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("environment.wind.directionTrue", "%05.1f",
+				trueWindDirection);
+	} else {
+		writer.field("");
+	}
+	writer.field('T');
+	++idxVar;
+
+	/*------------ Field 02 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("environment.wind.directionMagnetic", "%05.1f",
+				magneticWindDirection);
+	} else {
+		writer.field("");
+	}
+	writer.field('M');
+	++idxVar;
+
+	/*------------ Field 03 ---------------*/
+	if (!validity[idxVar]) {
+		writer.formatField("%05.1f", windSpeedKnots);
+	} else {
+		writer.field("");
+	}
+	writer.field('N');
+	++idxVar;
+
+	/*------------ Field 04 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("environment.wind.speedTrue", "%05.1f",
+				windSpeedMeters);
+	} else {
+		writer.field("");
+	}
+	writer.field('M');
+	++idxVar;
+
+	return writer.finish();
+}
+
+std::size_t writeHDT(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity, const double headingDegreesTrue) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "HDT");
+
+	/*------------ Field 01 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.headingTrue", "%06.2f",
+				headingDegreesTrue);
+	} else {
+		writer.field("");
+	}
+	writer.field('T');
+	++idxVar;
+
+	return writer.finish();
+}
+
+std::size_t writeVLW(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity, const double totalCumulativeDistance,
+		const double distanceSinceReset) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "VLW");
+
+	/*------------ Field 01,02 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.log", "%.2f", totalCumulativeDistance);
+	} else {
+		writer.field("");
+	}
+	writer.field('N');
+	++idxVar;
+
+	/*------------ Field 03,04 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.trip.log", "%.2f", distanceSinceReset);
+	} else {
+		writer.field("");
+	}
+	writer.field('N');
+	++idxVar;
+
+	return writer.finish();
+}
+
+std::size_t writeVHW(SentenceWriter& writer, const char* talkerid,
+		const NmeaComposerValid& validity, const double headingTrue,
+		const double headingMagnetic, const double speedInKnots,
+		const double speedInKmH) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.address(talkerid, "VHW");
+
+	/*------------ Field 01,02 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.headingTrue", "%05.1f", headingTrue);
+	} else {
+		writer.field("");
+	}
+	writer.field('T');
+	++idxVar;
+
+	/*------------ Field 03,04 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.headingMagnetic", "%05.1f",
+				headingMagnetic);
+	} else {
+		writer.field("");
+	}
+	writer.field('M');
+	++idxVar;
+
+	/*------------ Field 05,06 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.speedThroughWater", "%.1f",
+				speedInKnots);
+	} else {
+		writer.field("");
+	}
+	writer.field('N');
+	++idxVar;
+
+	/*------------ Field 07,08 ---------------*/
+	if (!validity[idxVar]) {
+		writer.formatField("%.1f", speedInKmH);
+	} else {
+		writer.field("");
+	}
+	writer.field('K');
+	++idxVar;
+
+	return writer.finish();
+}
+
+std::size_t writePRDID(SentenceWriter& writer,
+		const NmeaComposerValid& validity, const double pitch,
+		const double roll, const double heading) {
+	int idxVar = 0;
+
+	/*------------ Field 00 ---------------*/
+	writer.field("PRDID");
+
+	/*------------ Field 01 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.attitude.pitch", "%+06.2f", pitch);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 02 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.attitude.roll", "%+06.2f", roll);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	/*------------ Field 03 ---------------*/
+	if (!validity[idxVar]) {
+		writer.valueField("navigation.headingTrue", "%06.2f", heading);
+	} else {
+		writer.field("");
+	}
+	++idxVar;
+
+	return writer.finish();
+}
+
+} // namespace
+/// @endcond
+
+NmeaComposerCore::NmeaComposerCore() {
+
+}
+
+std::size_t NmeaComposerCore::composeRMC(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const std::chrono::microseconds utcTime, const double latitude,
+		const double longitude, const double speedknots,
+		const double coursetrue, const NmeaDate& utcDate,
+		const double magneticvar, NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_RMC, buffer, size);
+	writer.delta(json, talkerid, "RMC");
+	return writeRMC(writer, talkerid, validity, utcTime, latitude, longitude,
+			speedknots, coursetrue, utcDate, magneticvar);
+}
+
+std::size_t NmeaComposerCore::composeXDR(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const NmeaTransducer* measurements, std::size_t count,
+		NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_XDR, buffer, size);
+	writer.delta(json, talkerid, "XDR");
+	return writeXDR(writer, talkerid, validity, measurements, count);
+}
+
+std::size_t NmeaComposerCore::composeMWV(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const double windAngle, const Nmea_AngleReference reference,
+		const double windSpeed, const char windSpeedUnits,
+		const char sensorStatus, NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_MWV, buffer, size);
+	writer.delta(json, talkerid, "MWV");
+	return writeMWV(writer, talkerid, validity, windAngle, reference,
+			windSpeed, windSpeedUnits, sensorStatus);
+}
+
+std::size_t NmeaComposerCore::composeMWD(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const double trueWindDirection, const double magneticWindDirection,
+		const double windSpeedKnots, const double windSpeedMeters,
+		NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_MWD, buffer, size);
+	writer.delta(json, talkerid, "MWD");
+	return writeMWD(writer, talkerid, validity, trueWindDirection,
+			magneticWindDirection, windSpeedKnots, windSpeedMeters);
+}
+
+std::size_t NmeaComposerCore::composeHDT(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const double headingDegreesTrue, NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_HDT, buffer, size);
+	writer.delta(json, talkerid, "HDT");
+	return writeHDT(writer, talkerid, validity, headingDegreesTrue);
+}
+
+std::size_t NmeaComposerCore::composeVLW(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const double totalCumulativeDistance, const double distanceSinceReset,
+		NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_VLW, buffer, size);
+	writer.delta(json, talkerid, "VLW");
+	return writeVLW(writer, talkerid, validity, totalCumulativeDistance,
+			distanceSinceReset);
+}
+
+std::size_t NmeaComposerCore::composeVHW(char* buffer, std::size_t size,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const double headingTrue, const double headingMagnetic,
+		const double speedInKnots, const double speedInKmH,
+		NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_VHW, buffer, size);
+	writer.delta(json, talkerid, "VHW");
+	return writeVHW(writer, talkerid, validity, headingTrue, headingMagnetic,
+			speedInKnots, speedInKmH);
+}
+
+std::size_t NmeaComposerCore::composePRDID(char* buffer, std::size_t size,
+		const NmeaComposerValid& validity, const double pitch,
+		const double roll, const double heading, NmeaJsonDelta* json) {
+	SentenceWriter writer(Nmea_SentenceType_PRDID, buffer, size);
+	writer.delta(json, "", "PRDID");
+	return writePRDID(writer, validity, pitch, roll, heading);
+}
+
+std::size_t NmeaComposerCore::composeAISPositionReportClassA(char* buffer,
+		std::size_t size, const AISPositionReportClassA& report,
+		char channel) {
+	// Before packing the bits, so that compose_entry times all of it
+	SentenceWriter writer(Nmea_SentenceType_VDM, buffer, size, '!');
+	BitWriter bits;
+	bits.put(1, 6);
+	bits.put(report.repeatIndicator, 2);
+	bits.put(report.mmsi, 30);
+	bits.put(report.navigationStatus, 4);
+	bits.putSigned(rateOfTurn(report.rateOfTurn), 8);
+	bits.put(speedOverGround(report.speedOverGround), 10);
+	bits.put(report.positionAccuracy, 1);
+	bits.putSigned(scaled(report.longitude, 600000, 181 * 600000), 28);
+	bits.putSigned(scaled(report.latitude, 600000, 91 * 600000), 27);
+	bits.put(courseOverGround(report.courseOverGround), 12);
+	bits.put(report.trueHeading, 9);
+	bits.put(report.timestapUTCSecond, 6);
+	bits.put(report.maneuverIndicator, 2);
+	bits.put(0, 3); // spare
+	bits.put(report.raim, 1);
+	bits.put(0, 19); // radio status
+
+	return writeVDM(writer, bits, channel);
+}
+
+std::size_t NmeaComposerCore::composeAISStandardClassBCSPositionReport(
+		char* buffer, std::size_t size,
+		const AISStandardClassBCSPositionReport& report, char channel) {
+	SentenceWriter writer(Nmea_SentenceType_VDM, buffer, size, '!');
+	BitWriter bits;
+	bits.put(18, 6);
+	bits.put(report.repeatIndicator, 2);
+	bits.put(report.mmsi, 30);
+	bits.put(0, 8); // reserved
+	bits.put(speedOverGround(report.speedOverGround), 10);
+	bits.put(report.positionAccuracy, 1);
+	bits.putSigned(scaled(report.longitude, 600000, 181 * 600000), 28);
+	bits.putSigned(scaled(report.latitude, 600000, 91 * 600000), 27);
+	bits.put(courseOverGround(report.courseOverGround), 12);
+	bits.put(report.trueHeading, 9);
+	bits.put(report.timestapUTCSecond, 6);
+	bits.put(0, 2); // regional reserved
+	bits.put(1, 1); // CS unit
+	bits.put(0, 1); // no display
+	bits.put(0, 1); // no DSC
+	bits.put(1, 1); // whole marine band
+	bits.put(0, 1); // no message 22
+	bits.put(0, 1); // autonomous mode
+	bits.put(0, 1); // RAIM not in use
+	bits.put(1, 1); // ITDMA communication state follows
+	bits.put(0x60006, 19); // radio status of CS units
+
+	return writeVDM(writer, bits, channel);
+}
+
+std::size_t NmeaComposerCore::composeAISMeteorologicalHydrologicalData(
+		char* buffer, std::size_t size,
+		const AISMeteorologicalHydrologicalData& report, char channel) {
+	SentenceWriter writer(Nmea_SentenceType_VDM, buffer, size, '!');
+	BitWriter bits;
+	bits.put(8, 6);
+	bits.put(report.repeatIndicator, 2);
+	bits.put(report.mmsi, 30);
+	bits.put(0, 2); // spare
+	bits.put(1, 10); // DAC, international
+	bits.put(31, 6); // FI, meteorological and hydrological data
+	bits.putSigned(scaled(report.longitude, 60000, 181 * 60000), 25);
+	bits.putSigned(scaled(report.latitude, 60000, 91 * 60000), 24);
+	bits.put(report.positionAccuracy, 1);
+	bits.put(report.utcDay, 5);
+	bits.put(report.utcHour, 5);
+	bits.put(report.utcMinute, 6);
+	for (int field = 0; field < Nmea_MetHydroField_Count; ++field) {
+		const MetHydroCode& code = metHydroCodes[field];
+		bits.putSigned(metHydroValue(code, report.observations[field]),
+				code.width);
+	}
+	bits.put(0, 10); // spare
+
+	return writeVDM(writer, bits, channel);
+}
+
+std::size_t NmeaComposerCore::composePlan(char* buffer, std::size_t size,
+		const NmeaSentencePlan& plan, const char* talkerid,
+		const NmeaComposerValid& validity, const double* values,
+		std::size_t count) {
+	// Sentences of plans have no type of their own
+	SentenceWriter writer(Nmea_SentenceType_Count, buffer, size);
+	for (std::size_t i = 0; i < plan.stepCount; ++i) {
+		const NmeaSentencePlan::Step& step = plan.steps[i];
+		const char* text = plan.text + step.text;
+
+		if (step.operation == NmeaSentencePlan::Operation_Address) {
+			if (!plan.talker) {
+				writer.field(text, step.textLength, step.textChecksum);
+			} else if (std::strlen(talkerid) == 2) {
+				char head[2 + 0xFF];
+				head[0] = talkerid[0];
+				head[1] = talkerid[1];
+				std::memcpy(head + 2, text, step.textLength);
+				writer.field(head, 2 + step.textLength);
+			}
+			continue;
+		}
+		if (step.operation == NmeaSentencePlan::Operation_Literal) {
+			if (step.slot == NmeaSentencePlan::noSlot || !validity[step.slot]) {
+				writer.field(text, step.textLength, step.textChecksum);
+			} else {
+				writer.field("");
+			}
+			continue;
+		}
+
+		bool valid = step.input < count && !validity[step.slot];
+		double value = valid ? values[step.input] : 0;
+		long long scale = 1;
+		for (unsigned d = 0; d < step.digits; ++d) {
+			scale *= 10;
+		}
+		switch (step.operation) {
+		case NmeaSentencePlan::Operation_Float:
+		case NmeaSentencePlan::Operation_Integer:
+			if (valid) {
+				double number = step.signLetters ? std::abs(value) : value;
+				if (step.operation == NmeaSentencePlan::Operation_Float) {
+					writer.formatField(text, number);
+				} else {
+					writer.formatField(text,
+							static_cast<int>(std::lround(number)));
+				}
+			} else {
+				writer.field("");
+			}
+			if (step.signLetters) {
+				const char* letters = text + step.textLength + 1;
+				if (valid) {
+					writer.field(value < 0 ? letters[1] : letters[0]);
+				} else {
+					writer.field("");
+				}
+			}
+			break;
+		case NmeaSentencePlan::Operation_Time:
+			if (valid) {
+				long long total = std::llround(value * scale)
+						% (86400LL * scale);
+				total = total < 0 ? total + 86400LL * scale : total;
+				long long seconds = total / scale;
+				if (step.digits != 0) {
+					writer.formatField("%02lld%02lld%02lld.%0*lld",
+							seconds / 3600, seconds / 60 % 60, seconds % 60,
+							static_cast<int>(step.digits), total % scale);
+				} else {
+					writer.formatField("%02lld%02lld%02lld", seconds / 3600,
+							seconds / 60 % 60, seconds % 60);
+				}
+			} else {
+				writer.field("");
+			}
+			break;
+		case NmeaSentencePlan::Operation_Latitude:
+		case NmeaSentencePlan::Operation_Longitude:
+			if (valid) {
+				bool latitude = step.operation
+						== NmeaSentencePlan::Operation_Latitude;
+				// Minutes rounded first, so that 59.99999 carries into the degrees
+				long long total = std::llround(std::abs(value) * 60 * scale);
+				long long degrees = total / (60 * scale);
+				long long minutes = total % (60 * scale);
+				if (step.digits != 0) {
+					writer.formatField(
+							latitude ? "%02lld%02lld.%0*lld" : "%03lld%02lld.%0*lld",
+							degrees, minutes / scale,
+							static_cast<int>(step.digits), minutes % scale);
+				} else {
+					writer.formatField(latitude ? "%02lld%02lld" : "%03lld%02lld",
+							degrees, minutes);
+				}
+				writer.field(latitude ? (value < 0 ? 'S' : 'N') :
+						(value < 0 ? 'W' : 'E'));
+			} else {
+				writer.field("");
+				writer.field("");
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return writer.finish();
+}
@@ -0,0 +1,17 @@
+/*
+ * NmeaEnumNames.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaCoreEnums.h"
+
+// Storage of the name tables, for lookups that are not constant expressions
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_AngleReference>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_SentenceType>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_NavigationStatus>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_PositionAccuracy>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_ManeuverIndicator>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_RAIM>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_MetHydroField>::names[];
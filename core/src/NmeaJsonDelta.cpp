@@ -0,0 +1,149 @@
+/*
+ * NmeaJsonDelta.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaJsonDelta.h"
+#include "NmeaComposerCore.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+NmeaJsonDelta::NmeaJsonDelta(char* buffer, std::size_t size,
+		const char* label) :
+		buffer(buffer), size(size), count(0), label(label), valueCount(0), hasTimestamp(
+				false), year(0), month(0), day(0), microseconds(0) {
+	if (size != 0) {
+		buffer[0] = '\0';
+	}
+}
+
+void NmeaJsonDelta::begin(const char* talkerid, const char* sentence) {
+	count = 0;
+	valueCount = 0;
+	hasTimestamp = false;
+	append("{\"updates\":[{\"source\":{\"label\":\"");
+	appendEscaped(label);
+	append("\"");
+	if (std::strlen(talkerid) == 2) {
+		append(",\"talker\":\"");
+		appendEscaped(talkerid);
+		append("\"");
+	}
+	append(",\"sentence\":\"");
+	appendEscaped(sentence);
+	append("\"},\"values\":[");
+}
+
+void NmeaJsonDelta::value(const char* path, const char* text,
+		std::size_t textLength, bool negative) {
+	// The field digits, made a JSON number
+	const char* end = text + textLength;
+	while (text != end && *text == ' ') {
+		++text;
+	}
+	if (text != end && (*text == '+' || *text == '-')) {
+		negative = negative != (*text == '-');
+		++text;
+	}
+	while (end - text > 1 && text[0] == '0' && text[1] >= '0'
+			&& text[1] <= '9') {
+		++text;
+	}
+
+	separate();
+	append("{\"path\":\"");
+	appendEscaped(path);
+	append("\",\"value\":");
+	if (text == end || *text < '0' || *text > '9') {
+		// nan and inf are not numbers in JSON
+		append("null");
+	} else {
+		if (negative) {
+			append("-", 1);
+		}
+		append(text, end - text);
+	}
+	append("}");
+}
+
+void NmeaJsonDelta::position(double latitude, double longitude) {
+	separate();
+	format("{\"path\":\"navigation.position\",\"value\":"
+			"{\"latitude\":%.7f,\"longitude\":%.7f}}", latitude, longitude);
+}
+
+void NmeaJsonDelta::timestamp(const NmeaDate& date,
+		std::chrono::microseconds time) {
+	hasTimestamp = true;
+	year = date.year;
+	month = date.month;
+	day = date.day;
+	microseconds = time.count();
+}
+
+std::size_t NmeaJsonDelta::finish() {
+	append("]");
+	if (hasTimestamp) {
+		long long us = microseconds;
+		format(",\"timestamp\":\"%04d-%02d-%02dT%02lld:%02lld:%02lld.%03lldZ\"",
+				year, month, day, us / 3600000000LL, us / 60000000LL % 60,
+				us / 1000000LL % 60, us % 1000000LL / 1000);
+	}
+	append("}]}");
+	if (size != 0) {
+		buffer[std::min(count, size - 1)] = '\0';
+	}
+	return count;
+}
+
+void NmeaJsonDelta::separate() {
+	if (valueCount++ != 0) {
+		append(",", 1);
+	}
+}
+
+void NmeaJsonDelta::append(const char* text, std::size_t textLength) {
+	if (count < size) {
+		std::memcpy(buffer + count, text, std::min(textLength, size - count));
+	}
+	count += textLength;
+}
+
+void NmeaJsonDelta::append(const char* text) {
+	append(text, std::strlen(text));
+}
+
+void NmeaJsonDelta::appendEscaped(const char* text) {
+	for (const char* run = text;; ++text) {
+		unsigned char c = static_cast<unsigned char>(*text);
+		if (c != '\0' && c != '"' && c != '\\' && c >= 0x20) {
+			continue;
+		}
+		append(run, text - run);
+		if (c == '\0') {
+			return;
+		}
+		if (c == '"' || c == '\\') {
+			char escaped[2] = { '\\', static_cast<char>(c) };
+			append(escaped, sizeof(escaped));
+		} else {
+			format("\\u%04x", c);
+		}
+		run = text + 1;
+	}
+}
+
+void NmeaJsonDelta::format(const char* format, ...) {
+	std::size_t room = count < size ? size - count : 0;
+	va_list args;
+	va_start(args, format);
+	int printed = std::vsnprintf(room != 0 ? buffer + count : NULL, room,
+			format, args);
+	va_end(args);
+	count += printed > 0 ? printed : 0;
+}
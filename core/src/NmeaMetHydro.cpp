@@ -0,0 +1,143 @@
+/*
+ * NmeaMetHydro.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaMetHydro.h"
+
+#include <cstdint>
+#include <cstring>
+
+/// @cond
+namespace {
+
+struct DefaultName {
+	const char* name;
+	Nmea_MetHydroField field;
+};
+
+const DefaultName defaultNames[] = {
+		{ "AIRTEMP", Nmea_MetHydroField_AirTemperature },
+		{ "ENV_OUTAIR_T", Nmea_MetHydroField_AirTemperature },
+		{ "WATERTEMP", Nmea_MetHydroField_WaterTemperature },
+		{ "ENV_WATER_T", Nmea_MetHydroField_WaterTemperature },
+		{ "DEWPOINT", Nmea_MetHydroField_DewPoint },
+		{ "ENV_DEWPOINT", Nmea_MetHydroField_DewPoint },
+		{ "BARO", Nmea_MetHydroField_AirPressure },
+		{ "ENV_ATMOS_P", Nmea_MetHydroField_AirPressure },
+		{ "RH", Nmea_MetHydroField_RelativeHumidity },
+		{ "ENV_OUTSIDE_H", Nmea_MetHydroField_RelativeHumidity },
+		{ "SALINITY", Nmea_MetHydroField_Salinity } };
+
+/*
+ * Observation of a measurement with a name not in the table.
+ */
+bool byType(char transducerType, Nmea_MetHydroField& field) {
+	switch (transducerType) {
+	case 'C':
+		field = Nmea_MetHydroField_AirTemperature;
+		return true;
+	case 'P':
+		field = Nmea_MetHydroField_AirPressure;
+		return true;
+	case 'H':
+		field = Nmea_MetHydroField_RelativeHumidity;
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+ * Converts a measurement to the unit of the observation.
+ */
+float convert(Nmea_MetHydroField field, char units, float value) {
+	switch (field) {
+	case Nmea_MetHydroField_AirTemperature:
+	case Nmea_MetHydroField_DewPoint:
+	case Nmea_MetHydroField_WaterTemperature:
+		return units == 'K' ? value - 273.15f : value;
+	case Nmea_MetHydroField_AirPressure:
+		return units == 'B' ? value * 1000 : units == 'P' ? value / 100 : value;
+	case Nmea_MetHydroField_AverageWindSpeed:
+	case Nmea_MetHydroField_WindGust:
+	case Nmea_MetHydroField_SurfaceCurrentSpeed:
+	case Nmea_MetHydroField_Current2Speed:
+	case Nmea_MetHydroField_Current3Speed:
+		return units == 'M' ? value * 3600 / 1852 :
+				units == 'K' ? value * 1000 / 1852 : value;
+	case Nmea_MetHydroField_HorizontalVisibility:
+		return units == 'M' ? value / 1852 :
+				units == 'K' ? value * 1000 / 1852 : value;
+	default:
+		return value;
+	}
+}
+
+} // namespace
+/// @endcond
+
+const std::size_t NmeaMetHydro::maxNames;
+const std::size_t NmeaMetHydro::maxNameLength;
+
+NmeaMetHydro::NmeaMetHydro() :
+		nameCount(0) {
+	for (const DefaultName& name : defaultNames) {
+		assign(name.name, name.field);
+	}
+}
+
+bool NmeaMetHydro::assign(const char* nameOfTransducer,
+		Nmea_MetHydroField field) {
+	std::size_t length = std::strlen(nameOfTransducer);
+	if (length > maxNameLength) {
+		return false;
+	}
+	for (std::size_t i = 0; i < nameCount; ++i) {
+		if (std::strcmp(names[i].text, nameOfTransducer) == 0) {
+			names[i].field = field;
+			return true;
+		}
+	}
+	if (nameCount == maxNames) {
+		return false;
+	}
+	std::memcpy(names[nameCount].text, nameOfTransducer, length + 1);
+	names[nameCount].field = field;
+	++nameCount;
+	return true;
+}
+
+std::size_t NmeaMetHydro::map(const NmeaTransducer* measurements,
+		std::size_t count, AISMeteorologicalHydrologicalData& report) const {
+	uint32_t named = 0; // observations given by a named measurement
+	uint32_t set = 0; // observations stored, each counted once
+	std::size_t stored = 0;
+	for (std::size_t m = 0; m < count; ++m) {
+		const NmeaTransducer& measurement = measurements[m];
+		const char* name = measurement.nameOfTransducer ?
+				measurement.nameOfTransducer : "";
+		Nmea_MetHydroField field = Nmea_MetHydroField_Count;
+		for (std::size_t i = 0; i < nameCount; ++i) {
+			if (std::strcmp(names[i].text, name) == 0) {
+				field = names[i].field;
+				named |= uint32_t(1) << field;
+				break;
+			}
+		}
+		if (field == Nmea_MetHydroField_Count
+				&& (!byType(measurement.transducerType, field)
+						|| (named & (uint32_t(1) << field)) != 0)) {
+			continue;
+		}
+		report.observations[field] = convert(field,
+				measurement.unitsOfMeasurement, measurement.measurementData);
+		if ((set & (uint32_t(1) << field)) == 0) {
+			set |= uint32_t(1) << field;
+			++stored;
+		}
+	}
+	return stored;
+}
@@ -0,0 +1,45 @@
+/*
+ * NmeaProbes.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAPROBES_H_
+#define NMEAPROBES_H_
+
+/*
+ * USDT (statically defined tracing) probes of the nmeacomposer provider, for
+ * bpftrace, perf or SystemTap:
+ *
+ *   compose_entry(type)                    sentence started
+ *   compose_return(type, length, buffer)   sentence complete
+ *   nmea_entry(type, fieldCount)           fields written, checksum next
+ *   nmea_return(type, length, buffer)      sentence framed with its checksum
+ *   sink_write(sink, length, buffer)       sentence handed to a sink
+ *   sink_flush(sink)                       sink flush requested
+ *
+ * The compose and nmea probes fire in NmeaComposerCore, once per sentence
+ * whoever calls it: NmeaComposer, composePlan() users, tools and the stream
+ * target alike. A string composer of NmeaComposer composes a sentence of
+ * 128 characters or more, and fires them, twice.
+ *
+ * type is an Nmea_SentenceType, Nmea_SentenceType_Count for composePlan();
+ * buffer points to the sentence bytes (not null terminated). Without a tracer attached a probe is a single NOP. When
+ * sys/sdt.h is not available at build time the probes compile to nothing.
+ */
+
+#ifdef NP_HAVE_SDT
+#include <sys/sdt.h>
+#define NP_PROBE1(name, a1) DTRACE_PROBE1(nmeacomposer, name, a1)
+#define NP_PROBE2(name, a1, a2) DTRACE_PROBE2(nmeacomposer, name, a1, a2)
+#define NP_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(nmeacomposer, name, a1, a2, a3)
+#else
+// The arguments are still named, so that they do not go unused
+#define NP_PROBE1(name, a1) do { (void) (a1); } while (false)
+#define NP_PROBE2(name, a1, a2) do { (void) (a1); (void) (a2); } while (false)
+#define NP_PROBE3(name, a1, a2, a3) \
+	do { (void) (a1); (void) (a2); (void) (a3); } while (false)
+#endif
+
+#endif /* NMEAPROBES_H_ */
@@ -0,0 +1,227 @@
+/*
+ * NmeaSentencePlan.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaSentencePlan.h"
+
+#include <cstring>
+
+/// @cond
+namespace {
+
+bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+/*
+ * Whether field is a keyword, alone or followed by a single digit up to
+ * maxDigits. digits receives the digit, or defaultDigits.
+ */
+bool keyword(const char* field, std::size_t length, const char* name,
+		unsigned maxDigits, unsigned defaultDigits, unsigned& digits) {
+	std::size_t nameLength = std::strlen(name);
+	if (length < nameLength || std::memcmp(field, name, nameLength) != 0) {
+		return false;
+	}
+	if (length == nameLength) {
+		digits = defaultDigits;
+		return true;
+	}
+	if (length == nameLength + 1 && isDigit(field[nameLength])
+			&& static_cast<unsigned>(field[nameLength] - '0') <= maxDigits) {
+		digits = field[nameLength] - '0';
+		return true;
+	}
+	return false;
+}
+
+/*
+ * Checks a printf conversion of one number: flags, width, precision and one
+ * of feEgGd. Returns the conversion character, or 0 if not valid.
+ */
+char conversion(const char* field, std::size_t length) {
+	std::size_t i = 1;
+	while (i < length && std::strchr("-+ 0#", field[i]) != NULL) {
+		++i;
+	}
+	for (std::size_t digits = 0; i < length && isDigit(field[i]); ++digits) {
+		if (digits == 2) {
+			return 0;
+		}
+		++i;
+	}
+	if (i < length && field[i] == '.') {
+		++i;
+		for (std::size_t digits = 0; i < length && isDigit(field[i]);
+				++digits) {
+			if (digits == 2) {
+				return 0;
+			}
+			++i;
+		}
+	}
+	if (i + 1 != length || std::strchr("feEgGd", field[i]) == NULL) {
+		return 0;
+	}
+	return field[i];
+}
+
+} // namespace
+/// @endcond
+
+const std::size_t NmeaSentencePlan::maxSteps;
+const std::size_t NmeaSentencePlan::maxText;
+const uint8_t NmeaSentencePlan::noSlot;
+
+NmeaSentencePlan::NmeaSentencePlan() :
+		stepCount(0), textLength(0), inputCount(0), talker(false), error(0) {
+}
+
+bool NmeaSentencePlan::compile(const char* definition) {
+	stepCount = 0;
+	textLength = 0;
+	inputCount = 0;
+	talker = false;
+	error = 0;
+
+	const char* start = definition;
+	for (;;) {
+		const char* end = std::strchr(start, ',');
+		std::size_t length = end != NULL ? end - start : std::strlen(start);
+		bool compiled;
+		if (start == definition) {
+			Step address = Step();
+			address.operation = Operation_Address;
+			address.slot = noSlot;
+			talker = length > 2 && start[0] == '-' && start[1] == '-';
+			std::size_t skip = talker ? 2 : 0;
+			compiled = length > skip
+					&& addText(start + skip, length - skip, address);
+			if (compiled) {
+				steps[stepCount++] = address;
+			}
+		} else {
+			compiled = compileField(start, length);
+		}
+		if (!compiled) {
+			error = start - definition;
+			stepCount = 0;
+			inputCount = 0;
+			return false;
+		}
+		if (end == NULL) {
+			return true;
+		}
+		start = end + 1;
+	}
+}
+
+bool NmeaSentencePlan::compileField(const char* field, std::size_t length) {
+	if (stepCount == maxSteps) {
+		return false;
+	}
+
+	// Validity slot suffix
+	bool explicitSlot = false;
+	unsigned slot = 0;
+	const char* at = static_cast<const char*>(std::memchr(field, '@', length));
+	if (at != NULL) {
+		std::size_t digits = field + length - at - 1;
+		if (digits == 0 || digits > 2 || !isDigit(at[1])
+				|| (digits == 2 && !isDigit(at[2]))) {
+			return false;
+		}
+		slot = at[1] - '0';
+		if (digits == 2) {
+			slot = slot * 10 + at[2] - '0';
+		}
+		if (slot >= 16) {
+			return false;
+		}
+		explicitSlot = true;
+		length = at - field;
+	}
+
+	Step step = Step();
+	unsigned digits = 0;
+	bool input = true;
+	if (length > 1 && field[0] == '%') {
+		// Sign letters suffix
+		const char* colon = static_cast<const char*>(std::memchr(field, ':',
+				length));
+		std::size_t formatLength = colon != NULL ? colon - field : length;
+		if (colon != NULL && length - formatLength != 3) {
+			return false;
+		}
+		char type = conversion(field, formatLength);
+		if (type == 0) {
+			return false;
+		}
+		step.operation = type == 'd' ? Operation_Integer : Operation_Float;
+		// Formats are kept null terminated for printf, the letters follow
+		if (!addText(field, formatLength, step)
+				|| textLength + 3 > maxText) {
+			return false;
+		}
+		text[textLength++] = '\0';
+		if (colon != NULL) {
+			step.signLetters = true;
+			text[textLength++] = colon[1];
+			text[textLength++] = colon[2];
+		}
+	} else if (keyword(field, length, "time", 3, 2, digits)) {
+		step.operation = Operation_Time;
+	} else if (keyword(field, length, "lat", 7, 4, digits)) {
+		step.operation = Operation_Latitude;
+	} else if (keyword(field, length, "lon", 7, 4, digits)) {
+		step.operation = Operation_Longitude;
+	} else {
+		input = false;
+		step.operation = Operation_Literal;
+		if (length >= 2 && field[0] == '\'' && field[length - 1] == '\'') {
+			++field;
+			length -= 2;
+		}
+		if (!addText(field, length, step)) {
+			return false;
+		}
+	}
+	step.digits = digits;
+
+	if (input) {
+		if (inputCount == 0xFF) {
+			return false;
+		}
+		step.input = inputCount++;
+		if (!explicitSlot) {
+			slot = step.input;
+		}
+		if (slot >= 16) {
+			return false;
+		}
+		step.slot = slot;
+	} else {
+		step.slot = explicitSlot ? slot : noSlot;
+	}
+	steps[stepCount++] = step;
+	return true;
+}
+
+bool NmeaSentencePlan::addText(const char* field, std::size_t length,
+		Step& step) {
+	if (length > 0xFF || textLength + length > maxText) {
+		return false;
+	}
+	step.text = textLength;
+	step.textLength = length;
+	step.textChecksum = 0;
+	for (std::size_t i = 0; i < length; ++i) {
+		char c = field[i];
+		text[textLength++] = c;
+		step.textChecksum ^= c;
+	}
+	return true;
+}
@@ -0,0 +1,117 @@
+/*
+ * NmeaTagBlock.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaTagBlock.h"
+
+#include <algorithm>
+#include <cstring>
+
+/// @cond
+namespace {
+
+const char hexDigits[] = "0123456789ABCDEF";
+
+/*
+ * Appends name:value to the static part, preceded by ',' when a field is
+ * already there.
+ */
+void appendField(char* prefix, std::size_t& length, bool& separator,
+		char name, const char* value) {
+	if (value == NULL || *value == '\0') {
+		return;
+	}
+	std::size_t room = NmeaTagBlock::maxPrefix - length;
+	std::size_t head = separator ? 3 : 2;
+	if (room <= head) {
+		return;
+	}
+	if (separator) {
+		prefix[length++] = ',';
+	}
+	prefix[length++] = name;
+	prefix[length++] = ':';
+	std::size_t valueLength = std::min(std::strlen(value), room - head);
+	std::memcpy(prefix + length, value, valueLength);
+	length += valueLength;
+	separator = true;
+}
+
+/*
+ * Writes the decimal digits of value, returns their number.
+ */
+std::size_t writeDigits(char* out, uint64_t value) {
+	char digits[20];
+	std::size_t count = 0;
+	do {
+		digits[count++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	for (std::size_t i = 0; i < count; ++i) {
+		out[i] = digits[count - 1 - i];
+	}
+	return count;
+}
+
+} // namespace
+/// @endcond
+
+const std::size_t NmeaTagBlock::maxPrefix;
+
+NmeaTagBlock::NmeaTagBlock(const char* source, const char* destination,
+		NmeaTagTime time) :
+		prefixLength(0), prefixChecksum(0), separator(false), time(time), lineCount(
+				0) {
+	prefix[prefixLength++] = '\\';
+	appendField(prefix, prefixLength, separator, 's', source);
+	appendField(prefix, prefixLength, separator, 'd', destination);
+	for (std::size_t i = 1; i < prefixLength; ++i) {
+		prefixChecksum ^= prefix[i];
+	}
+}
+
+std::size_t NmeaTagBlock::write(char* buffer, std::size_t size, int64_t utcNs) {
+	// ",c:" 20 digits ",n:" 20 digits "*hh\"
+	char tag[maxPrefix + 52];
+	std::memcpy(tag, prefix, prefixLength);
+	std::size_t length = prefixLength;
+	bool comma = separator;
+
+	if (utcNs >= 0) {
+		if (comma) {
+			tag[length++] = ',';
+		}
+		tag[length++] = 'c';
+		tag[length++] = ':';
+		length += writeDigits(tag + length,
+				time == NmeaTagTime_Seconds ?
+						utcNs / 1000000000 : utcNs / 1000000);
+		comma = true;
+	}
+	if (comma) {
+		tag[length++] = ',';
+	}
+	tag[length++] = 'n';
+	tag[length++] = ':';
+	length += writeDigits(tag + length,
+			lineCount.fetch_add(1, std::memory_order_relaxed) + 1);
+
+	uint8_t checksum = prefixChecksum;
+	for (std::size_t i = prefixLength; i < length; ++i) {
+		checksum ^= tag[i];
+	}
+	tag[length++] = '*';
+	tag[length++] = hexDigits[checksum >> 4];
+	tag[length++] = hexDigits[checksum & 0x0F];
+	tag[length++] = '\\';
+
+	if (size != 0) {
+		std::size_t stored = std::min(length, size - 1);
+		std::memcpy(buffer, tag, stored);
+		buffer[stored] = '\0';
+	}
+	return length;
+}
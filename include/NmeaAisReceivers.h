@@ -0,0 +1,90 @@
+/*
+ * NmeaAisReceivers.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAAISRECEIVERS_H_
+#define NMEAAISRECEIVERS_H_
+
+#include <memory>
+#include "NmeaFleetEncoder.h"
+
+/**
+ * @brief Virtual AIS receivers of a simulation, each hearing the targets within its VHF range.
+ *
+ * Every broadcast() the targets are bucketed into a uniform latitude and
+ * longitude grid. Each receiver then only looks at the cells overlapping its
+ * range and checks the great circle distance of the targets found there.
+ * A target is composed the first time a receiver hears it, into a buffer
+ * shared by all receivers, and the same sentence is written to the sink of
+ * every other receiver in range. The cost is therefore proportional to the
+ * number of targets plus the number of receptions, not to receivers times
+ * targets.
+ *
+ * Each receiver gets its sentences in target array order. Targets without a
+ * valid position and of other message types are not heard.
+ */
+class NmeaAisReceivers {
+public:
+	/**
+	 * @brief Creates a network without receivers.
+	 *
+	 * @param [in] cellNauticalMiles Side of the grid cells along a meridian.
+	 * About the typical receiver range works well.
+	 */
+	explicit NmeaAisReceivers(double cellNauticalMiles = 30);
+	~NmeaAisReceivers();
+
+	/**
+	 * @brief Adds a receiver, such as an own ship or a shore station.
+	 *
+	 * @param [in] latitude Latitude in degrees.
+	 * @param [in] longitude Longitude in degrees.
+	 * @param [in] rangeNauticalMiles VHF range.
+	 * @param [in] sink Sink receiving the sentences heard, must outlive the network.
+	 * @return Identifier of the receiver, numbered from 0.
+	 */
+	std::size_t addReceiver(double latitude, double longitude,
+			double rangeNauticalMiles, NmeaSink& sink);
+
+	/**
+	 * @brief Moves a receiver.
+	 *
+	 * @param [in] receiver Identifier returned by addReceiver().
+	 * @param [in] latitude Latitude in degrees.
+	 * @param [in] longitude Longitude in degrees.
+	 *
+	 * @throw std::out_of_range if the receiver does not exist.
+	 */
+	void moveReceiver(std::size_t receiver, double latitude, double longitude);
+
+	/**
+	 * @brief Number of receivers.
+	 */
+	std::size_t receivers() const;
+
+	/**
+	 * @brief Transmits the position report of every target once.
+	 *
+	 * @param [in] targets Targets.
+	 * @param [in] count Number of targets.
+	 * @return Number of sentences written to the receiver sinks.
+	 */
+	std::size_t broadcast(const NmeaAisTarget* targets, std::size_t count);
+
+	/**
+	 * @brief Number of targets composed by the last broadcast(), those heard by at least one receiver.
+	 */
+	std::size_t composed() const;
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaAisReceivers(const NmeaAisReceivers&) = delete;
+	NmeaAisReceivers& operator=(const NmeaAisReceivers&) = delete;
+};
+
+#endif /* NMEAAISRECEIVERS_H_ */
@@ -0,0 +1,206 @@
+/*
+ * NmeaArchive.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAARCHIVE_H_
+#define NMEAARCHIVE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "NmeaComposer.h"
+#include "NmeaSink.h"
+
+/**
+ * @brief Writes the inputs of compose calls into a columnar archive file.
+ *
+ * Instead of the formatted sentence, every append stores the arguments that
+ * would be passed to the matching NmeaComposer function. Records are grouped
+ * in blocks per sentence type; inside a block each argument is a column of
+ * delta-of-delta, zigzag and varint encoded integers.
+ *
+ * Numbers are stored at the precision the composer prints them, so sentences
+ * regenerated by NmeaArchiveReader are byte identical to the ones composed
+ * from the original values. Values must be finite and below 1e14.
+ */
+class NmeaArchiveWriter {
+public:
+	/**
+	 * @brief Creates an archive file, truncating any existing one.
+	 *
+	 * @param [in] path Archive file.
+	 * @param [in] blockRecords Records per sentence type buffered before a block is written.
+	 *
+	 * @throw std::system_error if the file cannot be created.
+	 */
+	explicit NmeaArchiveWriter(const std::string& path,
+			std::size_t blockRecords = 8192);
+
+	/**
+	 * @brief Writes the pending blocks and closes the archive.
+	 */
+	~NmeaArchiveWriter();
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeRMC().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeRMC().
+	 */
+	void appendRMC(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity,
+			const boost::posix_time::time_duration& mtime,
+			const double latitude, const double longitude,
+			const double speedknots, const double coursetrue,
+			const boost::gregorian::date& mdate, const double magneticvar);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeXDR().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeXDR().
+	 */
+	void appendXDR(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity,
+			const std::vector<TransducerMeasurement>& measurements);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeMWV().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeMWV().
+	 */
+	void appendMWV(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double windAngle,
+			const Nmea_AngleReference reference, const double windSpeed,
+			const char windSpeedUnits, const char sensorStatus);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeMWD().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeMWD().
+	 */
+	void appendMWD(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double trueWindDirection,
+			const double magneticWindDirection, const double windSpeedKnots,
+			const double windSpeedMeters);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeHDT().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeHDT().
+	 */
+	void appendHDT(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double headingDegreesTrue);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeVLW().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeVLW().
+	 */
+	void appendVLW(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity,
+			const double totalCumulativeDistance,
+			const double distanceSinceReset);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composeVHW().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composeVHW().
+	 */
+	void appendVHW(int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double headingTrue,
+			const double headingMagnetic, const double speedInKnots,
+			const double speedInKmH);
+
+	/**
+	 * @brief Archives the inputs of NmeaComposer::composePRDID().
+	 *
+	 * @param [in] utcNs Record timestamp in nanoseconds since the Unix epoch.
+	 * Remaining parameters as in NmeaComposer::composePRDID().
+	 */
+	void appendPRDID(int64_t utcNs, const NmeaComposerValid& validity,
+			const double pitch, const double roll, const double heading);
+
+	/**
+	 * @brief Writes the pending blocks of every sentence type.
+	 *
+	 * @throw std::system_error if any block since the archive was created could not be written.
+	 */
+	void flush();
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaArchiveWriter(const NmeaArchiveWriter&) = delete;
+	NmeaArchiveWriter& operator=(const NmeaArchiveWriter&) = delete;
+};
+
+/**
+ * @brief Regenerates sentences from an archive written by NmeaArchiveWriter.
+ *
+ * The file is memory mapped and only its block headers are read on open;
+ * columns are decoded one block at a time while scanning.
+ */
+class NmeaArchiveReader {
+public:
+	/**
+	 * @brief Opens an archive file.
+	 *
+	 * @param [in] path Archive file.
+	 *
+	 * @throw std::system_error if the file cannot be read.
+	 * @throw std::runtime_error if the file is not an archive.
+	 */
+	explicit NmeaArchiveReader(const std::string& path);
+	~NmeaArchiveReader();
+
+	/**
+	 * @brief Number of records of a sentence type.
+	 *
+	 * @param [in] type Sentence type.
+	 */
+	std::size_t size(Nmea_SentenceType type) const;
+
+	/**
+	 * @brief Regenerates the sentences of one type in a time range.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] fromUtcNs First timestamp included.
+	 * @param [in] toUtcNs First timestamp excluded.
+	 * @param [in] sink Sink receiving the sentences in archive order.
+	 * @return Number of sentences regenerated.
+	 */
+	std::size_t regenerate(Nmea_SentenceType type, int64_t fromUtcNs,
+			int64_t toUtcNs, NmeaSink& sink);
+
+	/**
+	 * @brief Regenerates the sentences of every type in a time range.
+	 *
+	 * Sentence types are merged by timestamp.
+	 *
+	 * @param [in] fromUtcNs First timestamp included.
+	 * @param [in] toUtcNs First timestamp excluded.
+	 * @param [in] sink Sink receiving the sentences.
+	 * @return Number of sentences regenerated.
+	 */
+	std::size_t regenerate(int64_t fromUtcNs, int64_t toUtcNs, NmeaSink& sink);
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaArchiveReader(const NmeaArchiveReader&) = delete;
+	NmeaArchiveReader& operator=(const NmeaArchiveReader&) = delete;
+};
+
+#endif /* NMEAARCHIVE_H_ */
@@ -11,10 +11,10 @@
 #include <vector>
 #include <string>
 #include <boost/date_time.hpp>
-#include <bitset>
+#include "NmeaComposerCore.h"
 #include "NmeaEnums.h"
-
-typedef std::bitset<16> NmeaComposerValid; //!<  Bitset. Each index represents the validity of each input parameter.
+#include "NmeaMetHydro.h"
+#include "NmeaStringStorage.h"
 
 class NmeaComposer {
 public:
@@ -43,8 +43,9 @@ public:
 	 * 13 | Navigational status
 	 * 14 | The checksum data, always begins with *
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in] 	mtime UTC time
 	 * @param [in] 	latitude Latitude
@@ -53,14 +54,44 @@ public:
 	 * @param [in] 	coursetrue Course relative to true north
 	 * @param [in] 	mdate UTC date
 	 * @param [in] 	magneticvar Magnetic variation
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeRMC(std::string& nmea, const std::string& talkerid,
+	template<typename Allocator, typename Talker>
+	static void composeRMC(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
 			const NmeaComposerValid& validity,
 			const boost::posix_time::time_duration& mtime,
 			const double latitude, const double longitude,
 			const double speedknots, const double coursetrue,
-			const boost::gregorian::date& mdate, const double magneticvar);
+			const boost::gregorian::date& mdate, const double magneticvar,
+			NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeRMC(storage, talkerText(talkerid), validity, mtime, latitude,
+				longitude, speedknots, coursetrue, mdate, magneticvar, json);
+	}
+
+	/**
+	 * @brief RMC NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeRMC(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const boost::posix_time::time_duration& mtime,
+			const double latitude, const double longitude,
+			const double speedknots, const double coursetrue,
+			const boost::gregorian::date& mdate, const double magneticvar,
+			NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief XDR NMEA Message composer
@@ -78,15 +109,43 @@ public:
 	 * ... | More Quadruplets like This.
 	 * n | Checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  measurements Vector of measurements. Each item have Transducer Type, Measurement Data, Units and Name of Transducer.
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeXDR(std::string& nmea, const std::string& talkerid,
+	template<typename Allocator, typename Talker>
+	static void composeXDR(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
 			const NmeaComposerValid& validity,
-			const std::vector<TransducerMeasurement>& measurements);
+			const std::vector<TransducerMeasurement>& measurements,
+			NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeXDR(storage, talkerText(talkerid), validity, measurements,
+				json);
+	}
+
+	/**
+	 * @brief XDR NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeXDR(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const std::vector<TransducerMeasurement>& measurements,
+			NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief MWV NMEA Message composer
@@ -104,20 +163,49 @@ public:
 	 * 5 | Sensor Status, A = Valid, V = Void
 	 * 6 | Checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  windAngle Wind Angle in degrees
 	 * @param [in]  reference Reference True or Relative
 	 * @param [in]  windSpeed Wind Speed
 	 * @param [in]  windSpeedUnits Wind Speed Units
 	 * @param [in]  sensorStatus Sensor Status
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeMWV(std::string& nmea, const std::string& talkerid,
+	template<typename Allocator, typename Talker>
+	static void composeMWV(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
 			const NmeaComposerValid& validity, const double windAngle,
 			const Nmea_AngleReference reference, const double windSpeed,
-			const char windSpeedUnits, const char sensorStatus);
+			const char windSpeedUnits, const char sensorStatus,
+			NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeMWV(storage, talkerText(talkerid), validity, windAngle,
+				reference, windSpeed, windSpeedUnits, sensorStatus, json);
+	}
+
+	/**
+	 * @brief MWV NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeMWV(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const double windAngle, const Nmea_AngleReference reference,
+			const double windSpeed, const char windSpeedUnits,
+			const char sensorStatus, NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief MWD NMEA Message composer
@@ -138,19 +226,48 @@ public:
 	 * 8 | meters/second
 	 * 9 | checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  trueWindDirection Wind Direction in Degrees relative to True North.
 	 * @param [in]  magneticWindDirection Wind Direction in Degrees relative to Magnetic North.
 	 * @param [in]  windSpeedKnots Wind Speed in Knots.
 	 * @param [in]  windSpeedMeters Wind Speed in Meters per second.
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeMWD(std::string& nmea, const std::string& talkerid,
+	template<typename Allocator, typename Talker>
+	static void composeMWD(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
 			const NmeaComposerValid& validity, const double trueWindDirection,
 			const double magneticWindDirection, const double windSpeedKnots,
-			const double windSpeedMeters);
+			const double windSpeedMeters, NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeMWD(storage, talkerText(talkerid), validity, trueWindDirection,
+				magneticWindDirection, windSpeedKnots, windSpeedMeters,
+				json);
+	}
+
+	/**
+	 * @brief MWD NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeMWD(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const double trueWindDirection, const double magneticWindDirection,
+			const double windSpeedKnots, const double windSpeedMeters,
+			NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief HDT NMEA Message composer
@@ -165,14 +282,41 @@ public:
 	 * 2 | T = True
 	 * 3 | Checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  headingDegreesTrue Heading degrees relative to true north
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeHDT(std::string& nmea, const std::string& talkerid,
-			const NmeaComposerValid& validity, const double headingDegreesTrue);
+	template<typename Allocator, typename Talker>
+	static void composeHDT(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
+			const NmeaComposerValid& validity, const double headingDegreesTrue,
+			NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeHDT(storage, talkerText(talkerid), validity,
+				headingDegreesTrue, json);
+	}
+
+	/**
+	 * @brief HDT NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeHDT(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const double headingDegreesTrue, NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief VLW NMEA Message composer
@@ -189,17 +333,44 @@ public:
 	 * 4 | N = Nautical Miles
 	 * 5 | Checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  totalCumulativeDistance Total cumulative distance in Nautical Miles
 	 * @param [in]  distanceSinceReset Distance since reset in Nautical Miles
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeVLW(std::string& nmea, const std::string& talkerid,
+	template<typename Allocator, typename Talker>
+	static void composeVLW(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
 			const NmeaComposerValid& validity,
 			const double totalCumulativeDistance,
-			const double distanceSinceReset);
+			const double distanceSinceReset, NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeVLW(storage, talkerText(talkerid), validity,
+				totalCumulativeDistance, distanceSinceReset, json);
+	}
+
+	/**
+	 * @brief VLW NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeVLW(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const double totalCumulativeDistance,
+			const double distanceSinceReset, NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief VHW NMEA Message composer
@@ -220,19 +391,47 @@ public:
 	 * 8 | K = Kilometres
 	 * 9 | Checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
-	 * @param [in]  talkerid Talker Identifier (2 characters)
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier (2 characters), a C string or
+	 * a string of any allocator
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  headingTrue Heading degrees true
 	 * @param [in]  headingMagnetic Heading magnetic true
 	 * @param [in]  speedInKnots Speed in Knots
 	 * @param [in]  speedInKmH Speed in Km/h
+	 * @param [out] json JSON delta receiving the values too, null for none
 	 *
 	 */
-	static void composeVHW(std::string& nmea, const std::string& talkerid,
+	template<typename Allocator, typename Talker>
+	static void composeVHW(NmeaString<Allocator>& nmea,
+			const Talker& talkerid,
 			const NmeaComposerValid& validity, const double headingTrue,
 			const double headingMagnetic, const double speedInKnots,
-			const double speedInKmH);
+			const double speedInKmH, NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeVHW(storage, talkerText(talkerid), validity, headingTrue,
+				headingMagnetic, speedInKnots, speedInKmH, json);
+	}
+
+	/**
+	 * @brief VHW NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeVHW(char* buffer, std::size_t size,
+			const std::string& talkerid, const NmeaComposerValid& validity,
+			const double headingTrue, const double headingMagnetic,
+			const double speedInKnots, const double speedInKmH,
+			NmeaJsonDelta* json = 0);
 
 	/**
 	 * @brief PRDID NMEA Message composer
@@ -248,29 +447,275 @@ public:
 	 * 3 | Heading
 	 * 4 | Checksum
 	 *
-	 * @param [out] nmea String with NMEA Sentence
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
 	 * @param [in]  talkerid Talker Identifier (2 characters)
 	 * @param [in] 	validity Each field validity
 	 * @param [in]  pitch Is the up/down rotation of a vessel about its lateral/Y (side-to-side or port-starboard) axis.
 	 * @param [in]  roll Is the tilting rotation of a vessel about its longitudinal/X (front-back or bow-stern) axis.
 	 * @param [in]  heading Is the north direction of a vessel.
+	 * @param [out] json JSON delta receiving the values too, null for none
+	 *
+	 */
+	template<typename Allocator>
+	static void composePRDID(NmeaString<Allocator>& nmea,
+			const NmeaComposerValid& validity, const double pitch,
+			const double roll, const double heading, NmeaJsonDelta* json = 0) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composePRDID(storage, validity, pitch, roll, heading, json);
+	}
+
+	/**
+	 * @brief PRDID NMEA Message composer writing into a caller supplied buffer
 	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
 	 */
-	static void composePRDID(std::string& nmea,
+	static std::size_t composePRDID(char* buffer, std::size_t size,
 			const NmeaComposerValid& validity, const double pitch,
-			const double roll, const double heading);
+			const double roll, const double heading, NmeaJsonDelta* json = 0);
+
+	/**
+	 * @brief AIS Position Report Class A NMEA Message composer
+	 *
+	 * <b>VDM NMEA message fields</b><br>
+	 * <i>AIS VHF Data-link Message, message 1</i>
+	 *
+	 * Field | Meaning
+	 * ------|---------
+	 * 0 | Message ID !AIVDM
+	 * 1 | Number of fragments, always 1
+	 * 2 | Fragment number, always 1
+	 * 3 | Sequential message ID, empty
+	 * 4 | Radio channel, A or B
+	 * 5 | Armored payload
+	 * 6 | Fill bits, always 0
+	 * 7 | Checksum
+	 *
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  report Position report, rate of turn in degrees per minute. NaN values are encoded as not available.
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 */
+	template<typename Allocator>
+	static void composeAISPositionReportClassA(NmeaString<Allocator>& nmea,
+			const AISPositionReportClassA& report, char channel) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeAISPositionReportClassA(storage, report, channel);
+	}
+
+	/**
+	 * @brief AIS Position Report Class A NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeAISPositionReportClassA(char* buffer,
+			std::size_t size, const AISPositionReportClassA& report,
+			char channel);
+
+	/**
+	 * @brief AIS Standard Class B CS Position Report NMEA Message composer
+	 *
+	 * <b>VDM NMEA message fields</b><br>
+	 * <i>AIS VHF Data-link Message, message 18</i>
+	 *
+	 * Fields as in composeAISPositionReportClassA(). The report is encoded as
+	 * sent by a Class B CS unit.
+	 *
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  report Position report. NaN values are encoded as not available.
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 */
+	template<typename Allocator>
+	static void composeAISStandardClassBCSPositionReport(
+			NmeaString<Allocator>& nmea,
+			const AISStandardClassBCSPositionReport& report, char channel) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeAISStandardClassBCSPositionReport(storage, report, channel);
+	}
+
+	/**
+	 * @brief AIS Standard Class B CS Position Report NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeAISStandardClassBCSPositionReport(char* buffer,
+			std::size_t size, const AISStandardClassBCSPositionReport& report,
+			char channel);
+
+	/**
+	 * @brief AIS Meteorological and Hydrological Data NMEA Message composer
+	 *
+	 * <b>VDM NMEA message fields</b><br>
+	 * <i>AIS VHF Data-link Message, message 8, DAC 1, FI 31</i>
+	 *
+	 * Fields as in composeAISPositionReportClassA(). The binary broadcast
+	 * follows IMO SN.1/Circ.289.
+	 *
+	 * @param [out] nmea String with NMEA Sentence, of any allocator
+	 * @param [in]  report Station and observations. NaN values are encoded as not available.
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 */
+	template<typename Allocator>
+	static void composeAISMeteorologicalHydrologicalData(
+			NmeaString<Allocator>& nmea,
+			const AISMeteorologicalHydrologicalData& report, char channel) {
+		NmeaStringStorageOf<Allocator> storage(nmea);
+		composeAISMeteorologicalHydrologicalData(storage, report, channel);
+	}
+
+	/**
+	 * @brief AIS Meteorological and Hydrological Data NMEA Message composer writing into a caller supplied buffer
+	 *
+	 * Produces the same sentence as the std::string overload without any heap
+	 * allocation. Like snprintf, the sentence is truncated to size - 1
+	 * characters and always null terminated.
+	 *
+	 * @param [out] buffer Buffer receiving the null terminated NMEA Sentence
+	 * @param [in]  size Size of buffer
+	 * Remaining parameters as in the std::string overload.
+	 *
+	 * @return Length of the complete sentence, not counting the terminator.
+	 * The sentence was truncated if it is not smaller than size.
+	 */
+	static std::size_t composeAISMeteorologicalHydrologicalData(char* buffer,
+			std::size_t size, const AISMeteorologicalHydrologicalData& report,
+			char channel);
+
+	/**
+	 * @brief Composes an XDR sentence and the AIS Meteorological and
+	 * Hydrological Data message of the same measurements.
+	 *
+	 * The measurements are viewed once; the XDR sentence is composed from
+	 * them as in composeXDR(), then mapper stores them in report, which is
+	 * encoded into vdm as in composeAISMeteorologicalHydrologicalData().
+	 *
+	 * @param [out] xdr String with the XDR NMEA Sentence, of any allocator
+	 * @param [out] vdm String with the VDM NMEA Sentence, of any allocator
+	 * @param [in]  talkerid Talker Identifier of the XDR sentence (2
+	 * characters), a C string or a string of any allocator
+	 * @param [in] 	validity Each XDR field validity
+	 * @param [in]  measurements Vector of measurements
+	 * @param [in]  mapper Observation of each measurement
+	 * @param [in,out] report Station and observations, receiving the measurements
+	 * @param [in]  channel AIS channel, 'A' or 'B'
+	 *
+	 */
+	template<typename XdrAllocator, typename VdmAllocator, typename Talker>
+	static void composeXDR(NmeaString<XdrAllocator>& xdr,
+			NmeaString<VdmAllocator>& vdm,
+			const Talker& talkerid, const NmeaComposerValid& validity,
+			const std::vector<TransducerMeasurement>& measurements,
+			const NmeaMetHydro& mapper,
+			AISMeteorologicalHydrologicalData& report, char channel) {
+		NmeaStringStorageOf<XdrAllocator> xdrStorage(xdr);
+		NmeaStringStorageOf<VdmAllocator> vdmStorage(vdm);
+		composeXDR(xdrStorage, vdmStorage, talkerText(talkerid), validity,
+				measurements, mapper, report, channel);
+	}
 
 private:
 	class impl;
 
+	static const char* talkerText(const char* talkerid) {
+		return talkerid;
+	}
+
+	template<typename Allocator>
+	static const char* talkerText(const NmeaString<Allocator>& talkerid) {
+		return talkerid.c_str();
+	}
+
+	static void composeRMC(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity,
+			const boost::posix_time::time_duration& mtime,
+			const double latitude, const double longitude,
+			const double speedknots, const double coursetrue,
+			const boost::gregorian::date& mdate, const double magneticvar,
+			NmeaJsonDelta* json);
+
+	static void composeXDR(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity,
+			const std::vector<TransducerMeasurement>& measurements,
+			NmeaJsonDelta* json);
+
+	static void composeMWV(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity, const double windAngle,
+			const Nmea_AngleReference reference, const double windSpeed,
+			const char windSpeedUnits, const char sensorStatus,
+			NmeaJsonDelta* json);
+
+	static void composeMWD(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity, const double trueWindDirection,
+			const double magneticWindDirection, const double windSpeedKnots,
+			const double windSpeedMeters, NmeaJsonDelta* json);
+
+	static void composeHDT(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity, const double headingDegreesTrue,
+			NmeaJsonDelta* json);
+
+	static void composeVLW(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity,
+			const double totalCumulativeDistance,
+			const double distanceSinceReset, NmeaJsonDelta* json);
+
+	static void composeVHW(NmeaStringStorage& nmea, const char* talkerid,
+			const NmeaComposerValid& validity, const double headingTrue,
+			const double headingMagnetic, const double speedInKnots,
+			const double speedInKmH, NmeaJsonDelta* json);
+
+	static void composePRDID(NmeaStringStorage& nmea,
+			const NmeaComposerValid& validity, const double pitch,
+			const double roll, const double heading, NmeaJsonDelta* json);
+
+	static void composeAISPositionReportClassA(NmeaStringStorage& nmea,
+			const AISPositionReportClassA& report, char channel);
+
+	static void composeAISStandardClassBCSPositionReport(
+			NmeaStringStorage& nmea,
+			const AISStandardClassBCSPositionReport& report, char channel);
+
+	static void composeAISMeteorologicalHydrologicalData(
+			NmeaStringStorage& nmea,
+			const AISMeteorologicalHydrologicalData& report, char channel);
+
+	static void composeXDR(NmeaStringStorage& xdr, NmeaStringStorage& vdm,
+			const char* talkerid, const NmeaComposerValid& validity,
+			const std::vector<TransducerMeasurement>& measurements,
+			const NmeaMetHydro& mapper,
+			AISMeteorologicalHydrologicalData& report, char channel);
+
 	/**
 	 * @brief Private constructor. Prevents creating of class instance.
 	 */
 	NmeaComposer();
-
-	static void composeNmea(std::string& nmea,
-			std::vector<std::string>& fields);
-	static int16_t calculateNmeaChecksum(const std::string& nmeaStr);
 };
 
 #endif /* NMEACOMPOSER_H_ */
@@ -10,6 +10,8 @@
 #define SRC_NMEAENUMS_H_
 
 #include <iostream>
+#include <string>
+#include "NmeaCoreEnums.h"
 
 /**
  * @brief GPS Quality Indicator in NMEA Sentence GGA. Used in NmeaParser::parseGGA().
@@ -30,6 +32,21 @@ enum Nmea_GPSQualityIndicator {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_GPSQualityIndicator val);
 
+/**
+ * @brief Names of Nmea_GPSQualityIndicator values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_GPSQualityIndicator> {
+	static constexpr std::size_t count = 5; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"FixNotValid",
+			"GPSFix",
+			"GPSFixDifferential",
+			"RealTimeKinematic",
+			"RealTimeKinematicOmniStar" };
+};
+
 /**
  * @brief Speed Distance Units in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -47,6 +64,19 @@ enum Nmea_SpeedDistanceUnits {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_SpeedDistanceUnits val);
 
+/**
+ * @brief Names of Nmea_SpeedDistanceUnits values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_SpeedDistanceUnits> {
+	static constexpr std::size_t count = 3; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"Kph_Kilometers",
+			"Mps_Meters",
+			"Knots_NauticalMiles" };
+};
+
 /**
  * @brief Target Status in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -64,6 +94,19 @@ enum Nmea_TargetStatus {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_TargetStatus val);
 
+/**
+ * @brief Names of Nmea_TargetStatus values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_TargetStatus> {
+	static constexpr std::size_t count = 3; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"Lost",
+			"Query",
+			"Tracking" };
+};
+
 /**
  * @brief Type Of Acquisition in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -82,11 +125,16 @@ enum Nmea_TypeOfAcquisition {
 std::ostream& operator<< (std::ostream & out, Nmea_TypeOfAcquisition val);
 
 /**
- * @brief Angle Reference in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
+ * @brief Names of Nmea_TypeOfAcquisition values.
  */
-enum Nmea_AngleReference {
-	Nmea_AngleReference_True,   //!< Nmea_AngleReference_True
-	Nmea_AngleReference_Relative//!< Nmea_AngleReference_Relative
+template<>
+struct NmeaEnumTraits<Nmea_TypeOfAcquisition> {
+	static constexpr std::size_t count = 3; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"Automatic",
+			"Manual",
+			"Reported" };
 };
 
 /**
@@ -119,6 +167,24 @@ enum Nmea_TrackStatus {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_TrackStatus val);
 
+/**
+ * @brief Names of Nmea_TrackStatus values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_TrackStatus> {
+	static constexpr std::size_t count = 8; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"Non_tracking",
+			"Acquiring",
+			"Lost",
+			"Reserved_1",
+			"Tracking",
+			"Reserved_2",
+			"Tracking_CPA_Alarm",
+			"Tracking_CPA_Alarm_Ack" };
+};
+
 /**
  * @brief Operation in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -135,6 +201,16 @@ enum Nmea_Operation {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_Operation val);
 
+/**
+ * @brief Names of Nmea_Operation values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_Operation> {
+	static constexpr std::size_t count = 2; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = { "Autonomous", "TestTarget" };
+};
+
 /**
  * @brief Speed Mode in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -151,6 +227,18 @@ enum Nmea_SpeedMode {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_SpeedMode val);
 
+/**
+ * @brief Names of Nmea_SpeedMode values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_SpeedMode> {
+	static constexpr std::size_t count = 2; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"TrueSpeedCourse",
+			"Relative" };
+};
+
 /**
  * @brief Stabilization Mode in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -167,6 +255,18 @@ enum Nmea_StabilisationMode {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_StabilisationMode val);
 
+/**
+ * @brief Names of Nmea_StabilisationMode values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_StabilisationMode> {
+	static constexpr std::size_t count = 2; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"OverGround",
+			"ThroughWater" };
+};
+
 /**
  * @brief Nmea Track Data struct used for parsing TTD binary message. Used in NmeaParser::parseTTD().
  */
@@ -227,25 +327,41 @@ enum Nmea_AisMessageType {
 std::ostream& operator<<(std::ostream & out, Nmea_AisMessageType val);
 
 /**
- * @brief Navigation Status for AIS Class A. Used in AISPositionReportClassA
- */
-enum Nmea_NavigationStatus {
-	Nmea_NavigationStatus_UnderWayUsingEngine,       //!< Under Way Using Engine
-	Nmea_NavigationStatus_AtAnchor,                  //!< At Anchor
-	Nmea_NavigationStatus_NotUnderCommand,           //!< Not Under Command
-	Nmea_NavigationStatus_RestrictedManeuverability, //!< Restricted Maneuverability
-	Nmea_NavigationStatus_ConstrainedByHerDraught,   //!< Constrained By Her Draught
-	Nmea_NavigationStatus_Moored,                    //!< Moored
-	Nmea_NavigationStatus_Aground,                   //!< Aground
-	Nmea_NavigationStatus_EngagedInFishing,          //!< Engaged In Fishing
-	Nmea_NavigationStatus_UnderWaySailing,           //!< Under Way Sailing
-	Nmea_NavigationStatus_Reserved_HSC,              //!< Reserved HSC
-	Nmea_NavigationStatus_Reserved_WIG,              //!< Reserved WIG
-	Nmea_NavigationStatus_Reserved1,                 //!< Reserved
-	Nmea_NavigationStatus_Reserved2,                 //!< Reserved
-	Nmea_NavigationStatus_Reserved3,                 //!< Reserved
-	Nmea_NavigationStatus_AIS_SART,                  //!< AIS SART
-	Nmea_NavigationStatus_NotDefined                 //!< Not Defined
+ * @brief Names of Nmea_AisMessageType values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_AisMessageType> {
+	static constexpr std::size_t count = 28; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"NA",
+			"PositionReportClassA",
+			"PositionReportClassA_AssignedSchedule",
+			"PositionReportClassA_ResponseToInterrogation",
+			"BaseStationReport",
+			"StaticAndVoyageRelatedData",
+			"BinaryAddressedMessage",
+			"BinaryAcknowledge",
+			"BinaryBroadcastMessage",
+			"StandardSARAircraftPositionReport",
+			"UTCAndDateInquiry",
+			"UTCAndDateResponse",
+			"AddressedSafetyRelatedMessage",
+			"SafetyRelatedAcknowledgment",
+			"SafetyRelatedBroadcastMessage",
+			"Interrogation",
+			"AssignmentModeCommand",
+			"DGNSSBinaryBroadcastMessage",
+			"StandardClassBCSPositionReport",
+			"ExtendedClassBEquipmentPositionReport",
+			"DataLinkManagement",
+			"AidToNavigationReport",
+			"ChannelManagement",
+			"GroupAssignmentCommand",
+			"StaticDataReport",
+			"SingleSlotBinaryMessage",
+			"MultipleSlotBinaryMessageWithCommunicationsState",
+			"PositionReportForLongRangeApplications" };
 };
 
 /**
@@ -256,14 +372,6 @@ enum Nmea_NavigationStatus {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_NavigationStatus val);
 
-/**
- * @brief Position Accuracy for AIS. Used in AISPositionReportClassA, AISBaseStationReport and AISStandardClassBCSPositionReport.
- */
-enum Nmea_PositionAccuracy {
-	Nmea_PositionAccuracy_UnaugmentedGNSSFix,//!< Unaugmented GNSS Fix
-	Nmea_PositionAccuracy_DGPSQualityFix     //!< DGPS Quality Fix
-};
-
 /**
  * @brief Operator converts enumerator value to string.
  * @param out ostream to write the string.
@@ -272,15 +380,6 @@ enum Nmea_PositionAccuracy {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_PositionAccuracy val);
 
-/**
- * @brief Maneuver Indicator for AIS. Used in AISPositionReportClassA.
- */
-enum Nmea_ManeuverIndicator {
-	Nmea_ManeuverIndicator_NotAvailable,     //!< Not Available
-	Nmea_ManeuverIndicator_NoSpecialManeuver,//!< No Special Maneuver
-	Nmea_ManeuverIndicator_SpecialManeuver   //!< Special Maneuver
-};
-
 /**
  * @brief Operator converts enumerator value to string.
  * @param out ostream to write the string.
@@ -289,14 +388,6 @@ enum Nmea_ManeuverIndicator {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_ManeuverIndicator val);
 
-/**
- * @brief RAIM for AIS. Used in AISPositionReportClassA and AISBaseStationReport.
- */
-enum Nmea_RAIM {
-	Nmea_RAIM_NotInUse,//!< Not In Use
-	Nmea_RAIM_InUse    //!< In Use
-};
-
 /**
  * @brief Operator converts enumerator value to string.
  * @param out ostream to write the string.
@@ -328,6 +419,25 @@ enum Nmea_EPFDFix {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_EPFDFix val);
 
+/**
+ * @brief Names of Nmea_EPFDFix values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_EPFDFix> {
+	static constexpr std::size_t count = 9; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"Undefined",
+			"GPS",
+			"GLONASS",
+			"CombinedGPSGLONASS",
+			"LoranC",
+			"Chayka",
+			"IntegratedNavigationSystem",
+			"Surveyed",
+			"Galileo" };
+};
+
 /**
  * @brief Ship Type for AIS. Used in AISStaticAndVoyageRelatedData and AISStaticDataReport
  */
@@ -443,22 +553,113 @@ enum Nmea_ShipType {
 std::ostream& operator<<(std::ostream & out, Nmea_ShipType val);
 
 /**
- * @brief Struct used to parse Position Report Class A Ais Message. Used in NmeaParser::parseAISPositionReportClassA().
- */
-struct AISPositionReportClassA {
-	int repeatIndicator; //!< Message repeat count
-	uint mmsi; //!< 9 decimal digits ID
-	Nmea_NavigationStatus navigationStatus; //!< Navigation Status
-	float rateOfTurn; //!< Rate of Turn
-	float speedOverGround; //!< Speed Over Ground
-	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
-	float longitude; //!< Longitude
-	float latitude; //!< Latitude
-	float courseOverGround; //!< Course Over Ground
-	uint trueHeading; //!< True Heading
-	uint timestapUTCSecond; //!< Timestamp UTC second
-	Nmea_ManeuverIndicator maneuverIndicator; //!< Maneuver Indicator
-	Nmea_RAIM raim; //!< RAIM
+ * @brief Names of Nmea_ShipType values.
+ */
+template<>
+struct NmeaEnumTraits<Nmea_ShipType> {
+	static constexpr std::size_t count = 100; //!< Number of values
+	/// Names by value
+	static constexpr NmeaEnumName names[count] = {
+			"NotAvailable",
+			"Reserved1",
+			"Reserved2",
+			"Reserved3",
+			"Reserved4",
+			"Reserved5",
+			"Reserved6",
+			"Reserved7",
+			"Reserved8",
+			"Reserved9",
+			"Reserved10",
+			"Reserved11",
+			"Reserved12",
+			"Reserved13",
+			"Reserved14",
+			"Reserved15",
+			"Reserved16",
+			"Reserved17",
+			"Reserved18",
+			"Reserved19",
+			"WingInGround_WIG_AllShipsOfThisType",
+			"WingInGround_WIG_HazardousCategoryA",
+			"WingInGround_WIG_HazardousCategoryB",
+			"WingInGround_WIG_HazardousCategoryC",
+			"WingInGround_WIG_HazardousCategoryD",
+			"WingInGround_WIG_Reserved1",
+			"WingInGround_WIG_Reserved2",
+			"WingInGround_WIG_Reserved3",
+			"WingInGround_WIG_Reserved4",
+			"WingInGround_WIG_Reserved5",
+			"Fishing",
+			"Towing",
+			"Towing_LengthExceeds200mOrBreadthExceeds25m",
+			"DredgingOrUnderwaterOps",
+			"DivingOps",
+			"MilitaryOps",
+			"Sailing",
+			"PleasureCraft",
+			"Reserved_1",
+			"Reserved_2",
+			"HighSpeedCraft_HSC_AllShipsOfThisType",
+			"HighSpeedCraft_HSC_HazardousCategoryA",
+			"HighSpeedCraft_HSC_HazardousCategoryB",
+			"HighSpeedCraft_HSC_HazardousCategoryC",
+			"HighSpeedCraft_HSC_HazardousCategoryD",
+			"HighSpeedCraft_HSC_Reserved1",
+			"HighSpeedCraft_HSC_Reserved2",
+			"HighSpeedCraft_HSC_Reserved3",
+			"HighSpeedCraft_HSC_Reserved4",
+			"HighSpeedCraft_HSC_NoAdditionalInformation",
+			"PilotVessel",
+			"SearchAndRescueVessel",
+			"Tug",
+			"PortTender",
+			"AntiPollutionEquipment",
+			"LawEnforcement",
+			"SpareLocalVessel1",
+			"SpareLocalVessel2",
+			"MedicalTransport",
+			"NoncombatantShipAccordingToRR",
+			"Passenger_AllShipsOfThisType",
+			"Passenger_HazardousCategoryA",
+			"Passenger_HazardousCategoryB",
+			"Passenger_HazardousCategoryC",
+			"Passenger_HazardousCategoryD",
+			"Passenger_Reserved1",
+			"Passenger_Reserved2",
+			"Passenger_Reserved3",
+			"Passenger_Reserved4",
+			"Passenger_NoAdditionalInformation",
+			"Cargo_AllShipsOfThisType",
+			"Cargo_HazardousCategoryA",
+			"Cargo_HazardousCategoryB",
+			"Cargo_HazardousCategoryC",
+			"Cargo_HazardousCategoryD",
+			"Cargo_Reserved1",
+			"Cargo_Reserved2",
+			"Cargo_Reserved3",
+			"Cargo_Reserved4",
+			"Cargo_NoAdditionalInformation",
+			"Tanker_AllShipsOfThisType",
+			"Tanker_HazardousCategoryA",
+			"Tanker_HazardousCategoryB",
+			"Tanker_HazardousCategoryC",
+			"Tanker_HazardousCategoryD",
+			"Tanker_Reserved1",
+			"Tanker_Reserved2",
+			"Tanker_Reserved3",
+			"Tanker_Reserved4",
+			"Tanker_NoAdditionalInformation",
+			"OtherType_AllShipsOfThisType",
+			"OtherType_HazardousCategoryA",
+			"OtherType_HazardousCategoryB",
+			"OtherType_HazardousCategoryC",
+			"OtherType_HazardousCategoryD",
+			"OtherType_Reserved1",
+			"OtherType_Reserved2",
+			"OtherType_Reserved3",
+			"OtherType_Reserved4",
+			"OtherType_NoAdditionalInformation" };
 };
 
 /**
@@ -504,21 +705,6 @@ struct AISStaticAndVoyageRelatedData {
 	std::string destination; //!< 20 characters Destination
 };
 
-/**
- * @brief Struct used to parse Standard Class B CS Position Report Ais Message. Used in NmeaParser::parseAISStandardClassBCSPositionReport().
- */
-struct AISStandardClassBCSPositionReport {
-	int repeatIndicator; //!< Message repeat count
-	uint mmsi; //!< 9 decimal digits ID
-	float speedOverGround; //!< Speed Over Ground
-	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
-	float longitude; //!< Longitude
-	float latitude; //!< Latitude
-	float courseOverGround; //!< Course Over Ground
-	uint trueHeading; //!< True Heading
-	uint timestapUTCSecond; //!< Timestamp UTC second
-};
-
 /**
  * @brief Struct used to parse Static Data Report Ais Message. Used in NmeaParser::parseAISStaticDataReport().
  */
@@ -544,6 +730,22 @@ struct AISStaticDataReport {
 	} partB; //!< Message Part B
 };
 
+/**
+ * @brief Operator converts enumerator value to string.
+ * @param out ostream to write the string.
+ * @param val enumerator value Nmea_SentenceType.
+ * @return ostream to concatenate output.
+ */
+std::ostream& operator<<(std::ostream & out, Nmea_SentenceType val);
+
+/**
+ * @brief Operator converts enumerator value to string.
+ * @param out ostream to write the string.
+ * @param val enumerator value Nmea_MetHydroField.
+ * @return ostream to concatenate output.
+ */
+std::ostream& operator<<(std::ostream & out, Nmea_MetHydroField val);
+
 /**
  * @brief Struct used to pass Transducer Measurement in XDR NMEA message. Used in NmeaParser::parseXDR().
  */
@@ -0,0 +1,102 @@
+/*
+ * NmeaFleetEncoder.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAFLEETENCODER_H_
+#define NMEAFLEETENCODER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "NmeaEnums.h"
+#include "NmeaSink.h"
+
+/**
+ * @brief Position report of one AIS target of a fleet.
+ */
+struct NmeaAisTarget {
+	int64_t slotTime; //!< Transmission time ordering the output, e.g. TDMA slot number
+	char channel; //!< AIS channel, 'A' or 'B'
+	Nmea_AisMessageType messageType; //!< Nmea_AisMessageType_PositionReportClassA or Nmea_AisMessageType_StandardClassBCSPositionReport
+	union {
+		AISPositionReportClassA positionReportClassA; //!< Report of a Class A target
+		AISStandardClassBCSPositionReport standardClassBCSPositionReport; //!< Report of a Class B CS target
+	};
+};
+
+/**
+ * @brief Output order of NmeaFleetEncoder.
+ */
+enum NmeaFleetOrder {
+	NmeaFleetOrder_SlotTime, //!< By NmeaAisTarget::slotTime
+	NmeaFleetOrder_Mmsi      //!< By MMSI
+};
+
+/**
+ * @brief Encodes the position reports of a whole fleet in parallel.
+ *
+ * The targets are split in chunks spread over a pool of worker threads, the
+ * calling thread being one of them. A worker that runs out of chunks steals
+ * from the back of the others, so uneven chunks do not leave cores idle.
+ * Each worker composes into its own buffer with the NmeaComposer AIS
+ * composers; the sentences are then handed over in the requested order, ties
+ * broken by position in the target array. The output is therefore the same
+ * whatever the number of threads and however the work was stolen.
+ *
+ * One encode() runs at a time; buffers are kept from one call to the next.
+ */
+class NmeaFleetEncoder {
+public:
+	/**
+	 * @brief Starts the worker threads.
+	 *
+	 * @param [in] threads Number of threads encoding, the caller included.
+	 * 0 uses one per hardware thread.
+	 */
+	explicit NmeaFleetEncoder(unsigned threads = 0);
+	~NmeaFleetEncoder();
+
+	/**
+	 * @brief Encodes every target into one !AIVDM sentence and writes them to a sink.
+	 *
+	 * Targets of another message type are skipped.
+	 *
+	 * @param [in] targets Targets.
+	 * @param [in] count Number of targets.
+	 * @param [in] order Output order.
+	 * @param [in] sink Sink receiving the sentences, from the calling thread.
+	 * @return Number of sentences written.
+	 */
+	std::size_t encode(const NmeaAisTarget* targets, std::size_t count,
+			NmeaFleetOrder order, NmeaSink& sink);
+
+	/**
+	 * @brief Encodes every target into one !AIVDM sentence.
+	 *
+	 * @param [in] targets Targets.
+	 * @param [in] count Number of targets.
+	 * @param [in] order Output order.
+	 * @param [out] output Receives the sentences, each ended by CR LF,
+	 * replacing its content.
+	 * @return Number of sentences.
+	 */
+	std::size_t encode(const NmeaAisTarget* targets, std::size_t count,
+			NmeaFleetOrder order, std::string& output);
+
+	/**
+	 * @brief Number of threads encoding, the caller included.
+	 */
+	unsigned threads() const;
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaFleetEncoder(const NmeaFleetEncoder&) = delete;
+	NmeaFleetEncoder& operator=(const NmeaFleetEncoder&) = delete;
+};
+
+#endif /* NMEAFLEETENCODER_H_ */
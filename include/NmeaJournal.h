@@ -0,0 +1,166 @@
+/*
+ * NmeaJournal.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAJOURNAL_H_
+#define NMEAJOURNAL_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include "NmeaSink.h"
+
+/**
+ * @brief One sentence read back from a journal.
+ *
+ * The sentence pointer refers directly to the memory mapped segment and stays
+ * valid while the NmeaJournalReader that returned it is alive.
+ */
+struct NmeaJournalRecord {
+	const char* sentence; //!< Sentence bytes, not null terminated
+	std::size_t length; //!< Number of bytes in sentence
+	int64_t monotonicNs; //!< CLOCK_MONOTONIC timestamp in nanoseconds
+	int64_t utcNs; //!< UTC timestamp in nanoseconds since the Unix epoch
+};
+
+/**
+ * @brief Append-only binary journal of composed sentences.
+ *
+ * Sentences are copied with their monotonic and UTC timestamps into memory
+ * mapped segment files named <i>nmea-NNNNNNNNNNNN.njl</i> inside the journal
+ * directory. Appending is a memory copy; the mapped range is only handed to
+ * the kernel once <b>commitBytes</b> have accumulated (group commit) or when
+ * flush() is called.
+ *
+ * Every segment keeps a sparse index with one entry per
+ * <b>indexIntervalNs</b> of UTC time, stored at the end of the file when the
+ * segment is sealed. NmeaJournalReader uses it to seek in O(log n).
+ *
+ * Opening an existing directory never modifies old segments, a new segment
+ * is started after the highest sequence number found.
+ */
+class NmeaJournal: public NmeaSink {
+public:
+	/**
+	 * @brief Opens or creates a journal directory.
+	 *
+	 * @param [in] directory Journal directory. Created if it does not exist.
+	 * @param [in] segmentSize Capacity of each segment file in bytes.
+	 * @param [in] commitBytes Bytes appended between two group commits.
+	 * @param [in] indexIntervalNs UTC time covered by each sparse index entry.
+	 *
+	 * @throw std::system_error if the directory or a segment cannot be created.
+	 */
+	explicit NmeaJournal(const std::string& directory,
+			std::size_t segmentSize = 64 * 1024 * 1024,
+			std::size_t commitBytes = 1024 * 1024,
+			int64_t indexIntervalNs = 1000000000LL);
+
+	/**
+	 * @brief Flushes and seals the active segment.
+	 */
+	~NmeaJournal();
+
+	/**
+	 * @brief Appends a sentence with explicit timestamps.
+	 *
+	 * UTC timestamps are expected to be non-decreasing, the sparse index
+	 * relies on it.
+	 *
+	 * @param [in] sentence Sentence bytes, not null terminated.
+	 * @param [in] length Number of bytes in sentence.
+	 * @param [in] monotonicNs Monotonic timestamp in nanoseconds.
+	 * @param [in] utcNs UTC timestamp in nanoseconds since the Unix epoch.
+	 *
+	 * @throw std::length_error if the sentence does not fit in an empty segment.
+	 */
+	void append(const char* sentence, std::size_t length, int64_t monotonicNs,
+			int64_t utcNs);
+
+protected:
+	/**
+	 * @brief Appends a sentence stamped with the current monotonic and UTC time.
+	 *
+	 * @param [in] sentence Sentence bytes, not null terminated.
+	 * @param [in] length Number of bytes in sentence.
+	 */
+	void writeSentence(const char* sentence, std::size_t length) override;
+
+	/**
+	 * @brief Synchronously writes every appended sentence to disk.
+	 */
+	void flushSentences() override;
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaJournal(const NmeaJournal&) = delete;
+	NmeaJournal& operator=(const NmeaJournal&) = delete;
+};
+
+/**
+ * @brief Sequential reader with timestamp seeking over a journal directory.
+ *
+ * All segments present when the reader is created are memory mapped read
+ * only. Segments still being written are read up to the last complete record.
+ */
+class NmeaJournalReader {
+public:
+	/**
+	 * @brief Maps every segment found in the journal directory.
+	 *
+	 * @param [in] directory Journal directory.
+	 *
+	 * @throw std::system_error if the directory or a segment cannot be read.
+	 */
+	explicit NmeaJournalReader(const std::string& directory);
+	~NmeaJournalReader();
+
+	/**
+	 * @brief Positions the reader on the first record at or after a UTC time.
+	 *
+	 * @param [in] utcNs UTC timestamp in nanoseconds since the Unix epoch.
+	 * @return false if no record is at or after utcNs.
+	 */
+	bool seek(int64_t utcNs);
+
+	/**
+	 * @brief Positions the reader on the first record at or after a UTC time.
+	 *
+	 * @param [in] utc UTC time.
+	 * @return false if no record is at or after utc.
+	 */
+	bool seek(const boost::posix_time::ptime& utc);
+
+	/**
+	 * @brief Positions the reader on the first record of the journal.
+	 */
+	void rewind();
+
+	/**
+	 * @brief Reads the record at the current position and advances.
+	 *
+	 * @param [out] record Record read.
+	 * @return false at the end of the journal.
+	 */
+	bool next(NmeaJournalRecord& record);
+
+	/**
+	 * @brief Number of non empty segments mapped by the reader.
+	 */
+	std::size_t segmentCount() const;
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaJournalReader(const NmeaJournalReader&) = delete;
+	NmeaJournalReader& operator=(const NmeaJournalReader&) = delete;
+};
+
+#endif /* NMEAJOURNAL_H_ */
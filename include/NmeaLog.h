@@ -0,0 +1,65 @@
+/*
+ * NmeaLog.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEALOG_H_
+#define NMEALOG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "NmeaEnums.h"
+
+/**
+ * @brief Asynchronous debug log of the composers.
+ *
+ * Logging threads copy fixed size binary records into a lock free ring
+ * buffer of their own; a background thread formats the records and writes
+ * them to Boost.Log at debug level. Logging never blocks: when a ring is
+ * full the record is dropped and counted.
+ *
+ * The composers log through this class when built with NP_DEBUG.
+ */
+class NmeaLog {
+public:
+	/**
+	 * @brief Logs one field of a sentence being composed.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] index Field index, 0 being the address field.
+	 * @param [in] text Field text, not null terminated. Truncated if too long for a record.
+	 * @param [in] length Number of bytes in text.
+	 */
+	static void field(Nmea_SentenceType type, std::size_t index,
+			const char* text, std::size_t length);
+
+	/**
+	 * @brief Logs a composed sentence.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] text Sentence bytes, not null terminated. Truncated if too long for a record.
+	 * @param [in] length Number of bytes in text.
+	 */
+	static void sentence(Nmea_SentenceType type, const char* text,
+			std::size_t length);
+
+	/**
+	 * @brief Waits until every record logged before the call is written to Boost.Log.
+	 */
+	static void flush();
+
+	/**
+	 * @brief Number of records dropped because a ring buffer was full.
+	 */
+	static uint64_t dropped();
+
+private:
+	/**
+	 * @brief Private constructor. Prevents creating of class instance.
+	 */
+	NmeaLog();
+};
+
+#endif /* NMEALOG_H_ */
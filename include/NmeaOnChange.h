@@ -0,0 +1,176 @@
+/*
+ * NmeaOnChange.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAONCHANGE_H_
+#define NMEAONCHANGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "NmeaComposer.h"
+
+/**
+ * @brief Composes sentences only when their inputs change.
+ *
+ * The last emitted inputs are kept per sentence type and talker identifier,
+ * and for XDR per set of transducers too, so that groups such as
+ * temperatures and pressures sent by the same talker are followed apart.
+ * A sentence is composed and emitted when one of its numeric inputs moved
+ * further than the deadband of that input from the last emitted value, and
+ * always when:
+ * - it is the first of its type and talker, or of its XDR transducer set,
+ * - the validity bitset changed,
+ * - an input went from or to NaN,
+ * - a non numeric input changed, such as the MWV reference,
+ * - the keep-alive interval elapsed since the last emission.
+ *
+ * Inputs are numbered in the order of the numeric parameters of each
+ * composer; XDR inputs are the measurement data of each transducer. Angles
+ * in degrees are compared modulo 360. Deadbands are 0 and keep-alive is
+ * disabled until configured, so any change is emitted.
+ *
+ * Times are CLOCK_MONOTONIC (std::chrono::steady_clock) nanoseconds. An
+ * instance is meant for one producer thread.
+ */
+class NmeaOnChange {
+public:
+	NmeaOnChange();
+	~NmeaOnChange();
+
+	/**
+	 * @brief Sets the deadband of every input of a sentence type.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] deadband Smallest change emitted, in the unit of the inputs.
+	 */
+	void setDeadband(Nmea_SentenceType type, double deadband);
+
+	/**
+	 * @brief Sets the deadband of one input of a sentence type.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] input Input index, from 0.
+	 * @param [in] deadband Smallest change emitted, in the unit of the input.
+	 */
+	void setDeadband(Nmea_SentenceType type, std::size_t input,
+			double deadband);
+
+	/**
+	 * @brief Sets the longest time a sentence type stays silent.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] intervalNs Keep-alive interval in nanoseconds, 0 disables it.
+	 */
+	void setKeepAlive(Nmea_SentenceType type, int64_t intervalNs);
+
+	/**
+	 * @brief Decides whether a sentence has to be emitted, and if so records its inputs as emitted.
+	 *
+	 * For composers without an on-change overload here, e.g. the buffer ones.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] talkerid Talker Identifier.
+	 * @param [in] validity Each field validity.
+	 * @param [in] inputs Numeric inputs.
+	 * @param [in] count Number of inputs.
+	 * @param [in] monotonicNs Current time.
+	 * @param [in] angles Bit i set when inputs[i] is an angle in degrees.
+	 * @return true if the sentence has to be emitted.
+	 */
+	bool changed(Nmea_SentenceType type, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double* inputs,
+			std::size_t count, int64_t monotonicNs, uint32_t angles = 0);
+
+	/**
+	 * @brief Forgets every emitted sentence, the next ones are all emitted.
+	 */
+	void reset();
+
+	/**
+	 * @brief On-change NmeaComposer::composeXDR(). Inputs are the measurement data.
+	 *
+	 * Measurements of different transducer types, units or names are
+	 * separate streams, each compared to its own last emission.
+	 *
+	 * @param [in] monotonicNs Current time, the other parameters as in NmeaComposer.
+	 * @return true if nmea received a sentence to emit, false if unchanged.
+	 */
+	bool composeXDR(std::string& nmea, const std::string& talkerid,
+			const NmeaComposerValid& validity,
+			const std::vector<TransducerMeasurement>& measurements,
+			int64_t monotonicNs);
+
+	/**
+	 * @brief On-change NmeaComposer::composeMWV(). Inputs are windAngle and windSpeed.
+	 *
+	 * Changes of reference, units or status are always emitted.
+	 *
+	 * @param [in] monotonicNs Current time, the other parameters as in NmeaComposer.
+	 * @return true if nmea received a sentence to emit, false if unchanged.
+	 */
+	bool composeMWV(std::string& nmea, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double windAngle,
+			const Nmea_AngleReference reference, const double windSpeed,
+			const char windSpeedUnits, const char sensorStatus,
+			int64_t monotonicNs);
+
+	/**
+	 * @brief On-change NmeaComposer::composeMWD(). Inputs are trueWindDirection,
+	 * magneticWindDirection, windSpeedKnots and windSpeedMeters.
+	 *
+	 * @param [in] monotonicNs Current time, the other parameters as in NmeaComposer.
+	 * @return true if nmea received a sentence to emit, false if unchanged.
+	 */
+	bool composeMWD(std::string& nmea, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double trueWindDirection,
+			const double magneticWindDirection, const double windSpeedKnots,
+			const double windSpeedMeters, int64_t monotonicNs);
+
+	/**
+	 * @brief On-change NmeaComposer::composeHDT(). The input is headingDegreesTrue.
+	 *
+	 * @param [in] monotonicNs Current time, the other parameters as in NmeaComposer.
+	 * @return true if nmea received a sentence to emit, false if unchanged.
+	 */
+	bool composeHDT(std::string& nmea, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double headingDegreesTrue,
+			int64_t monotonicNs);
+
+	/**
+	 * @brief On-change NmeaComposer::composeVLW(). Inputs are
+	 * totalCumulativeDistance and distanceSinceReset.
+	 *
+	 * @param [in] monotonicNs Current time, the other parameters as in NmeaComposer.
+	 * @return true if nmea received a sentence to emit, false if unchanged.
+	 */
+	bool composeVLW(std::string& nmea, const std::string& talkerid,
+			const NmeaComposerValid& validity,
+			const double totalCumulativeDistance,
+			const double distanceSinceReset, int64_t monotonicNs);
+
+	/**
+	 * @brief On-change NmeaComposer::composeVHW(). Inputs are headingTrue,
+	 * headingMagnetic, speedInKnots and speedInKmH.
+	 *
+	 * @param [in] monotonicNs Current time, the other parameters as in NmeaComposer.
+	 * @return true if nmea received a sentence to emit, false if unchanged.
+	 */
+	bool composeVHW(std::string& nmea, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double headingTrue,
+			const double headingMagnetic, const double speedInKnots,
+			const double speedInKmH, int64_t monotonicNs);
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaOnChange(const NmeaOnChange&) = delete;
+	NmeaOnChange& operator=(const NmeaOnChange&) = delete;
+};
+
+#endif /* NMEAONCHANGE_H_ */
@@ -0,0 +1,103 @@
+/*
+ * NmeaReplay.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAREPLAY_H_
+#define NMEAREPLAY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include "NmeaSink.h"
+
+/**
+ * @brief Replays recorded NMEA output into sinks.
+ *
+ * The recording is either a NmeaJournal directory or a plain-text NMEA file
+ * with one sentence per line. Plain-text files are memory mapped and their
+ * sentences timestamped from NMEA 4.10 TAG blocks (<b>c:</b>), RMC or ZDA
+ * sentences; sentences without a timestamp inherit the previous one. The
+ * resulting time index is saved next to the file as <i>file.idx</i> and
+ * loaded again while the file is unchanged.
+ *
+ * Sentences are handed to the sinks straight from the mapping, the replay
+ * loop does not allocate.
+ */
+class NmeaReplay {
+public:
+	/**
+	 * @brief Opens a recording and builds or loads its time index.
+	 *
+	 * @param [in] path Journal directory or plain-text NMEA file.
+	 *
+	 * @throw std::system_error if the recording cannot be read.
+	 */
+	explicit NmeaReplay(const std::string& path);
+	~NmeaReplay();
+
+	/**
+	 * @brief Adds a sink receiving every replayed sentence.
+	 *
+	 * @param [in] sink Sink, must outlive the replay.
+	 */
+	void addSink(NmeaSink& sink);
+
+	/**
+	 * @brief Sets the replay speed.
+	 *
+	 * @param [in] speed 1.0 replays in real time, 10.0 ten times faster and
+	 * 0.0 as fast as possible.
+	 */
+	void setSpeed(double speed);
+
+	/**
+	 * @brief Positions the replay on the first sentence at or after a UTC time.
+	 *
+	 * @param [in] utcNs UTC timestamp in nanoseconds since the Unix epoch.
+	 * @return false if no sentence is at or after utcNs.
+	 */
+	bool seek(int64_t utcNs);
+
+	/**
+	 * @brief Positions the replay on the first sentence at or after a UTC time.
+	 *
+	 * @param [in] utc UTC time.
+	 * @return false if no sentence is at or after utc.
+	 */
+	bool seek(const boost::posix_time::ptime& utc);
+
+	/**
+	 * @brief Replays from the current position to the end of the recording.
+	 *
+	 * Sinks are flushed when the replay ends or is stopped.
+	 *
+	 * @return Number of sentences replayed.
+	 */
+	std::size_t run();
+
+	/**
+	 * @brief Stops a running replay. Can be called from any thread.
+	 *
+	 * Called before run() has started, e.g. right after launching the thread
+	 * running it, run() returns at once.
+	 */
+	void stop();
+
+	/**
+	 * @brief Number of sentences in the recording.
+	 */
+	std::size_t size() const;
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaReplay(const NmeaReplay&) = delete;
+	NmeaReplay& operator=(const NmeaReplay&) = delete;
+};
+
+#endif /* NMEAREPLAY_H_ */
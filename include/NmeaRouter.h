@@ -0,0 +1,194 @@
+/*
+ * NmeaRouter.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAROUTER_H_
+#define NMEAROUTER_H_
+
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "NmeaEnums.h"
+#include "NmeaSink.h"
+
+/**
+ * @brief Sentences a sink of NmeaRouter wants.
+ *
+ * By default every sentence.
+ */
+struct NmeaRouteFilter {
+	NmeaRouteFilter() :
+			decimation(1) {
+		types.set();
+	}
+
+	std::bitset<Nmea_SentenceType_Count> types; //!< Sentence types accepted, indexed by Nmea_SentenceType
+	std::vector<std::string> talkers; //!< Talker identifiers accepted, any when empty. "" accepts the proprietary sentences without one
+	unsigned decimation; //!< Forwards 1 of every decimation sentences accepted, counted per sentence type
+};
+
+/**
+ * @brief Composes each sentence once and hands it to every sink whose filter accepts it.
+ *
+ * The filters are turned into bitmasks of sinks when the sinks are added: one
+ * per sentence type and one per talker identifier, so matching a sentence is
+ * two lookups and an AND. A sentence no sink wants is not composed at all.
+ * Otherwise it is composed straight into a reference counted buffer which is
+ * queued, without copying, to each destination. Every sink has its own
+ * delivery thread, a slow sink does not hold back the others; the queues are
+ * not bounded.
+ *
+ * Sinks are added before routing. route() may then be called from any number
+ * of threads; each sink receives the sentences routed by one thread in order.
+ */
+class NmeaRouter {
+public:
+	static const std::size_t maxSinks = 64; //!< Number of sinks a router holds
+
+	NmeaRouter();
+
+	/**
+	 * @brief Delivers the queued sentences, flushes the sinks and stops the delivery threads.
+	 */
+	~NmeaRouter();
+
+	/**
+	 * @brief Adds a destination.
+	 *
+	 * @param [in] sink Sink, must outlive the router.
+	 * @param [in] filter Sentences the sink receives.
+	 * @return Index of the sink, numbered from 0.
+	 *
+	 * @throw std::length_error if the router already holds maxSinks sinks.
+	 */
+	std::size_t addSink(NmeaSink& sink,
+			const NmeaRouteFilter& filter = NmeaRouteFilter());
+
+	/**
+	 * @brief Composes a sentence once and routes it.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] talkerid Talker Identifier, "" for proprietary sentences.
+	 * @param [in] compose Buffer composer, called as compose(buffer, size) and
+	 * returning the length of the complete sentence like the NmeaComposer
+	 * buffer composers. Called again with a larger buffer if the sentence
+	 * did not fit, not called if no sink accepts the sentence.
+	 * @param [in] sensorMonotonicNs CLOCK_MONOTONIC time of the sensor sample,
+	 * recorded by NmeaStatistics::recordSensorToWire() when a sink takes the
+	 * sentence. 0 records nothing.
+	 * @return Number of sinks the sentence was queued to.
+	 */
+	template<typename Compose>
+	std::size_t route(Nmea_SentenceType type, const char* talkerid,
+			Compose compose, int64_t sensorMonotonicNs = 0) {
+		uint64_t sinks = destinations(type, talkerid);
+		if (sinks == 0) {
+			return 0;
+		}
+		std::size_t size = defaultSize;
+		BufferGuard buffer(*this, size);
+		std::size_t length = compose(buffer.text, size);
+		if (length >= size) {
+			size = length + 1;
+			buffer.reallocate(size);
+			compose(buffer.text, size);
+		}
+		return send(buffer.take(), length, sinks, type, sensorMonotonicNs);
+	}
+
+	/**
+	 * @brief Routes a sentence already composed, copying it once.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] talkerid Talker Identifier, "" for proprietary sentences.
+	 * @param [in] sentence Sentence bytes.
+	 * @param [in] length Number of bytes in sentence.
+	 * @param [in] sensorMonotonicNs Time of the sensor sample, 0 for none.
+	 * @return Number of sinks the sentence was queued to.
+	 */
+	std::size_t route(Nmea_SentenceType type, const char* talkerid,
+			const char* sentence, std::size_t length,
+			int64_t sensorMonotonicNs = 0);
+
+	/**
+	 * @brief Waits for every sentence routed so far to be written, then flushes the sinks.
+	 */
+	void flush();
+
+	/**
+	 * @brief Number of sinks.
+	 */
+	std::size_t sinks() const;
+
+private:
+	static const std::size_t defaultSize = 128;
+
+	/*
+	 * Bitmask of the sinks accepting the sentence, advancing the decimation
+	 * counters.
+	 */
+	uint64_t destinations(Nmea_SentenceType type, const char* talkerid);
+
+	/*
+	 * Text of a new buffer with a reference count of 1.
+	 */
+	char* allocate(std::size_t size);
+
+	void release(char* text);
+
+	/*
+	 * Queues the buffer to the sinks and releases the caller reference.
+	 */
+	std::size_t send(char* text, std::size_t length, uint64_t sinks,
+			Nmea_SentenceType type, int64_t sensorMonotonicNs);
+
+	/*
+	 * Buffer from allocate(), released when compose throws unless take()
+	 * handed it over to send().
+	 */
+	class BufferGuard {
+	public:
+		BufferGuard(NmeaRouter& router, std::size_t size) :
+				text(router.allocate(size)), router(router) {
+		}
+
+		~BufferGuard() {
+			if (text != NULL) {
+				router.release(text);
+			}
+		}
+
+		void reallocate(std::size_t size) {
+			router.release(text);
+			text = NULL;
+			text = router.allocate(size);
+		}
+
+		char* take() {
+			char* taken = text;
+			text = NULL;
+			return taken;
+		}
+
+		char* text;
+
+	private:
+		NmeaRouter& router;
+
+		BufferGuard(const BufferGuard&) = delete;
+		BufferGuard& operator=(const BufferGuard&) = delete;
+	};
+
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaRouter(const NmeaRouter&) = delete;
+	NmeaRouter& operator=(const NmeaRouter&) = delete;
+};
+
+#endif /* NMEAROUTER_H_ */
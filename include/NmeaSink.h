@@ -0,0 +1,64 @@
+/*
+ * NmeaSink.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASINK_H_
+#define NMEASINK_H_
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Destination for composed NMEA sentences.
+ *
+ * A sink receives complete sentences, exactly as produced by NmeaComposer,
+ * and is responsible for storing or transmitting them. Implementations
+ * override writeSentence() and flushSentences(); the public write() and
+ * flush() fire the sink_write and sink_flush tracepoints around them.
+ */
+class NmeaSink {
+public:
+	virtual ~NmeaSink() {
+	}
+
+	/**
+	 * @brief Hands a complete sentence over to the sink.
+	 *
+	 * @param [in] sentence Sentence bytes, not null terminated.
+	 * @param [in] length Number of bytes in sentence.
+	 */
+	void write(const char* sentence, std::size_t length);
+
+	/**
+	 * @brief Makes every sentence written so far durable or visible downstream.
+	 */
+	void flush();
+
+	/**
+	 * @brief Convenience overload for sentences composed into a string.
+	 *
+	 * @param [in] sentence NMEA sentence.
+	 */
+	void write(const std::string& sentence) {
+		write(sentence.data(), sentence.size());
+	}
+
+protected:
+	/**
+	 * @brief Stores or transmits a complete sentence.
+	 *
+	 * @param [in] sentence Sentence bytes, not null terminated.
+	 * @param [in] length Number of bytes in sentence.
+	 */
+	virtual void writeSentence(const char* sentence, std::size_t length) = 0;
+
+	/**
+	 * @brief Makes every sentence written so far durable or visible downstream.
+	 */
+	virtual void flushSentences() = 0;
+};
+
+#endif /* NMEASINK_H_ */
@@ -0,0 +1,172 @@
+/*
+ * NmeaStatistics.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASTATISTICS_H_
+#define NMEASTATISTICS_H_
+
+#include <cstdint>
+#include <string>
+#include "NmeaEnums.h"
+
+/**
+ * @brief Counters of one sentence type.
+ */
+struct NmeaSentenceCounters {
+	uint64_t composed; //!< Sentences composed
+	uint64_t bytes; //!< Bytes produced
+	uint64_t invalidFields; //!< Fields flagged as invalid in the validity bitset
+	uint64_t errors; //!< Composition errors, such as a talker identifier not 2 characters long
+};
+
+/**
+ * @brief Point in time copy of every counter.
+ */
+struct NmeaStatisticsSnapshot {
+	NmeaSentenceCounters sentences[Nmea_SentenceType_Count]; //!< Counters indexed by Nmea_SentenceType
+};
+
+/**
+ * @brief Latency percentiles of one sentence type.
+ *
+ * Values are the highest latency equivalent to the histogram bucket holding
+ * the percentile, within about 3% of the exact value.
+ */
+struct NmeaLatencyPercentiles {
+	uint64_t samples; //!< Number of samples recorded
+	int64_t p50Ns; //!< Median in nanoseconds
+	int64_t p99Ns; //!< 99th percentile in nanoseconds
+	int64_t p999Ns; //!< 99.9th percentile in nanoseconds
+	int64_t maxNs; //!< Largest sample in nanoseconds
+	uint64_t sumNs; //!< Sum of the samples in nanoseconds
+};
+
+/**
+ * @brief Point in time copy of every latency histogram.
+ */
+struct NmeaLatencySnapshot {
+	NmeaLatencyPercentiles compose[Nmea_SentenceType_Count]; //!< Time spent in the composer, indexed by Nmea_SentenceType
+	NmeaLatencyPercentiles sensorToWire[Nmea_SentenceType_Count]; //!< Sensor sample to sink handoff, indexed by Nmea_SentenceType
+};
+
+/**
+ * @brief Process wide counters of the composers.
+ *
+ * Sentences are counted by the composers of NmeaComposer. NmeaComposerCore,
+ * which depends on nothing, is not: callers using it directly count their
+ * sentences with record() if they want them in the snapshot.
+ *
+ * Counters are sharded by thread: each thread increments its own cache line
+ * with relaxed atomic adds, and readers sum every shard. Recording never
+ * blocks and never allocates.
+ *
+ * Latencies go to log-linear histograms (32 linear buckets per power of two)
+ * sharded the same way. Only one call in setLatencySampling() reads the
+ * clock, counted per thread, histogram and sentence type; the others cost a
+ * thread local decrement.
+ */
+class NmeaStatistics {
+public:
+	/**
+	 * @brief Counts one composed sentence.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] bytes Sentence length.
+	 * @param [in] invalidFields Number of fields flagged as invalid.
+	 * @param [in] error true if the sentence was composed with an error.
+	 * @param [in] sampleStartNs Value returned by startSample() when the
+	 * composition started, 0 if not sampled.
+	 */
+	static void record(Nmea_SentenceType type, std::size_t bytes,
+			std::size_t invalidFields, bool error, int64_t sampleStartNs = 0);
+
+	/**
+	 * @brief Decides whether the calling composition is timed.
+	 *
+	 * One composition in setLatencySampling() of each sentence type is timed.
+	 *
+	 * @param [in] type Sentence type being composed.
+	 * @return Current monotonic time in nanoseconds for sampled calls, 0 otherwise.
+	 */
+	static int64_t startSample(Nmea_SentenceType type);
+
+	/**
+	 * @brief Records the time from a sensor sample to the sink handoff of the
+	 * sentence carrying it. Call it when the sentence is handed to a sink.
+	 *
+	 * @param [in] type Sentence type.
+	 * @param [in] sensorMonotonicNs CLOCK_MONOTONIC (std::chrono::steady_clock)
+	 * time of the sensor sample, in nanoseconds.
+	 */
+	static void recordSensorToWire(Nmea_SentenceType type,
+			int64_t sensorMonotonicNs);
+
+	/**
+	 * @brief Sets how often latencies are measured.
+	 *
+	 * @param [in] everyN Measure one call in everyN, 1 measures every call and
+	 * 0 disables latency measurement. Defaults to 64.
+	 */
+	static void setLatencySampling(unsigned everyN);
+
+	/**
+	 * @brief Computes the latency percentiles of every histogram.
+	 *
+	 * @param [out] snapshot Percentiles merged over all threads.
+	 */
+	static void latencySnapshot(NmeaLatencySnapshot& snapshot);
+
+	/**
+	 * @brief Reads every counter.
+	 *
+	 * Each counter is read atomically, but counters are not read at the same
+	 * instant as each other.
+	 *
+	 * @param [out] snapshot Counters summed over all threads.
+	 */
+	static void snapshot(NmeaStatisticsSnapshot& snapshot);
+
+	/**
+	 * @brief Sets every counter and histogram back to zero.
+	 */
+	static void reset();
+
+	/**
+	 * @brief Formats the counters in the Prometheus text exposition format.
+	 *
+	 * @param [out] text Exposition text, replacing its content.
+	 */
+	static void writePrometheus(std::string& text);
+
+	/**
+	 * @brief Writes the Prometheus text to a file, e.g. for the node exporter
+	 * textfile collector.
+	 *
+	 * The file is replaced atomically.
+	 *
+	 * @param [in] path Destination file.
+	 *
+	 * @throw std::system_error if the file cannot be written.
+	 */
+	static void exportPrometheusFile(const std::string& path);
+
+	/**
+	 * @brief Sends the Prometheus text to a local (Unix domain) stream socket.
+	 *
+	 * @param [in] path Socket path.
+	 *
+	 * @throw std::system_error if the socket cannot be reached.
+	 */
+	static void exportPrometheusSocket(const std::string& path);
+
+private:
+	/**
+	 * @brief Private constructor. Prevents creating of class instance.
+	 */
+	NmeaStatistics();
+};
+
+#endif /* NMEASTATISTICS_H_ */
@@ -0,0 +1,106 @@
+/*
+ * NmeaStreamCodec.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASTREAMCODEC_H_
+#define NMEASTREAMCODEC_H_
+
+#include <memory>
+#include <string>
+#include "NmeaSink.h"
+
+/**
+ * @brief Compresses a stream of NMEA sentences for low bandwidth links.
+ *
+ * Each sentence is encoded against the previous sentence with the same
+ * address field (talker and sentence type): unchanged fields cost a fraction
+ * of a bit, changed fields are sent as the length of the prefix shared with
+ * the previous value plus the new suffix. Everything is entropy coded with an
+ * adaptive binary range coder whose contexts are the address and field index.
+ * Checksums matching the sentence are not transmitted, NmeaStreamDecoder
+ * recomputes them, so the decoded output is byte identical to the input.
+ *
+ * Sentences are grouped in frames. Coding state carries over from one frame
+ * to the next, so frames must reach the decoder complete and in order; call
+ * reset() on both ends to resynchronise after a loss.
+ */
+class NmeaStreamEncoder {
+public:
+	NmeaStreamEncoder();
+	~NmeaStreamEncoder();
+
+	/**
+	 * @brief Adds a sentence to the current frame.
+	 *
+	 * Anything that is not a well formed sentence is still transmitted
+	 * verbatim, whatever its length.
+	 *
+	 * @param [in] sentence Sentence bytes, not null terminated.
+	 * @param [in] length Number of bytes in sentence.
+	 */
+	void encode(const char* sentence, std::size_t length);
+
+	/**
+	 * @brief Adds a sentence to the current frame.
+	 *
+	 * @param [in] sentence NMEA sentence.
+	 */
+	void encode(const std::string& sentence) {
+		encode(sentence.data(), sentence.size());
+	}
+
+	/**
+	 * @brief Terminates the current frame.
+	 *
+	 * @param [out] frame Receives the encoded frame, replacing its content.
+	 */
+	void finish(std::string& frame);
+
+	/**
+	 * @brief Forgets every previous sentence and adaptive statistics.
+	 */
+	void reset();
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaStreamEncoder(const NmeaStreamEncoder&) = delete;
+	NmeaStreamEncoder& operator=(const NmeaStreamEncoder&) = delete;
+};
+
+/**
+ * @brief Decodes frames produced by NmeaStreamEncoder.
+ */
+class NmeaStreamDecoder {
+public:
+	NmeaStreamDecoder();
+	~NmeaStreamDecoder();
+
+	/**
+	 * @brief Decodes a complete frame.
+	 *
+	 * @param [in] frame Frame bytes.
+	 * @param [in] length Number of bytes in frame.
+	 * @param [in] sink Sink receiving the decoded sentences.
+	 * @return Number of sentences decoded.
+	 */
+	std::size_t decode(const char* frame, std::size_t length, NmeaSink& sink);
+
+	/**
+	 * @brief Forgets every previous sentence and adaptive statistics.
+	 */
+	void reset();
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl;
+
+	NmeaStreamDecoder(const NmeaStreamDecoder&) = delete;
+	NmeaStreamDecoder& operator=(const NmeaStreamDecoder&) = delete;
+};
+
+#endif /* NMEASTREAMCODEC_H_ */
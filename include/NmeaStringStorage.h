@@ -0,0 +1,128 @@
+/*
+ * NmeaStringStorage.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASTRINGSTORAGE_H_
+#define NMEASTRINGSTORAGE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @brief String of chars with any allocator, e.g. std::pmr::string.
+ */
+template<typename Allocator>
+using NmeaString = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+/**
+ * @brief String receiving a sentence, whatever its allocator.
+ *
+ * The string overloads of NmeaComposer compose through this interface, so
+ * that one implementation serves every allocator. Scratch memory the
+ * composers need besides the sentence is taken from the allocator of the
+ * string too.
+ */
+class NmeaStringStorage {
+public:
+	/**
+	 * @brief First character of the string.
+	 */
+	virtual char* data() = 0;
+
+	/**
+	 * @brief Length of the string.
+	 */
+	virtual std::size_t size() const = 0;
+
+	/**
+	 * @brief Resizes the string.
+	 */
+	virtual void resize(std::size_t size) = 0;
+
+	/**
+	 * @brief Replaces the string with a copy of text.
+	 *
+	 * @param [in] text Characters, not null terminated.
+	 * @param [in] size Number of characters.
+	 */
+	virtual void assign(const char* text, std::size_t size) = 0;
+
+	/**
+	 * @brief Scratch memory from the allocator of the string.
+	 *
+	 * @param [in] size Bytes, aligned for any type.
+	 */
+	virtual void* allocate(std::size_t size) = 0;
+
+	/**
+	 * @brief Releases scratch memory.
+	 *
+	 * @param [in] pointer Memory taken with allocate().
+	 * @param [in] size Size it was taken with.
+	 */
+	virtual void deallocate(void* pointer, std::size_t size) = 0;
+
+protected:
+	~NmeaStringStorage() {
+	}
+};
+
+/**
+ * @brief NmeaStringStorage of a NmeaString.
+ */
+template<typename Allocator>
+class NmeaStringStorageOf: public NmeaStringStorage {
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param [in] string String, which must outlive the storage.
+	 */
+	explicit NmeaStringStorageOf(NmeaString<Allocator>& string) :
+			string(string) {
+	}
+
+	char* data() {
+		return &string[0];
+	}
+
+	std::size_t size() const {
+		return string.size();
+	}
+
+	void resize(std::size_t size) {
+		string.resize(size);
+	}
+
+	void assign(const char* text, std::size_t size) {
+		string.assign(text, size);
+	}
+
+	void* allocate(std::size_t size) {
+		ScratchAllocator allocator(string.get_allocator());
+		return ScratchTraits::allocate(allocator, blocks(size));
+	}
+
+	void deallocate(void* pointer, std::size_t size) {
+		ScratchAllocator allocator(string.get_allocator());
+		ScratchTraits::deallocate(allocator,
+				static_cast<std::max_align_t*>(pointer), blocks(size));
+	}
+
+private:
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<
+			std::max_align_t> ScratchAllocator;
+	typedef std::allocator_traits<ScratchAllocator> ScratchTraits;
+
+	static std::size_t blocks(std::size_t size) {
+		return (size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+	}
+
+	NmeaString<Allocator>& string;
+};
+
+#endif /* NMEASTRINGSTORAGE_H_ */
@@ -0,0 +1,261 @@
+/*
+ * NmeaAisReceivers.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaAisReceivers.h"
+#include "NmeaComposer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/// @cond
+namespace {
+
+const double earthRadiusNauticalMiles = 3440.065;
+const double degreesToRadians = M_PI / 180;
+const std::size_t maxSentence = 96;
+const uint32_t notComposed = UINT32_MAX;
+
+struct Receiver {
+	double latitude;
+	double longitude;
+	double range;
+	NmeaSink* sink;
+};
+
+/*
+ * Target heard in a grid cell, ordered by cell then target index.
+ */
+struct Bucketed {
+	uint64_t cell;
+	uint32_t index;
+
+	bool operator<(const Bucketed& other) const {
+		return cell < other.cell || (cell == other.cell && index < other.index);
+	}
+};
+
+bool position(const NmeaAisTarget& target, double& latitude,
+		double& longitude) {
+	if (target.messageType == Nmea_AisMessageType_PositionReportClassA) {
+		latitude = target.positionReportClassA.latitude;
+		longitude = target.positionReportClassA.longitude;
+	} else if (target.messageType
+			== Nmea_AisMessageType_StandardClassBCSPositionReport) {
+		latitude = target.standardClassBCSPositionReport.latitude;
+		longitude = target.standardClassBCSPositionReport.longitude;
+	} else {
+		return false;
+	}
+	// Also false for NaN and the 91 and 181 not available values
+	return std::abs(latitude) <= 90 && std::abs(longitude) <= 180;
+}
+
+/*
+ * Great circle distance by the haversine formula.
+ */
+double distance(double latitude1, double longitude1, double latitude2,
+		double longitude2) {
+	double sinLatitude = std::sin((latitude2 - latitude1) * degreesToRadians / 2);
+	double sinLongitude = std::sin(
+			(longitude2 - longitude1) * degreesToRadians / 2);
+	double a = sinLatitude * sinLatitude
+			+ std::cos(latitude1 * degreesToRadians)
+					* std::cos(latitude2 * degreesToRadians) * sinLongitude
+					* sinLongitude;
+	return 2 * earthRadiusNauticalMiles * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+} // namespace
+/// @endcond
+
+class NmeaAisReceivers::impl {
+public:
+	explicit impl(double cellNauticalMiles) :
+			composedCount(0) {
+		double cellDegrees = std::max(cellNauticalMiles, 0.1) / 60;
+		// Whole number of cells around the globe, so longitudes wrap exactly
+		rows = static_cast<int64_t>(std::ceil(180 / cellDegrees));
+		columns = static_cast<int64_t>(std::ceil(360 / cellDegrees));
+		rowDegrees = 180.0 / rows;
+		columnDegrees = 360.0 / columns;
+	}
+
+	std::size_t broadcast(const NmeaAisTarget* targets, std::size_t count) {
+		bucket(targets, count);
+		offsets.assign(count, notComposed);
+		lengths.resize(count);
+		buffer.clear();
+		composedCount = 0;
+
+		std::size_t written = 0;
+		for (const Receiver& receiver : receivers) {
+			heard.clear();
+			search(receiver);
+			std::sort(heard.begin(), heard.end());
+			for (uint32_t index : heard) {
+				if (offsets[index] == notComposed) {
+					compose(targets[index], index);
+				}
+				receiver.sink->write(buffer.data() + offsets[index],
+						lengths[index]);
+			}
+			written += heard.size();
+		}
+		return written;
+	}
+
+	std::vector<Receiver> receivers;
+	std::size_t composedCount;
+
+private:
+	int64_t row(double latitude) const {
+		return std::min(rows - 1,
+				static_cast<int64_t>(std::floor((latitude + 90) / rowDegrees)));
+	}
+
+	int64_t column(double longitude) const {
+		int64_t c = static_cast<int64_t>(std::floor(
+				(longitude + 180) / columnDegrees));
+		return ((c % columns) + columns) % columns;
+	}
+
+	void bucket(const NmeaAisTarget* targets, std::size_t count) {
+		grid.clear();
+		latitudes.resize(count);
+		longitudes.resize(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			if (position(targets[i], latitudes[i], longitudes[i])) {
+				Bucketed bucketed = { static_cast<uint64_t>(row(latitudes[i])
+						* columns + column(longitudes[i])),
+						static_cast<uint32_t>(i) };
+				grid.push_back(bucketed);
+			}
+		}
+		std::sort(grid.begin(), grid.end());
+	}
+
+	/*
+	 * Adds to heard the targets within range, checking the cells of the
+	 * bounding box of the range circle.
+	 */
+	void search(const Receiver& receiver) {
+		double rangeDegrees = receiver.range / 60;
+		int64_t firstRow = row(std::max(-90.0, receiver.latitude - rangeDegrees));
+		int64_t lastRow = row(std::min(90.0, receiver.latitude + rangeDegrees));
+
+		// Widest longitude difference of the circle, every column near a pole
+		double sinRange = std::sin(receiver.range / earthRadiusNauticalMiles);
+		double cosLatitude = std::cos(receiver.latitude * degreesToRadians);
+		int64_t firstColumn = 0;
+		int64_t span = columns;
+		if (sinRange < cosLatitude) {
+			double halfWidth = std::asin(sinRange / cosLatitude)
+					/ degreesToRadians;
+			int64_t first = static_cast<int64_t>(std::floor(
+					(receiver.longitude - halfWidth + 180) / columnDegrees));
+			int64_t last = static_cast<int64_t>(std::floor(
+					(receiver.longitude + halfWidth + 180) / columnDegrees));
+			if (last - first + 1 < columns) {
+				firstColumn = ((first % columns) + columns) % columns;
+				span = last - first + 1;
+			}
+		}
+
+		for (int64_t r = firstRow; r <= lastRow; ++r) {
+			int64_t end = firstColumn + span;
+			scan(receiver, r, firstColumn, std::min(end, columns));
+			if (end > columns) {
+				scan(receiver, r, 0, end - columns);
+			}
+		}
+	}
+
+	/*
+	 * Checks the targets of columns [first, end) of a row.
+	 */
+	void scan(const Receiver& receiver, int64_t r, int64_t first, int64_t end) {
+		Bucketed from = { static_cast<uint64_t>(r * columns + first), 0 };
+		uint64_t to = r * columns + end;
+		for (std::vector<Bucketed>::const_iterator it = std::lower_bound(
+				grid.begin(), grid.end(), from);
+				it != grid.end() && it->cell < to; ++it) {
+			if (distance(receiver.latitude, receiver.longitude,
+					latitudes[it->index], longitudes[it->index])
+					<= receiver.range) {
+				heard.push_back(it->index);
+			}
+		}
+	}
+
+	void compose(const NmeaAisTarget& target, uint32_t index) {
+		std::size_t offset = buffer.size();
+		buffer.resize(offset + maxSentence);
+		std::size_t length;
+		if (target.messageType == Nmea_AisMessageType_PositionReportClassA) {
+			length = NmeaComposer::composeAISPositionReportClassA(
+					&buffer[offset], maxSentence, target.positionReportClassA,
+					target.channel);
+		} else {
+			length = NmeaComposer::composeAISStandardClassBCSPositionReport(
+					&buffer[offset], maxSentence,
+					target.standardClassBCSPositionReport, target.channel);
+		}
+		length = std::min(length, maxSentence - 1);
+		buffer.resize(offset + length);
+		offsets[index] = offset;
+		lengths[index] = length;
+		++composedCount;
+	}
+
+	int64_t rows;
+	int64_t columns;
+	double rowDegrees;
+	double columnDegrees;
+
+	std::vector<Bucketed> grid;
+	std::vector<double> latitudes;
+	std::vector<double> longitudes;
+	std::vector<uint32_t> heard;
+
+	std::vector<char> buffer; // sentences composed this broadcast
+	std::vector<uint32_t> offsets;
+	std::vector<uint32_t> lengths;
+};
+
+NmeaAisReceivers::NmeaAisReceivers(double cellNauticalMiles) :
+		pimpl(new impl(cellNauticalMiles)) {
+}
+
+NmeaAisReceivers::~NmeaAisReceivers() {
+}
+
+std::size_t NmeaAisReceivers::addReceiver(double latitude, double longitude,
+		double rangeNauticalMiles, NmeaSink& sink) {
+	Receiver receiver = { latitude, longitude, rangeNauticalMiles, &sink };
+	pimpl->receivers.push_back(receiver);
+	return pimpl->receivers.size() - 1;
+}
+
+void NmeaAisReceivers::moveReceiver(std::size_t receiver, double latitude,
+		double longitude) {
+	pimpl->receivers.at(receiver).latitude = latitude;
+	pimpl->receivers.at(receiver).longitude = longitude;
+}
+
+std::size_t NmeaAisReceivers::receivers() const {
+	return pimpl->receivers.size();
+}
+
+std::size_t NmeaAisReceivers::broadcast(const NmeaAisTarget* targets,
+		std::size_t count) {
+	return pimpl->broadcast(targets, count);
+}
+
+std::size_t NmeaAisReceivers::composed() const {
+	return pimpl->composedCount;
+}
@@ -0,0 +1,836 @@
+/*
+ * NmeaArchive.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaArchive.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @cond
+namespace {
+
+const char fileMagic[8] = { 'N', 'M', 'E', 'A', 'A', 'R', 'C', 'V' };
+const uint32_t fileVersion = 1;
+const char blockMagic[4] = { 'N', 'M', 'A', 'B' };
+
+struct FileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t reserved;
+};
+
+/*
+ * Block layout:
+ *   BlockHeader
+ *   uint32_t columnSizes[columnCount]
+ *   uint32_t dictionarySize
+ *   column bytes ...
+ *   dictionary: varint count, (varint length, bytes) ...
+ *   padding to 8 bytes
+ */
+struct BlockHeader {
+	char magic[4];
+	uint16_t type;
+	uint16_t columnCount;
+	uint32_t recordCount;
+	uint32_t payloadSize;
+	int64_t firstUtcNs;
+	int64_t lastUtcNs;
+};
+
+/*
+ * Columns shared by every sentence type. Type specific arguments follow.
+ */
+enum CommonColumn {
+	ColumnUtc, ColumnValidity, ColumnTalker, ColumnFirstArgument
+};
+
+/*
+ * XDR stores the measurement count, then four columns per measurement slot.
+ */
+const std::size_t xdrSlotColumns = 4;
+
+const double powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7 };
+
+/*
+ * Negative values are stored as ~magnitude, which keeps -0.0 printed as
+ * "-0.0" distinct from 0.
+ */
+int64_t signedDecimal(bool negative, int64_t magnitude) {
+	return negative ? ~magnitude : magnitude;
+}
+
+/*
+ * The decimal digits printed by "%.<precision>f", as an integer.
+ */
+int64_t quantize(double value, int precision) {
+	char buffer[64];
+	std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+	const char* p = buffer;
+	bool negative = *p == '-';
+	if (negative) {
+		++p;
+	}
+	int64_t magnitude = 0;
+	for (; *p != '\0'; ++p) {
+		if (*p >= '0' && *p <= '9') {
+			magnitude = magnitude * 10 + (*p - '0');
+		}
+	}
+	return signedDecimal(negative, magnitude);
+}
+
+/*
+ * A double printing the same digits as the quantized value. Negative zero
+ * becomes the smallest negative double so that "< 0" tests still hold.
+ */
+double dequantize(int64_t value, int precision) {
+	if (value >= 0) {
+		return value / powersOf10[precision];
+	}
+	int64_t magnitude = ~value;
+	return magnitude == 0 ? -DBL_MIN : -(magnitude / powersOf10[precision]);
+}
+
+/*
+ * Coordinates are printed as whole degrees and minutes with 7 decimals.
+ */
+void quantizeCoordinate(double coordinate, int64_t& degrees,
+		int64_t& minutes) {
+	double wholeDegrees;
+	double fraction = std::modf(std::abs(coordinate), &wholeDegrees);
+	minutes = quantize(fraction * 60.0f, 7);
+	degrees = signedDecimal(coordinate < 0,
+			static_cast<int64_t>(wholeDegrees));
+}
+
+double dequantizeCoordinate(int64_t degrees, int64_t minutes) {
+	bool negative = degrees < 0;
+	double magnitude = negative ? ~degrees : degrees;
+	// 60.0000000 can only come from rounding, keep it below a whole degree
+	double wholeMinutes = minutes >= 600000000 ? 59.99999996 : minutes / 1e7;
+	magnitude += wholeMinutes / 60.0;
+	if (negative) {
+		return magnitude == 0 ? -DBL_MIN : -magnitude;
+	}
+	return magnitude;
+}
+
+int xdrPrecision(char unitsOfMeasurement) {
+	return unitsOfMeasurement == 'B' ? 4 : 1;
+}
+
+int64_t encodeTalker(const std::string& talkerid) {
+	if (talkerid.length() != 2) {
+		return 0;
+	}
+	return (static_cast<unsigned char>(talkerid[0]) << 8)
+			| static_cast<unsigned char>(talkerid[1]);
+}
+
+std::string decodeTalker(int64_t talker) {
+	if (talker == 0) {
+		return std::string();
+	}
+	std::string talkerid(2, ' ');
+	talkerid[0] = static_cast<char>(talker >> 8);
+	talkerid[1] = static_cast<char>(talker);
+	return talkerid;
+}
+
+bool invalid(const NmeaComposerValid& validity, std::size_t index) {
+	return index < validity.size() && validity[index];
+}
+
+void putVarint(std::string& out, uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back(static_cast<char>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<char>(value));
+}
+
+uint64_t getVarint(const unsigned char*& p, const unsigned char* end) {
+	uint64_t value = 0;
+	for (int shift = 0; p < end && shift < 64; shift += 7) {
+		unsigned char byte = *p++;
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			break;
+		}
+	}
+	return value;
+}
+
+std::system_error systemError(const std::string& what) {
+	return std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace
+/// @endcond
+
+class NmeaArchiveWriter::impl {
+public:
+	struct TypeBuffer {
+		std::vector<std::vector<int64_t> > columns;
+		std::vector<std::string> names;
+		std::map<std::string, int64_t> nameIds;
+		int64_t firstUtcNs;
+		int64_t lastUtcNs;
+	};
+
+	impl(const std::string& path, std::size_t blockRecords) :
+			path(path), blockRecords(blockRecords), writeError(0) {
+		file = std::fopen(path.c_str(), "wb");
+		if (file == NULL) {
+			throw systemError("Cannot create archive " + path);
+		}
+		std::setvbuf(file, NULL, _IOFBF, 1 << 20);
+		FileHeader header;
+		std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+		header.version = fileVersion;
+		header.reserved = 0;
+		if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+			int error = errno;
+			std::fclose(file);
+			errno = error;
+			throw systemError("Cannot create archive " + path);
+		}
+	}
+
+	~impl() {
+		try {
+			flush();
+		} catch (const std::system_error&) {
+			// Nothing left to report it to
+		}
+		std::fclose(file);
+	}
+
+	/*
+	 * Starts a record and returns the columns to fill.
+	 */
+	std::vector<std::vector<int64_t> >& begin(Nmea_SentenceType type,
+			int64_t utcNs, const std::string& talkerid,
+			const NmeaComposerValid& validity, std::size_t columnCount) {
+		TypeBuffer& buffer = buffers[type];
+		if (buffer.columns.size() < columnCount) {
+			buffer.columns.resize(columnCount);
+		}
+		if (buffer.columns[ColumnUtc].empty()) {
+			buffer.firstUtcNs = utcNs;
+			buffer.lastUtcNs = utcNs;
+		}
+		buffer.firstUtcNs = std::min(buffer.firstUtcNs, utcNs);
+		buffer.lastUtcNs = std::max(buffer.lastUtcNs, utcNs);
+		buffer.columns[ColumnUtc].push_back(utcNs);
+		buffer.columns[ColumnValidity].push_back(
+				static_cast<int64_t>(validity.to_ulong()));
+		buffer.columns[ColumnTalker].push_back(encodeTalker(talkerid));
+		return buffer.columns;
+	}
+
+	void end(Nmea_SentenceType type) {
+		if (buffers[type].columns[ColumnUtc].size() >= blockRecords) {
+			writeBlock(type);
+		}
+	}
+
+	int64_t nameId(Nmea_SentenceType type, const std::string& name) {
+		TypeBuffer& buffer = buffers[type];
+		std::map<std::string, int64_t>::iterator it = buffer.nameIds.find(
+				name);
+		if (it != buffer.nameIds.end()) {
+			return it->second;
+		}
+		int64_t id = buffer.names.size();
+		buffer.names.push_back(name);
+		buffer.nameIds[name] = id;
+		return id;
+	}
+
+	void writeBlock(Nmea_SentenceType type) {
+		TypeBuffer& buffer = buffers[type];
+		if (buffer.columns.empty() || buffer.columns[ColumnUtc].empty()) {
+			return;
+		}
+
+		std::vector<std::string> encoded(buffer.columns.size());
+		std::vector<uint32_t> sizes(buffer.columns.size());
+		for (std::size_t c = 0; c < buffer.columns.size(); ++c) {
+			uint64_t previous = 0;
+			uint64_t previousDelta = 0;
+			for (int64_t value : buffer.columns[c]) {
+				uint64_t delta = static_cast<uint64_t>(value) - previous;
+				int64_t deltaOfDelta = static_cast<int64_t>(delta
+						- previousDelta);
+				putVarint(encoded[c],
+						(static_cast<uint64_t>(deltaOfDelta) << 1)
+								^ static_cast<uint64_t>(deltaOfDelta >> 63));
+				previous = static_cast<uint64_t>(value);
+				previousDelta = delta;
+			}
+			sizes[c] = encoded[c].size();
+		}
+
+		std::string dictionary;
+		putVarint(dictionary, buffer.names.size());
+		for (const std::string& name : buffer.names) {
+			putVarint(dictionary, name.size());
+			dictionary.append(name);
+		}
+		uint32_t dictionarySize = dictionary.size();
+
+		BlockHeader header;
+		std::memcpy(header.magic, blockMagic, sizeof(blockMagic));
+		header.type = type;
+		header.columnCount = buffer.columns.size();
+		header.recordCount = buffer.columns[ColumnUtc].size();
+		header.payloadSize = sizes.size() * sizeof(uint32_t)
+				+ sizeof(dictionarySize) + dictionarySize;
+		for (uint32_t size : sizes) {
+			header.payloadSize += size;
+		}
+		// Keep block headers 8 byte aligned in the mapping
+		std::size_t padding = (8 - header.payloadSize % 8) % 8;
+		header.payloadSize += padding;
+		header.firstUtcNs = buffer.firstUtcNs;
+		header.lastUtcNs = buffer.lastUtcNs;
+
+		write(&header, sizeof(header));
+		write(sizes.data(), sizes.size() * sizeof(uint32_t));
+		write(&dictionarySize, sizeof(dictionarySize));
+		for (const std::string& column : encoded) {
+			write(column.data(), column.size());
+		}
+		write(dictionary.data(), dictionary.size());
+		static const char zeros[8] = { 0 };
+		write(zeros, padding);
+
+		for (std::vector<int64_t>& column : buffer.columns) {
+			column.clear();
+		}
+		buffer.names.clear();
+		buffer.nameIds.clear();
+	}
+
+	/*
+	 * Writes to the file, keeping the first error for flush() to report.
+	 */
+	void write(const void* data, std::size_t size) {
+		if (size > 0 && std::fwrite(data, 1, size, file) != size
+				&& writeError == 0) {
+			writeError = errno != 0 ? errno : EIO;
+		}
+	}
+
+	void flush() {
+		for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+			writeBlock(static_cast<Nmea_SentenceType>(type));
+		}
+		if (std::fflush(file) != 0 && writeError == 0) {
+			writeError = errno != 0 ? errno : EIO;
+		}
+		if (writeError == 0 && std::ferror(file)) {
+			writeError = EIO;
+		}
+		if (writeError != 0) {
+			errno = writeError;
+			throw systemError("Cannot write archive " + path);
+		}
+	}
+
+	std::string path;
+	std::size_t blockRecords;
+	int writeError;
+	FILE* file;
+	TypeBuffer buffers[Nmea_SentenceType_Count];
+};
+
+NmeaArchiveWriter::NmeaArchiveWriter(const std::string& path,
+		std::size_t blockRecords) :
+		pimpl(new impl(path, blockRecords)) {
+}
+
+NmeaArchiveWriter::~NmeaArchiveWriter() {
+}
+
+void NmeaArchiveWriter::appendRMC(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity,
+		const boost::posix_time::time_duration& mtime, const double latitude,
+		const double longitude, const double speedknots,
+		const double coursetrue, const boost::gregorian::date& mdate,
+		const double magneticvar) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_RMC, utcNs, talkerid, validity,
+			ColumnFirstArgument + 9);
+	int64_t degrees = 0;
+	int64_t minutes = 0;
+	int c = ColumnFirstArgument;
+
+	columns[c++].push_back(
+			invalid(validity, 0) ? 0 : mtime.total_milliseconds());
+	if (!invalid(validity, 1)) {
+		quantizeCoordinate(latitude, degrees, minutes);
+	}
+	columns[c++].push_back(degrees);
+	columns[c++].push_back(minutes);
+	degrees = minutes = 0;
+	if (!invalid(validity, 2)) {
+		quantizeCoordinate(longitude, degrees, minutes);
+	}
+	columns[c++].push_back(degrees);
+	columns[c++].push_back(minutes);
+	columns[c++].push_back(invalid(validity, 3) ? 0 : quantize(speedknots, 2));
+	columns[c++].push_back(invalid(validity, 4) ? 0 : quantize(coursetrue, 2));
+	columns[c++].push_back(
+			invalid(validity, 5) ?
+					0 :
+					(mdate - boost::gregorian::date(1970, 1, 1)).days());
+	columns[c++].push_back(
+			invalid(validity, 6) ?
+					0 :
+					signedDecimal(magneticvar < 0,
+							quantize(std::abs(magneticvar), 1)));
+
+	pimpl->end(Nmea_SentenceType_RMC);
+}
+
+void NmeaArchiveWriter::appendXDR(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity,
+		const std::vector<TransducerMeasurement>& measurements) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_XDR, utcNs, talkerid, validity,
+			ColumnFirstArgument + 1 + measurements.size() * xdrSlotColumns);
+	columns[ColumnFirstArgument].push_back(measurements.size());
+
+	std::size_t c = ColumnFirstArgument + 1;
+	std::size_t idxVar = 0;
+	for (const TransducerMeasurement& tm : measurements) {
+		columns[c++].push_back(tm.transducerType);
+		columns[c++].push_back(
+				invalid(validity, idxVar + 1) ?
+						0 :
+						quantize(tm.measurementData,
+								xdrPrecision(tm.unitsOfMeasurement)));
+		columns[c++].push_back(tm.unitsOfMeasurement);
+		columns[c++].push_back(
+				pimpl->nameId(Nmea_SentenceType_XDR, tm.nameOfTransducer));
+		idxVar += xdrSlotColumns;
+	}
+
+	pimpl->end(Nmea_SentenceType_XDR);
+}
+
+void NmeaArchiveWriter::appendMWV(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double windAngle,
+		const Nmea_AngleReference reference, const double windSpeed,
+		const char windSpeedUnits, const char sensorStatus) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_MWV, utcNs, talkerid, validity,
+			ColumnFirstArgument + 5);
+	int c = ColumnFirstArgument;
+	columns[c++].push_back(invalid(validity, 0) ? 0 : quantize(windAngle, 1));
+	columns[c++].push_back(reference);
+	columns[c++].push_back(invalid(validity, 2) ? 0 : quantize(windSpeed, 1));
+	columns[c++].push_back(windSpeedUnits);
+	columns[c++].push_back(sensorStatus);
+	pimpl->end(Nmea_SentenceType_MWV);
+}
+
+void NmeaArchiveWriter::appendMWD(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double trueWindDirection,
+		const double magneticWindDirection, const double windSpeedKnots,
+		const double windSpeedMeters) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_MWD, utcNs, talkerid, validity,
+			ColumnFirstArgument + 4);
+	int c = ColumnFirstArgument;
+	columns[c++].push_back(
+			invalid(validity, 0) ? 0 : quantize(trueWindDirection, 1));
+	columns[c++].push_back(
+			invalid(validity, 1) ? 0 : quantize(magneticWindDirection, 1));
+	columns[c++].push_back(
+			invalid(validity, 2) ? 0 : quantize(windSpeedKnots, 1));
+	columns[c++].push_back(
+			invalid(validity, 3) ? 0 : quantize(windSpeedMeters, 1));
+	pimpl->end(Nmea_SentenceType_MWD);
+}
+
+void NmeaArchiveWriter::appendHDT(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double headingDegreesTrue) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_HDT, utcNs, talkerid, validity,
+			ColumnFirstArgument + 1);
+	columns[ColumnFirstArgument].push_back(
+			invalid(validity, 0) ? 0 : quantize(headingDegreesTrue, 2));
+	pimpl->end(Nmea_SentenceType_HDT);
+}
+
+void NmeaArchiveWriter::appendVLW(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double totalCumulativeDistance,
+		const double distanceSinceReset) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_VLW, utcNs, talkerid, validity,
+			ColumnFirstArgument + 2);
+	int c = ColumnFirstArgument;
+	columns[c++].push_back(
+			invalid(validity, 0) ? 0 : quantize(totalCumulativeDistance, 2));
+	columns[c++].push_back(
+			invalid(validity, 1) ? 0 : quantize(distanceSinceReset, 2));
+	pimpl->end(Nmea_SentenceType_VLW);
+}
+
+void NmeaArchiveWriter::appendVHW(int64_t utcNs, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double headingTrue,
+		const double headingMagnetic, const double speedInKnots,
+		const double speedInKmH) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_VHW, utcNs, talkerid, validity,
+			ColumnFirstArgument + 4);
+	int c = ColumnFirstArgument;
+	columns[c++].push_back(invalid(validity, 0) ? 0 : quantize(headingTrue, 1));
+	columns[c++].push_back(
+			invalid(validity, 1) ? 0 : quantize(headingMagnetic, 1));
+	columns[c++].push_back(invalid(validity, 2) ? 0 : quantize(speedInKnots, 1));
+	columns[c++].push_back(invalid(validity, 3) ? 0 : quantize(speedInKmH, 1));
+	pimpl->end(Nmea_SentenceType_VHW);
+}
+
+void NmeaArchiveWriter::appendPRDID(int64_t utcNs,
+		const NmeaComposerValid& validity, const double pitch,
+		const double roll, const double heading) {
+	std::vector<std::vector<int64_t> >& columns = pimpl->begin(
+			Nmea_SentenceType_PRDID, utcNs, std::string(), validity,
+			ColumnFirstArgument + 3);
+	int c = ColumnFirstArgument;
+	columns[c++].push_back(invalid(validity, 0) ? 0 : quantize(pitch, 2));
+	columns[c++].push_back(invalid(validity, 1) ? 0 : quantize(roll, 2));
+	columns[c++].push_back(invalid(validity, 2) ? 0 : quantize(heading, 2));
+	pimpl->end(Nmea_SentenceType_PRDID);
+}
+
+void NmeaArchiveWriter::flush() {
+	pimpl->flush();
+}
+
+class NmeaArchiveReader::impl {
+public:
+	struct Block {
+		const BlockHeader* header;
+		const unsigned char* payload;
+	};
+
+	struct Cursor {
+		Nmea_SentenceType type;
+		std::size_t block;
+		std::size_t row;
+		std::size_t rows;
+		std::vector<std::vector<int64_t> > columns;
+		std::vector<std::string> names;
+		std::vector<std::size_t> slots; // XDR measurements consumed per slot
+	};
+
+	explicit impl(const std::string& path) :
+			mapping(NULL), mappingSize(0) {
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw systemError("Cannot open archive " + path);
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+			close(fd);
+			throw std::runtime_error("Not an NMEA archive: " + path);
+		}
+		void* address = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		int error = errno;
+		close(fd);
+		if (address == MAP_FAILED) {
+			errno = error;
+			throw systemError("Cannot map archive " + path);
+		}
+		mapping = static_cast<const unsigned char*>(address);
+		mappingSize = st.st_size;
+
+		const FileHeader* header = reinterpret_cast<const FileHeader*>(mapping);
+		if (std::memcmp(header->magic, fileMagic, sizeof(fileMagic)) != 0
+				|| header->version != fileVersion) {
+			munmap(address, mappingSize);
+			throw std::runtime_error("Not an NMEA archive: " + path);
+		}
+
+		// Only the block headers are read here, a truncated tail is ignored
+		std::size_t offset = sizeof(FileHeader);
+		while (offset + sizeof(BlockHeader) <= mappingSize) {
+			const BlockHeader* block =
+					reinterpret_cast<const BlockHeader*>(mapping + offset);
+			std::size_t end = offset + sizeof(BlockHeader) + block->payloadSize;
+			if (std::memcmp(block->magic, blockMagic, sizeof(blockMagic)) != 0
+					|| block->type >= Nmea_SentenceType_Count
+					|| end > mappingSize) {
+				break;
+			}
+			Block entry = { block, mapping + offset + sizeof(BlockHeader) };
+			blocks[block->type].push_back(entry);
+			offset = end;
+		}
+	}
+
+	~impl() {
+		munmap(const_cast<unsigned char*>(mapping), mappingSize);
+	}
+
+	void decode(const Block& block, Cursor& cursor) {
+		const BlockHeader* header = block.header;
+		const unsigned char* sizes = block.payload;
+		const unsigned char* p = sizes
+				+ header->columnCount * sizeof(uint32_t) + sizeof(uint32_t);
+
+		cursor.columns.resize(header->columnCount);
+		for (std::size_t c = 0; c < header->columnCount; ++c) {
+			uint32_t size;
+			std::memcpy(&size, sizes + c * sizeof(uint32_t), sizeof(size));
+			const unsigned char* end = p + size;
+			std::vector<int64_t>& column = cursor.columns[c];
+			column.clear();
+			uint64_t previous = 0;
+			uint64_t delta = 0;
+			while (p < end) {
+				uint64_t zigzag = getVarint(p, end);
+				delta += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+				previous += delta;
+				column.push_back(static_cast<int64_t>(previous));
+			}
+		}
+
+		uint32_t dictionarySize;
+		std::memcpy(&dictionarySize,
+				sizes + header->columnCount * sizeof(uint32_t),
+				sizeof(dictionarySize));
+		const unsigned char* end = p + dictionarySize;
+		cursor.names.resize(getVarint(p, end));
+		for (std::string& name : cursor.names) {
+			std::size_t length = std::min<std::size_t>(getVarint(p, end),
+					end - p);
+			name.assign(reinterpret_cast<const char*>(p), length);
+			p += length;
+		}
+
+		cursor.row = 0;
+		cursor.rows = header->recordCount;
+		cursor.slots.assign(cursor.columns.size(), 0);
+	}
+
+	/*
+	 * Moves the cursor to its next record inside [from, to).
+	 */
+	bool position(Cursor& cursor, int64_t fromUtcNs, int64_t toUtcNs) {
+		const std::vector<Block>& typeBlocks = blocks[cursor.type];
+		for (;;) {
+			if (cursor.row < cursor.rows) {
+				int64_t utcNs = cursor.columns[ColumnUtc][cursor.row];
+				if (utcNs >= fromUtcNs && utcNs < toUtcNs) {
+					return true;
+				}
+				consume(cursor);
+				continue;
+			}
+			while (cursor.block < typeBlocks.size()
+					&& (typeBlocks[cursor.block].header->lastUtcNs < fromUtcNs
+							|| typeBlocks[cursor.block].header->firstUtcNs
+									>= toUtcNs)) {
+				++cursor.block;
+			}
+			if (cursor.block == typeBlocks.size()) {
+				return false;
+			}
+			decode(typeBlocks[cursor.block++], cursor);
+		}
+	}
+
+	void consume(Cursor& cursor) {
+		if (cursor.type == Nmea_SentenceType_XDR) {
+			std::size_t count = cursor.columns[ColumnFirstArgument][cursor.row];
+			for (std::size_t slot = 0; slot < count; ++slot) {
+				++cursor.slots[slot];
+			}
+		}
+		++cursor.row;
+	}
+
+	int64_t value(const Cursor& cursor, std::size_t column) const {
+		return cursor.columns[column][cursor.row];
+	}
+
+	void compose(Cursor& cursor, std::string& nmea) {
+		std::string talkerid = decodeTalker(value(cursor, ColumnTalker));
+		NmeaComposerValid validity(
+				static_cast<unsigned long>(value(cursor, ColumnValidity)));
+		const std::size_t a = ColumnFirstArgument;
+
+		switch (cursor.type) {
+		case Nmea_SentenceType_RMC:
+			NmeaComposer::composeRMC(nmea, talkerid, validity,
+					boost::posix_time::milliseconds(value(cursor, a)),
+					dequantizeCoordinate(value(cursor, a + 1),
+							value(cursor, a + 2)),
+					dequantizeCoordinate(value(cursor, a + 3),
+							value(cursor, a + 4)),
+					dequantize(value(cursor, a + 5), 2),
+					dequantize(value(cursor, a + 6), 2),
+					boost::gregorian::date(1970, 1, 1)
+							+ boost::gregorian::days(value(cursor, a + 7)),
+					dequantize(value(cursor, a + 8), 1));
+			break;
+		case Nmea_SentenceType_XDR: {
+			std::size_t count = value(cursor, a);
+			measurements.resize(count);
+			for (std::size_t slot = 0; slot < count; ++slot) {
+				const std::size_t c = a + 1 + slot * xdrSlotColumns;
+				const std::size_t row = cursor.slots[slot];
+				TransducerMeasurement& tm = measurements[slot];
+				tm.transducerType = static_cast<char>(cursor.columns[c][row]);
+				tm.unitsOfMeasurement = static_cast<char>(cursor.columns[c + 2][row]);
+				tm.measurementData = dequantize(cursor.columns[c + 1][row],
+						xdrPrecision(tm.unitsOfMeasurement));
+				tm.nameOfTransducer = cursor.names[cursor.columns[c + 3][row]];
+			}
+			NmeaComposer::composeXDR(nmea, talkerid, validity, measurements);
+			break;
+		}
+		case Nmea_SentenceType_MWV:
+			NmeaComposer::composeMWV(nmea, talkerid, validity,
+					dequantize(value(cursor, a), 1),
+					static_cast<Nmea_AngleReference>(value(cursor, a + 1)),
+					dequantize(value(cursor, a + 2), 1),
+					static_cast<char>(value(cursor, a + 3)),
+					static_cast<char>(value(cursor, a + 4)));
+			break;
+		case Nmea_SentenceType_MWD:
+			NmeaComposer::composeMWD(nmea, talkerid, validity,
+					dequantize(value(cursor, a), 1),
+					dequantize(value(cursor, a + 1), 1),
+					dequantize(value(cursor, a + 2), 1),
+					dequantize(value(cursor, a + 3), 1));
+			break;
+		case Nmea_SentenceType_HDT:
+			NmeaComposer::composeHDT(nmea, talkerid, validity,
+					dequantize(value(cursor, a), 2));
+			break;
+		case Nmea_SentenceType_VLW:
+			NmeaComposer::composeVLW(nmea, talkerid, validity,
+					dequantize(value(cursor, a), 2),
+					dequantize(value(cursor, a + 1), 2));
+			break;
+		case Nmea_SentenceType_VHW:
+			NmeaComposer::composeVHW(nmea, talkerid, validity,
+					dequantize(value(cursor, a), 1),
+					dequantize(value(cursor, a + 1), 1),
+					dequantize(value(cursor, a + 2), 1),
+					dequantize(value(cursor, a + 3), 1));
+			break;
+		case Nmea_SentenceType_PRDID:
+			NmeaComposer::composePRDID(nmea, validity,
+					dequantize(value(cursor, a), 2),
+					dequantize(value(cursor, a + 1), 2),
+					dequantize(value(cursor, a + 2), 2));
+			break;
+		default:
+			break;
+		}
+	}
+
+	std::size_t regenerate(const std::vector<Nmea_SentenceType>& types,
+			int64_t fromUtcNs, int64_t toUtcNs, NmeaSink& sink) {
+		std::vector<Cursor> cursors(types.size());
+		std::vector<Cursor*> active;
+		for (std::size_t i = 0; i < types.size(); ++i) {
+			cursors[i].type = types[i];
+			cursors[i].block = 0;
+			cursors[i].row = cursors[i].rows = 0;
+			if (position(cursors[i], fromUtcNs, toUtcNs)) {
+				active.push_back(&cursors[i]);
+			}
+		}
+
+		std::size_t regenerated = 0;
+		while (!active.empty()) {
+			std::size_t earliest = 0;
+			for (std::size_t i = 1; i < active.size(); ++i) {
+				if (value(*active[i], ColumnUtc)
+						< value(*active[earliest], ColumnUtc)) {
+					earliest = i;
+				}
+			}
+			Cursor& cursor = *active[earliest];
+			compose(cursor, nmea);
+			sink.write(nmea.data(), nmea.size());
+			++regenerated;
+
+			consume(cursor);
+			if (!position(cursor, fromUtcNs, toUtcNs)) {
+				active.erase(active.begin() + earliest);
+			}
+		}
+		return regenerated;
+	}
+
+	const unsigned char* mapping;
+	std::size_t mappingSize;
+	std::vector<Block> blocks[Nmea_SentenceType_Count];
+
+	std::string nmea;
+	std::vector<TransducerMeasurement> measurements;
+};
+
+NmeaArchiveReader::NmeaArchiveReader(const std::string& path) :
+		pimpl(new impl(path)) {
+}
+
+NmeaArchiveReader::~NmeaArchiveReader() {
+}
+
+std::size_t NmeaArchiveReader::size(Nmea_SentenceType type) const {
+	std::size_t records = 0;
+	if (type < Nmea_SentenceType_Count) {
+		for (const impl::Block& block : pimpl->blocks[type]) {
+			records += block.header->recordCount;
+		}
+	}
+	return records;
+}
+
+std::size_t NmeaArchiveReader::regenerate(Nmea_SentenceType type,
+		int64_t fromUtcNs, int64_t toUtcNs, NmeaSink& sink) {
+	if (type >= Nmea_SentenceType_Count) {
+		return 0;
+	}
+	return pimpl->regenerate(std::vector<Nmea_SentenceType>(1, type),
+			fromUtcNs, toUtcNs, sink);
+}
+
+std::size_t NmeaArchiveReader::regenerate(int64_t fromUtcNs, int64_t toUtcNs,
+		NmeaSink& sink) {
+	std::vector<Nmea_SentenceType> types;
+	for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+		types.push_back(static_cast<Nmea_SentenceType>(type));
+	}
+	return pimpl->regenerate(types, fromUtcNs, toUtcNs, sink);
+}
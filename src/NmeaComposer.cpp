@@ -6,590 +6,475 @@
  */
 
 #include "NmeaComposer.h"
+#include "NmeaLog.h"
+#include "NmeaStatistics.h"
 
-#include <iomanip>
-#include <boost/format.hpp>
-#include <boost/format/group.hpp>
-#include <boost/log/trivial.hpp>
+#include <algorithm>
+#include <cstring>
 
 /// @cond
 #ifdef NP_DEBUG
-#define LOG_MESSAGE(lvl) BOOST_LOG_TRIVIAL(lvl)
+#define LOG_FIELDS(type, sentence, length) logFields(type, sentence, length)
+#define LOG_SENTENCE(type, text, length) NmeaLog::sentence(type, text, length)
 #else
-#define LOG_MESSAGE(lvl) if (false) BOOST_LOG_TRIVIAL(lvl)
+#define LOG_FIELDS(type, sentence, length) \
+	do { (void) (type); (void) (sentence); (void) (length); } while (false)
+#define LOG_SENTENCE(type, text, length) \
+	do { (void) (type); (void) (text); (void) (length); } while (false)
 #endif
-/// @endcond
 
-NmeaComposer::NmeaComposer() {
+namespace {
 
-}
-
-int16_t NmeaComposer::calculateNmeaChecksum(const std::string& nmeaStr) {
-	int16_t checksum = 0;
-	for (uint i = 1; i < nmeaStr.length() - 1; ++i) {
-		checksum ^= nmeaStr[i];
+/*
+ * Number of validity bits set among the first fieldCount fields.
+ */
+std::size_t invalidFields(const NmeaComposerValid& validity,
+		std::size_t fieldCount) {
+	if (fieldCount >= validity.size()) {
+		return validity.count();
 	}
-	return checksum;
+	return (validity & NmeaComposerValid((1UL << fieldCount) - 1)).count();
 }
 
-void NmeaComposer::composeNmea(std::string& nmea,
-		std::vector<std::string>& fields) {
-	nmea.append("$");
-
-	for (uint i = 0; i < fields.size(); ++i) {
-		nmea.append(fields[i]);
-		if (i < fields.size() - 1) {
-			nmea.append(",");
-		} else {
-			nmea.append("*");
-		}
-		LOG_MESSAGE(debug)<< fields[i];
-	}
-	int16_t checksum = calculateNmeaChecksum(nmea);
-
-	boost::format auxfmt("%02X");
-	nmea.append(boost::str(auxfmt % checksum));
+/*
+ * The core leaves the address field out of such a sentence.
+ */
+bool badTalker(const char* talkerid) {
+	return std::strlen(talkerid) != 2;
 }
 
-void NmeaComposer::composeRMC(std::string& nmea, const std::string& talkerid,
-		const NmeaComposerValid& validity,
-		const boost::posix_time::time_duration& mtime, const double latitude,
-		const double longitude, const double speedknots,
-		const double coursetrue, const boost::gregorian::date& mdate,
-		const double magneticvar) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("RMC");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
-
-	/*------------ Field 01 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%02i%02i%02i.%03i");
-
-		fields.push_back(
-				boost::str(
-						auxfmt % mtime.hours() % mtime.minutes()
-								% mtime.seconds()
-								% (mtime.fractional_seconds() / 1000)));
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
-
-	/*------------ Field 02 ---------------*/
-	fields.push_back("A");
-
-	/*------------ Field 03,04 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%02i%010.7f");
-
-		double abslatitude = std::abs(latitude);
-		double degrees;
-		double minutes;
-		minutes = std::modf(abslatitude, &degrees) * 60.0f;
-
-		fields.push_back(boost::str(auxfmt % degrees % minutes));
-
-		if (latitude < 0) {
-			fields.push_back("S");
-		} else {
-			fields.push_back("N");
-		}
-	} else {
-		fields.push_back("");
-		fields.push_back("");
-	}
-	++idxVar;
-
-	/*------------ Field 05,06 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%03i%010.7f");
-
-		double abslongitude = std::abs(longitude);
-		double degrees;
-		double minutes;
-		minutes = std::modf(abslongitude, &degrees) * 60.0f;
-
-		fields.push_back(boost::str(auxfmt % degrees % minutes));
+bool badTalker(const std::string& talkerid) {
+	return talkerid.length() != 2;
+}
 
-		if (longitude < 0) {
-			fields.push_back("W");
-		} else {
-			fields.push_back("E");
+#ifdef NP_DEBUG
+/*
+ * Logs the fields of a composed sentence, the address being field 0.
+ */
+void logFields(Nmea_SentenceType type, const char* sentence,
+		std::size_t length) {
+	std::size_t end = length;
+	if (length >= 3 && sentence[length - 3] == '*') {
+		end = length - 3;
+	}
+	std::size_t index = 0;
+	std::size_t start = 1;
+	for (std::size_t i = start; i <= end; ++i) {
+		if (i == end || sentence[i] == ',') {
+			NmeaLog::field(type, index++, sentence + start, i - start);
+			start = i + 1;
 		}
-	} else {
-		fields.push_back("");
-		fields.push_back("");
 	}
-	++idxVar;
-
-	/*------------ Field 07 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.2f");
+}
+#endif
 
-		fields.push_back(boost::str(auxfmt % speedknots));
+/*
+ * Statistics and logging around one call to NmeaComposerCore, which fires
+ * the probes itself.
+ */
+class ComposeScope {
+public:
+	explicit ComposeScope(Nmea_SentenceType type) :
+			type(type) {
+		sampleStartNs = NmeaStatistics::startSample(type);
 	}
-	++idxVar;
-
-	/*------------ Field 08 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.2f");
 
-		fields.push_back(boost::str(auxfmt % coursetrue));
+	std::size_t finish(const char* buffer, std::size_t size,
+			std::size_t length, std::size_t invalidFields, bool error) {
+		return record(buffer, length,
+				size != 0 ? std::min(length, size - 1) : 0, invalidFields,
+				error);
 	}
-	++idxVar;
 
-	/*------------ Field 09 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%02i%02i%02i");
-
-		fields.push_back(
-				boost::str(
-						auxfmt % mdate.day() % static_cast<int>(mdate.month())
-								% (mdate.year() % 100)));
+	std::size_t finish(NmeaStringStorage& nmea, std::size_t invalidFields,
+			bool error) {
+		return record(nmea.data(), nmea.size(), nmea.size(), invalidFields,
+				error);
 	}
-	++idxVar;
-
-	/*------------ Field 10,11 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.1f");
 
-		double absmagneticvar = std::abs(magneticvar);
-
-		fields.push_back(boost::str(auxfmt % absmagneticvar));
-
-		if (magneticvar < 0) {
-			fields.push_back("W");
-		} else {
-			fields.push_back("E");
-		}
+private:
+	/*
+	 * Records the sentence of which stored characters are in the buffer.
+	 */
+	std::size_t record(const char* sentence, std::size_t length,
+			std::size_t stored, std::size_t invalidFields, bool error) {
+		LOG_FIELDS(type, sentence, stored);
+		LOG_SENTENCE(type, sentence, stored);
+		NmeaStatistics::record(type, length, invalidFields, error,
+				sampleStartNs);
+		return length;
 	}
 
-	/*------------ Field 12 ---------------*/
-	fields.push_back("A");
+	Nmea_SentenceType type;
+	int64_t sampleStartNs;
+};
 
-	composeNmea(nmea, fields);
+/*
+ * Composes on the stack and copies the sentence into nmea, which keeps its
+ * storage when large enough. Only a sentence that does not fit is composed
+ * again, straight into nmea.
+ */
+template<typename Compose>
+void composeString(NmeaStringStorage& nmea, Compose compose) {
+	char buffer[128];
+	std::size_t length = compose(buffer, sizeof(buffer));
+	if (length < sizeof(buffer)) {
+		nmea.assign(buffer, length);
+		return;
+	}
+	nmea.resize(length + 1);
+	compose(nmea.data(), nmea.size());
+	nmea.resize(length);
+}
 
-	LOG_MESSAGE(debug)<< nmea;
+std::chrono::microseconds utcTime(
+		const boost::posix_time::time_duration& mtime) {
+	return std::chrono::microseconds(mtime.total_microseconds());
 }
 
-void NmeaComposer::composeXDR(std::string& nmea, const std::string& talkerid,
-		const NmeaComposerValid& validity,
-		const std::vector<TransducerMeasurement>& measurements) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("XDR");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
+NmeaDate utcDate(const boost::gregorian::date& mdate) {
+	NmeaDate date = { static_cast<int>(mdate.year()),
+			static_cast<int>(mdate.month()), static_cast<int>(mdate.day()) };
+	return date;
+}
 
-	for (auto& tm : measurements) {
-		/*------------ Field 01 ---------------*/
-		if (!validity[idxVar]) {
-			fields.emplace_back(&tm.transducerType, 1);
-		} else {
-			fields.push_back("");
-		}
-		++idxVar;
-
-		/*------------ Field 02 ---------------*/
-		if (!validity[idxVar]) {
-			boost::format auxfmt;
-			if (tm.unitsOfMeasurement == 'C') {
-				auxfmt = boost::format("%+06.1f");
-			} else if (tm.unitsOfMeasurement == 'B') {
-				auxfmt = boost::format("%6.4f");
-			} else if (tm.unitsOfMeasurement == 'P') {
-				auxfmt = boost::format("%05.1f");
+/*
+ * Views measurements as NmeaTransducer, on the stack unless there are many,
+ * then from the allocator of scratch when given.
+ */
+class Transducers {
+public:
+	explicit Transducers(
+			const std::vector<TransducerMeasurement>& measurements,
+			NmeaStringStorage* scratch = NULL) :
+			count(measurements.size()), data(local), scratch(NULL) {
+		if (count > sizeof(local) / sizeof(local[0])) {
+			if (scratch != NULL) {
+				data = static_cast<NmeaTransducer*>(scratch->allocate(
+						count * sizeof(NmeaTransducer)));
+				this->scratch = scratch;
 			} else {
-				auxfmt = boost::format("%.1f");
+				heap.resize(count);
+				data = heap.data();
 			}
-
-			fields.push_back(boost::str(auxfmt % tm.measurementData));
-		} else {
-			fields.push_back("");
 		}
-		++idxVar;
-
-		/*------------ Field 03 ---------------*/
-		if (!validity[idxVar]) {
-			fields.emplace_back(&tm.unitsOfMeasurement, 1);
-		} else {
-			fields.push_back("");
-		}
-		++idxVar;
-
-		/*------------ Field 04 ---------------*/
-		if (!validity[idxVar]) {
-			fields.push_back(tm.nameOfTransducer);
-		} else {
-			fields.push_back("");
+		for (std::size_t i = 0; i < count; ++i) {
+			const TransducerMeasurement& tm = measurements[i];
+			NmeaTransducer transducer = { tm.transducerType,
+					tm.measurementData, tm.unitsOfMeasurement,
+					tm.nameOfTransducer.c_str() };
+			data[i] = transducer;
 		}
-		++idxVar;
 	}
 
-	composeNmea(nmea, fields);
-
-	LOG_MESSAGE(debug)<< nmea;
-}
-
-void NmeaComposer::composeMWV(std::string& nmea, const std::string& talkerid,
-		const NmeaComposerValid& validity, const double windAngle,
-		const Nmea_AngleReference reference, const double windSpeed,
-		const char windSpeedUnits, const char sensorStatus) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("MWV");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
-
-	/*------------ Field 01 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
-
-		fields.push_back(boost::str(auxfmt % windAngle));
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
-
-	/*------------ Field 02 ---------------*/
-	if (!validity[idxVar]) {
-		if (reference == Nmea_AngleReference_True) {
-			fields.push_back("T");
-		} else {
-			fields.push_back("R");
+	~Transducers() {
+		if (scratch != NULL) {
+			scratch->deallocate(data, count * sizeof(NmeaTransducer));
 		}
-	} else {
-		fields.push_back("");
 	}
-	++idxVar;
 
-	/*------------ Field 03 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
+	std::size_t count;
+	NmeaTransducer* data;
 
-		fields.push_back(boost::str(auxfmt % windSpeed));
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
+private:
+	Transducers(const Transducers&) = delete;
+	Transducers& operator=(const Transducers&) = delete;
 
-	/*------------ Field 03 ---------------*/
-	if (!validity[idxVar]) {
-		fields.emplace_back(&windSpeedUnits, 1);
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
+	NmeaTransducer local[16];
+	std::vector<NmeaTransducer> heap;
+	NmeaStringStorage* scratch;
+};
 
-	/*------------ Field 04 ---------------*/
-	if (!validity[idxVar]) {
-		fields.emplace_back(&sensorStatus, 1);
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
+} // namespace
+/// @endcond
 
-	composeNmea(nmea, fields);
+NmeaComposer::NmeaComposer() {
 
-	LOG_MESSAGE(debug)<< nmea;
 }
 
-void NmeaComposer::composeMWD(std::string& nmea, const std::string& talkerid,
-		const NmeaComposerValid& validity, const double trueWindDirection,
-		const double magneticWindDirection, const double windSpeedKnots,
-		const double windSpeedMeters) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("MWD");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
-
-	/*------------ Field 01 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
-
-		fields.push_back(boost::str(auxfmt % trueWindDirection));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("T");
-	++idxVar;
-
-	/*------------ Field 02 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
-
-		fields.push_back(boost::str(auxfmt % magneticWindDirection));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("M");
-	++idxVar;
-
-	/*------------ Field 03 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
-
-		fields.push_back(boost::str(auxfmt % windSpeedKnots));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("N");
-	++idxVar;
+void NmeaComposer::composeRMC(NmeaStringStorage& nmea,
+		const char* talkerid,
+		const NmeaComposerValid& validity,
+		const boost::posix_time::time_duration& mtime, const double latitude,
+		const double longitude, const double speedknots,
+		const double coursetrue, const boost::gregorian::date& mdate,
+		const double magneticvar, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_RMC);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeRMC(buffer, size, talkerid,
+				validity, utcTime(mtime), latitude, longitude, speedknots,
+				coursetrue, utcDate(mdate), magneticvar, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 7), badTalker(talkerid));
+}
 
-	/*------------ Field 04 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
+std::size_t NmeaComposer::composeRMC(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const boost::posix_time::time_duration& mtime, const double latitude,
+		const double longitude, const double speedknots,
+		const double coursetrue, const boost::gregorian::date& mdate,
+		const double magneticvar, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_RMC);
+	std::size_t length = NmeaComposerCore::composeRMC(buffer, size,
+			talkerid.c_str(), validity, utcTime(mtime), latitude, longitude,
+			speedknots, coursetrue, utcDate(mdate), magneticvar, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 7),
+			badTalker(talkerid));
+}
 
-		fields.push_back(boost::str(auxfmt % windSpeedMeters));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("M");
-	++idxVar;
+void NmeaComposer::composeXDR(NmeaStringStorage& nmea,
+		const char* talkerid,
+		const NmeaComposerValid& validity,
+		const std::vector<TransducerMeasurement>& measurements,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_XDR);
+	Transducers transducers(measurements, &nmea);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeXDR(buffer, size, talkerid,
+				validity, transducers.data, transducers.count, json);
+	});
+	scope.finish(nmea, invalidFields(validity, measurements.size() * 4),
+			badTalker(talkerid));
+}
 
-	composeNmea(nmea, fields);
+std::size_t NmeaComposer::composeXDR(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const std::vector<TransducerMeasurement>& measurements,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_XDR);
+	Transducers transducers(measurements);
+	std::size_t length = NmeaComposerCore::composeXDR(buffer, size,
+			talkerid.c_str(), validity, transducers.data, transducers.count,
+			json);
+	return scope.finish(buffer, size, length,
+			invalidFields(validity, measurements.size() * 4), badTalker(talkerid));
+}
 
-	LOG_MESSAGE(debug)<< nmea;
+void NmeaComposer::composeMWV(NmeaStringStorage& nmea,
+		const char* talkerid,
+		const NmeaComposerValid& validity, const double windAngle,
+		const Nmea_AngleReference reference, const double windSpeed,
+		const char windSpeedUnits, const char sensorStatus,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_MWV);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeMWV(buffer, size, talkerid,
+				validity, windAngle, reference, windSpeed, windSpeedUnits,
+				sensorStatus, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 5), badTalker(talkerid));
 }
 
-void NmeaComposer::composeHDT(std::string& nmea, const std::string& talkerid,
-		const NmeaComposerValid& validity, const double headingDegreesTrue) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("HDT");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
+std::size_t NmeaComposer::composeMWV(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const double windAngle, const Nmea_AngleReference reference,
+		const double windSpeed, const char windSpeedUnits,
+		const char sensorStatus, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_MWV);
+	std::size_t length = NmeaComposerCore::composeMWV(buffer, size,
+			talkerid.c_str(), validity, windAngle, reference, windSpeed,
+			windSpeedUnits, sensorStatus, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 5),
+			badTalker(talkerid));
+}
 
-	/*------------ Field 01 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%06.2f");
+void NmeaComposer::composeMWD(NmeaStringStorage& nmea,
+		const char* talkerid,
+		const NmeaComposerValid& validity, const double trueWindDirection,
+		const double magneticWindDirection, const double windSpeedKnots,
+		const double windSpeedMeters, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_MWD);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeMWD(buffer, size, talkerid,
+				validity, trueWindDirection, magneticWindDirection,
+				windSpeedKnots, windSpeedMeters, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 4), badTalker(talkerid));
+}
 
-		fields.push_back(boost::str(auxfmt % headingDegreesTrue));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("T");
-	++idxVar;
+std::size_t NmeaComposer::composeMWD(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const double trueWindDirection, const double magneticWindDirection,
+		const double windSpeedKnots, const double windSpeedMeters,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_MWD);
+	std::size_t length = NmeaComposerCore::composeMWD(buffer, size,
+			talkerid.c_str(), validity, trueWindDirection,
+			magneticWindDirection, windSpeedKnots, windSpeedMeters, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 4),
+			badTalker(talkerid));
+}
 
-	composeNmea(nmea, fields);
+void NmeaComposer::composeHDT(NmeaStringStorage& nmea,
+		const char* talkerid,
+		const NmeaComposerValid& validity, const double headingDegreesTrue,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_HDT);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeHDT(buffer, size, talkerid,
+				validity, headingDegreesTrue, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 1), badTalker(talkerid));
+}
 
-	LOG_MESSAGE(debug)<< nmea;
+std::size_t NmeaComposer::composeHDT(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const double headingDegreesTrue, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_HDT);
+	std::size_t length = NmeaComposerCore::composeHDT(buffer, size,
+			talkerid.c_str(), validity, headingDegreesTrue, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 1),
+			badTalker(talkerid));
 }
 
-void NmeaComposer::composeVLW(std::string& nmea, const std::string& talkerid,
+void NmeaComposer::composeVLW(NmeaStringStorage& nmea,
+		const char* talkerid,
 		const NmeaComposerValid& validity, const double totalCumulativeDistance,
-		const double distanceSinceReset) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("VLW");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
-
-	/*------------ Field 01,02 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.2f");
-
-		fields.push_back(boost::str(auxfmt % totalCumulativeDistance));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("N");
-	++idxVar;
-
-	/*------------ Field 03,04 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.2f");
-
-		fields.push_back(boost::str(auxfmt % distanceSinceReset));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("N");
-	++idxVar;
-
-	composeNmea(nmea, fields);
+		const double distanceSinceReset, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_VLW);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeVLW(buffer, size, talkerid,
+				validity, totalCumulativeDistance, distanceSinceReset, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 2), badTalker(talkerid));
+}
 
-	LOG_MESSAGE(debug)<< nmea;
+std::size_t NmeaComposer::composeVLW(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const double totalCumulativeDistance, const double distanceSinceReset,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_VLW);
+	std::size_t length = NmeaComposerCore::composeVLW(buffer, size,
+			talkerid.c_str(), validity, totalCumulativeDistance,
+			distanceSinceReset, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 2),
+			badTalker(talkerid));
 }
 
-void NmeaComposer::composeVHW(std::string& nmea, const std::string& talkerid,
+void NmeaComposer::composeVHW(NmeaStringStorage& nmea,
+		const char* talkerid,
 		const NmeaComposerValid& validity, const double headingTrue,
 		const double headingMagnetic, const double speedInKnots,
-		const double speedInKmH) {
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	if (talkerid.length() == 2) {
-		std::string nmeahead;
-		nmeahead.reserve(8);
-		nmeahead.append(talkerid);
-		nmeahead.append("VHW");
-		fields.push_back(nmeahead);
-	} else {
-		// Error
-	}
-
-	/*------------ Field 01,02 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
-
-		fields.push_back(boost::str(auxfmt % headingTrue));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("T");
-	++idxVar;
-
-	/*------------ Field 03,04 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%05.1f");
-
-		fields.push_back(boost::str(auxfmt % headingMagnetic));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("M");
-	++idxVar;
-
-	/*------------ Field 05,06 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.1f");
-
-		fields.push_back(boost::str(auxfmt % speedInKnots));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("N");
-	++idxVar;
-
-	/*------------ Field 07,08 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%.1f");
-
-		fields.push_back(boost::str(auxfmt % speedInKmH));
-	} else {
-		fields.push_back("");
-	}
-	fields.push_back("K");
-	++idxVar;
+		const double speedInKmH, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_VHW);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeVHW(buffer, size, talkerid,
+				validity, headingTrue, headingMagnetic, speedInKnots,
+				speedInKmH, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 4), badTalker(talkerid));
+}
 
-	composeNmea(nmea, fields);
+std::size_t NmeaComposer::composeVHW(char* buffer, std::size_t size,
+		const std::string& talkerid, const NmeaComposerValid& validity,
+		const double headingTrue, const double headingMagnetic,
+		const double speedInKnots, const double speedInKmH,
+		NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_VHW);
+	std::size_t length = NmeaComposerCore::composeVHW(buffer, size,
+			talkerid.c_str(), validity, headingTrue, headingMagnetic,
+			speedInKnots, speedInKmH, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 4),
+			badTalker(talkerid));
+}
 
-	LOG_MESSAGE(debug)<< nmea;
+void NmeaComposer::composePRDID(NmeaStringStorage& nmea,
+		const NmeaComposerValid& validity, const double pitch,
+		const double roll, const double heading, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_PRDID);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composePRDID(buffer, size, validity, pitch,
+				roll, heading, json);
+	});
+	scope.finish(nmea, invalidFields(validity, 3), false);
 }
 
-void NmeaComposer::composePRDID(std::string& nmea,
+std::size_t NmeaComposer::composePRDID(char* buffer, std::size_t size,
 		const NmeaComposerValid& validity, const double pitch,
-		const double roll, const double heading) {
-
-	int idxVar = 0;
-	std::vector<std::string> fields;
-	nmea = "";
-	nmea.reserve(128);
-
-	/*------------ Field 00 ---------------*/
-	std::string nmeahead;
-	nmeahead.reserve(8);
-	nmeahead.append("PRDID");
-	fields.push_back(nmeahead);
-
-	/*------------ Field 01 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%+06.2f");
-
-		fields.push_back(boost::str(auxfmt % pitch));
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
+		const double roll, const double heading, NmeaJsonDelta* json) {
+	ComposeScope scope(Nmea_SentenceType_PRDID);
+	std::size_t length = NmeaComposerCore::composePRDID(buffer, size,
+			validity, pitch, roll, heading, json);
+	return scope.finish(buffer, size, length, invalidFields(validity, 3),
+			false);
+}
 
-	/*------------ Field 02 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%+06.2f");
+void NmeaComposer::composeAISPositionReportClassA(NmeaStringStorage& nmea,
+		const AISPositionReportClassA& report, char channel) {
+	ComposeScope scope(Nmea_SentenceType_VDM);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeAISPositionReportClassA(buffer, size,
+				report, channel);
+	});
+	scope.finish(nmea, 0, false);
+}
 
-		fields.push_back(boost::str(auxfmt % roll));
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
+std::size_t NmeaComposer::composeAISPositionReportClassA(char* buffer,
+		std::size_t size, const AISPositionReportClassA& report,
+		char channel) {
+	ComposeScope scope(Nmea_SentenceType_VDM);
+	std::size_t length = NmeaComposerCore::composeAISPositionReportClassA(
+			buffer, size, report, channel);
+	return scope.finish(buffer, size, length, 0, false);
+}
 
-	/*------------ Field 03 ---------------*/
-	if (!validity[idxVar]) {
-		boost::format auxfmt("%06.2f");
+void NmeaComposer::composeAISStandardClassBCSPositionReport(
+		NmeaStringStorage& nmea,
+		const AISStandardClassBCSPositionReport& report, char channel) {
+	ComposeScope scope(Nmea_SentenceType_VDM);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeAISStandardClassBCSPositionReport(
+				buffer, size, report, channel);
+	});
+	scope.finish(nmea, 0, false);
+}
 
-		fields.push_back(boost::str(auxfmt % heading));
-	} else {
-		fields.push_back("");
-	}
-	++idxVar;
+std::size_t NmeaComposer::composeAISStandardClassBCSPositionReport(
+		char* buffer, std::size_t size,
+		const AISStandardClassBCSPositionReport& report, char channel) {
+	ComposeScope scope(Nmea_SentenceType_VDM);
+	std::size_t length =
+			NmeaComposerCore::composeAISStandardClassBCSPositionReport(buffer,
+					size, report, channel);
+	return scope.finish(buffer, size, length, 0, false);
+}
+
+void NmeaComposer::composeAISMeteorologicalHydrologicalData(
+		NmeaStringStorage& nmea,
+		const AISMeteorologicalHydrologicalData& report, char channel) {
+	ComposeScope scope(Nmea_SentenceType_VDM);
+	composeString(nmea, [&](char* buffer, std::size_t size) {
+		return NmeaComposerCore::composeAISMeteorologicalHydrologicalData(
+				buffer, size, report, channel);
+	});
+	scope.finish(nmea, 0, false);
+}
 
-	composeNmea(nmea, fields);
+std::size_t NmeaComposer::composeAISMeteorologicalHydrologicalData(
+		char* buffer, std::size_t size,
+		const AISMeteorologicalHydrologicalData& report, char channel) {
+	ComposeScope scope(Nmea_SentenceType_VDM);
+	std::size_t length =
+			NmeaComposerCore::composeAISMeteorologicalHydrologicalData(buffer,
+					size, report, channel);
+	return scope.finish(buffer, size, length, 0, false);
+}
 
-	LOG_MESSAGE(debug)<< nmea;
+void NmeaComposer::composeXDR(NmeaStringStorage& xdr, NmeaStringStorage& vdm,
+		const char* talkerid, const NmeaComposerValid& validity,
+		const std::vector<TransducerMeasurement>& measurements,
+		const NmeaMetHydro& mapper, AISMeteorologicalHydrologicalData& report,
+		char channel) {
+	Transducers transducers(measurements, &xdr);
+	{
+		ComposeScope scope(Nmea_SentenceType_XDR);
+		composeString(xdr, [&](char* buffer, std::size_t size) {
+			return NmeaComposerCore::composeXDR(buffer, size, talkerid,
+					validity, transducers.data, transducers.count);
+		});
+		scope.finish(xdr, invalidFields(validity, measurements.size() * 4),
+				badTalker(talkerid));
+	}
+	mapper.map(transducers.data, transducers.count, report);
+	composeAISMeteorologicalHydrologicalData(vdm, report, channel);
 }
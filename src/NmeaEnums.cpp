@@ -0,0 +1,33 @@
+/*
+ * NmeaEnums.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaEnums.h"
+
+#include <ostream>
+
+// Storage of the name tables, for lookups that are not constant expressions
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_GPSQualityIndicator>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_SpeedDistanceUnits>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_TargetStatus>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_TypeOfAcquisition>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_TrackStatus>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_Operation>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_SpeedMode>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_StabilisationMode>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_AisMessageType>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_EPFDFix>::names[];
+constexpr NmeaEnumName NmeaEnumTraits<Nmea_ShipType>::names[];
+
+// The operators of the enums shared with NmeaParser are defined by it, only
+// those of the enums of this library are defined here
+std::ostream& operator<<(std::ostream & out, Nmea_SentenceType val) {
+	return out << nmeaEnumName(val).name;
+}
+
+std::ostream& operator<<(std::ostream & out, Nmea_MetHydroField val) {
+	return out << nmeaEnumName(val).name;
+}
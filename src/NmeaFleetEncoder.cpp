@@ -0,0 +1,283 @@
+/*
+ * NmeaFleetEncoder.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaFleetEncoder.h"
+#include "NmeaComposer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @cond
+namespace {
+
+const std::size_t chunkTargets = 256;
+const std::size_t maxSentence = 96; // !AIVDM single fragment is 47 characters
+
+/*
+ * Where a worker left the sentence of a target, length 0 when skipped.
+ */
+struct Slot {
+	uint32_t worker;
+	uint32_t length;
+	std::size_t offset;
+};
+
+/*
+ * A thread of the pool with its own chunk range and sentence buffer. The
+ * owner takes chunks from the front, thieves from the back.
+ */
+struct Worker {
+	std::mutex mutex;
+	std::size_t firstChunk;
+	std::size_t lastChunk;
+	std::vector<char> buffer;
+	std::size_t used;
+	std::thread thread;
+};
+
+uint32_t mmsi(const NmeaAisTarget& target) {
+	return target.messageType == Nmea_AisMessageType_PositionReportClassA ?
+			target.positionReportClassA.mmsi :
+			target.standardClassBCSPositionReport.mmsi;
+}
+
+} // namespace
+/// @endcond
+
+class NmeaFleetEncoder::impl {
+public:
+	explicit impl(unsigned threads) :
+			generation(0), running(0), stopping(false), targets(NULL), count(0) {
+		if (threads == 0) {
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		for (unsigned w = 0; w < threads; ++w) {
+			workers.emplace_back(new Worker);
+			workers.back()->firstChunk = 0;
+			workers.back()->lastChunk = 0;
+			workers.back()->used = 0;
+		}
+		// Worker 0 is the thread calling encode()
+		for (unsigned w = 1; w < threads; ++w) {
+			workers[w]->thread = std::thread(&impl::run, this, w);
+		}
+	}
+
+	~impl() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wakeup.notify_all();
+		for (std::size_t w = 1; w < workers.size(); ++w) {
+			workers[w]->thread.join();
+		}
+	}
+
+	/*
+	 * Encodes every target, then fills order with the indices of the encoded
+	 * ones in output order.
+	 */
+	void encode(const NmeaAisTarget* targets, std::size_t count,
+			NmeaFleetOrder fleetOrder) {
+		this->targets = targets;
+		this->count = count;
+		slots.resize(count);
+
+		std::size_t chunks = (count + chunkTargets - 1) / chunkTargets;
+		for (std::size_t w = 0; w < workers.size(); ++w) {
+			Worker& worker = *workers[w];
+			worker.used = 0;
+			worker.firstChunk = chunks * w / workers.size();
+			worker.lastChunk = chunks * (w + 1) / workers.size();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			++generation;
+			running = workers.size() - 1;
+		}
+		wakeup.notify_all();
+		work(0);
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			finished.wait(lock, [this] {
+				return running == 0;
+			});
+		}
+
+		sort(fleetOrder);
+	}
+
+	const char* sentence(std::size_t index) const {
+		const Slot& slot = slots[index];
+		return workers[slot.worker]->buffer.data() + slot.offset;
+	}
+
+	std::vector<std::unique_ptr<Worker> > workers;
+	std::vector<Slot> slots;
+	std::vector<uint32_t> order;
+
+private:
+	void run(unsigned w) {
+		uint64_t seen = 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeup.wait(lock, [&] {
+					return stopping || generation != seen;
+				});
+				if (stopping) {
+					return;
+				}
+				seen = generation;
+			}
+			work(w);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				--running;
+			}
+			finished.notify_one();
+		}
+	}
+
+	void work(unsigned w) {
+		std::size_t chunk;
+		while (take(w, chunk)) {
+			std::size_t end = std::min(count, (chunk + 1) * chunkTargets);
+			for (std::size_t i = chunk * chunkTargets; i < end; ++i) {
+				encodeTarget(w, i);
+			}
+		}
+	}
+
+	bool take(unsigned w, std::size_t& chunk) {
+		{
+			Worker& own = *workers[w];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (own.firstChunk < own.lastChunk) {
+				chunk = own.firstChunk++;
+				return true;
+			}
+		}
+		for (std::size_t i = 1; i < workers.size(); ++i) {
+			Worker& victim = *workers[(w + i) % workers.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (victim.firstChunk < victim.lastChunk) {
+				chunk = --victim.lastChunk;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void encodeTarget(unsigned w, std::size_t i) {
+		Worker& worker = *workers[w];
+		if (worker.buffer.size() < worker.used + maxSentence) {
+			worker.buffer.resize(
+					std::max(worker.buffer.size() * 2, worker.used + maxSentence));
+		}
+		char* buffer = worker.buffer.data() + worker.used;
+		const NmeaAisTarget& target = targets[i];
+		std::size_t length = 0;
+		if (target.messageType == Nmea_AisMessageType_PositionReportClassA) {
+			length = NmeaComposer::composeAISPositionReportClassA(buffer,
+					maxSentence, target.positionReportClassA, target.channel);
+		} else if (target.messageType
+				== Nmea_AisMessageType_StandardClassBCSPositionReport) {
+			length = NmeaComposer::composeAISStandardClassBCSPositionReport(
+					buffer, maxSentence, target.standardClassBCSPositionReport,
+					target.channel);
+		}
+		length = std::min(length, maxSentence - 1);
+		Slot& slot = slots[i];
+		slot.worker = w;
+		slot.length = length;
+		slot.offset = worker.used;
+		worker.used += length;
+	}
+
+	/*
+	 * Orders the encoded targets by key then index. Arrays kept in key order
+	 * by the caller are detected and not sorted again.
+	 */
+	void sort(NmeaFleetOrder fleetOrder) {
+		order.clear();
+		keys.resize(count);
+		bool sorted = true;
+		for (std::size_t i = 0; i < count; ++i) {
+			keys[i] = fleetOrder == NmeaFleetOrder_Mmsi ?
+					mmsi(targets[i]) : targets[i].slotTime;
+			if (slots[i].length != 0) {
+				if (!order.empty() && keys[i] < keys[order.back()]) {
+					sorted = false;
+				}
+				order.push_back(i);
+			}
+		}
+		if (!sorted) {
+			std::sort(order.begin(), order.end(),
+					[this](uint32_t a, uint32_t b) {
+						return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+					});
+		}
+	}
+
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::condition_variable finished;
+	uint64_t generation;
+	std::size_t running;
+	bool stopping;
+
+	const NmeaAisTarget* targets;
+	std::size_t count;
+	std::vector<int64_t> keys;
+};
+
+NmeaFleetEncoder::NmeaFleetEncoder(unsigned threads) :
+		pimpl(new impl(threads)) {
+}
+
+NmeaFleetEncoder::~NmeaFleetEncoder() {
+}
+
+std::size_t NmeaFleetEncoder::encode(const NmeaAisTarget* targets,
+		std::size_t count, NmeaFleetOrder order, NmeaSink& sink) {
+	pimpl->encode(targets, count, order);
+	for (uint32_t index : pimpl->order) {
+		sink.write(pimpl->sentence(index), pimpl->slots[index].length);
+	}
+	return pimpl->order.size();
+}
+
+std::size_t NmeaFleetEncoder::encode(const NmeaAisTarget* targets,
+		std::size_t count, NmeaFleetOrder order, std::string& output) {
+	pimpl->encode(targets, count, order);
+	std::size_t bytes = 0;
+	for (uint32_t index : pimpl->order) {
+		bytes += pimpl->slots[index].length + 2;
+	}
+	output.resize(bytes);
+	char* out = &output[0];
+	for (uint32_t index : pimpl->order) {
+		std::size_t length = pimpl->slots[index].length;
+		std::memcpy(out, pimpl->sentence(index), length);
+		out[length] = '\r';
+		out[length + 1] = '\n';
+		out += length + 2;
+	}
+	return pimpl->order.size();
+}
+
+unsigned NmeaFleetEncoder::threads() const {
+	return pimpl->workers.size();
+}
@@ -0,0 +1,514 @@
+/*
+ * NmeaJournal.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaJournal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @cond
+namespace {
+
+const char segmentMagic[8] = { 'N', 'M', 'E', 'A', 'J', 'R', 'N', 'L' };
+const uint32_t segmentVersion = 1;
+const char segmentPrefix[] = "nmea-";
+const char segmentSuffix[] = ".njl";
+
+/*
+ * Segment layout:
+ *   SegmentHeader
+ *   RecordHeader, sentence, padding to 8 bytes ... (length 0 terminates)
+ *   IndexEntry[indexCount]  (sealed segments only, at indexOffset)
+ */
+struct SegmentHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint64_t sequence;
+	uint64_t dataEnd; // 0 while the segment is active
+	uint64_t indexOffset;
+	uint64_t indexCount;
+	int64_t firstUtcNs;
+	int64_t lastUtcNs;
+};
+
+struct RecordHeader {
+	uint32_t length;
+	uint32_t reserved;
+	int64_t monotonicNs;
+	int64_t utcNs;
+};
+
+struct IndexEntry {
+	int64_t utcNs;
+	uint64_t offset;
+};
+
+std::size_t recordSize(std::size_t length) {
+	return (sizeof(RecordHeader) + length + 7) & ~static_cast<std::size_t>(7);
+}
+
+int64_t clockNs(clockid_t clock) {
+	timespec ts;
+	clock_gettime(clock, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+std::system_error systemError(const std::string& what) {
+	return std::system_error(errno, std::generic_category(), what);
+}
+
+std::string segmentPath(const std::string& directory, uint64_t sequence) {
+	char name[64];
+	std::snprintf(name, sizeof(name), "%s%012llu%s", segmentPrefix,
+			static_cast<unsigned long long>(sequence), segmentSuffix);
+	return directory + "/" + name;
+}
+
+/*
+ * Sequence numbers of every segment in the directory, sorted.
+ */
+std::vector<uint64_t> listSegments(const std::string& directory) {
+	std::vector<uint64_t> sequences;
+	DIR* dir = opendir(directory.c_str());
+	if (dir == NULL) {
+		throw systemError("Cannot open journal directory " + directory);
+	}
+
+	const std::size_t prefixLength = sizeof(segmentPrefix) - 1;
+	const std::size_t suffixLength = sizeof(segmentSuffix) - 1;
+	while (dirent* entry = readdir(dir)) {
+		std::size_t length = std::strlen(entry->d_name);
+		if (length != prefixLength + 12 + suffixLength
+				|| std::strncmp(entry->d_name, segmentPrefix, prefixLength) != 0
+				|| std::strcmp(entry->d_name + prefixLength + 12, segmentSuffix)
+						!= 0) {
+			continue;
+		}
+		sequences.push_back(
+				std::strtoull(entry->d_name + prefixLength, NULL, 10));
+	}
+	closedir(dir);
+
+	std::sort(sequences.begin(), sequences.end());
+	return sequences;
+}
+
+} // namespace
+/// @endcond
+
+class NmeaJournal::impl {
+public:
+	impl(const std::string& directory, std::size_t segmentSize,
+			std::size_t commitBytes, int64_t indexIntervalNs) :
+			directory(directory), segmentSize(segmentSize), commitBytes(
+					commitBytes), indexIntervalNs(indexIntervalNs), sequence(
+					0), fd(-1), base(NULL), offset(0), committed(0), nextIndexUtcNs(
+					0) {
+		if (segmentSize < sizeof(SegmentHeader) + recordSize(1)) {
+			throw std::invalid_argument("Journal segment size too small");
+		}
+		if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+			throw systemError("Cannot create journal directory " + directory);
+		}
+		std::vector<uint64_t> sequences = listSegments(directory);
+		if (!sequences.empty()) {
+			sequence = sequences.back() + 1;
+		}
+		openSegment();
+	}
+
+	~impl() {
+		try {
+			sealSegment();
+		} catch (...) {
+		}
+	}
+
+	void openSegment() {
+		std::string path = segmentPath(directory, sequence);
+		fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+		if (fd < 0) {
+			throw systemError("Cannot create journal segment " + path);
+		}
+		if (ftruncate(fd, segmentSize) != 0) {
+			int error = errno;
+			close(fd);
+			fd = -1;
+			errno = error;
+			throw systemError("Cannot size journal segment " + path);
+		}
+		void* mapping = mmap(NULL, segmentSize, PROT_READ | PROT_WRITE,
+				MAP_SHARED, fd, 0);
+		if (mapping == MAP_FAILED) {
+			int error = errno;
+			close(fd);
+			fd = -1;
+			errno = error;
+			throw systemError("Cannot map journal segment " + path);
+		}
+		base = static_cast<char*>(mapping);
+
+		SegmentHeader* header = reinterpret_cast<SegmentHeader*>(base);
+		std::memcpy(header->magic, segmentMagic, sizeof(segmentMagic));
+		header->version = segmentVersion;
+		header->headerSize = sizeof(SegmentHeader);
+		header->sequence = sequence;
+
+		offset = sizeof(SegmentHeader);
+		committed = 0;
+		index.clear();
+	}
+
+	void sealSegment() {
+		if (base == NULL) {
+			return;
+		}
+		SegmentHeader header = *reinterpret_cast<SegmentHeader*>(base);
+		header.dataEnd = offset;
+		header.indexOffset = offset;
+		header.indexCount = index.size();
+		if (!index.empty()) {
+			header.firstUtcNs = index.front().utcNs;
+			header.lastUtcNs = lastUtcNs;
+		}
+
+		msync(base, offset, MS_SYNC);
+		munmap(base, segmentSize);
+		base = NULL;
+
+		// Shrink to the data actually written, then append the index and
+		// publish it in the header last so a torn seal is detected on read.
+		std::size_t indexBytes = index.size() * sizeof(IndexEntry);
+		bool sealed = ftruncate(fd, offset) == 0
+				&& pwrite(fd, index.data(), indexBytes, offset)
+						== static_cast<ssize_t>(indexBytes)
+				&& pwrite(fd, &header, sizeof(header), 0)
+						== static_cast<ssize_t>(sizeof(header))
+				&& fdatasync(fd) == 0;
+		int error = errno;
+		close(fd);
+		fd = -1;
+		++sequence;
+
+		if (!sealed) {
+			errno = error;
+			throw systemError("Cannot seal journal segment");
+		}
+	}
+
+	void commit(int flags) {
+		long pageSize = sysconf(_SC_PAGESIZE);
+		std::size_t from = committed & ~static_cast<std::size_t>(pageSize - 1);
+		if (offset > from) {
+			msync(base + from, offset - from, flags);
+		}
+		committed = offset;
+	}
+
+	void append(const char* sentence, std::size_t length, int64_t monotonicNs,
+			int64_t utcNs) {
+		std::size_t size = recordSize(length);
+		if (sizeof(SegmentHeader) + size > segmentSize) {
+			throw std::length_error("Sentence larger than a journal segment");
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (offset + size > segmentSize) {
+			sealSegment();
+			openSegment();
+		}
+
+		RecordHeader* record = reinterpret_cast<RecordHeader*>(base + offset);
+		record->monotonicNs = monotonicNs;
+		record->utcNs = utcNs;
+		std::memcpy(base + offset + sizeof(RecordHeader), sentence, length);
+		// Length goes last: a reader never sees a partially copied record.
+		std::atomic_thread_fence(std::memory_order_release);
+		record->length = static_cast<uint32_t>(length);
+
+		if (index.empty() || utcNs >= nextIndexUtcNs) {
+			IndexEntry entry = { utcNs, offset };
+			index.push_back(entry);
+			nextIndexUtcNs = utcNs - utcNs % indexIntervalNs + indexIntervalNs;
+		}
+		lastUtcNs = utcNs;
+		offset += size;
+
+		if (offset - committed >= commitBytes) {
+			commit(MS_ASYNC);
+		}
+	}
+
+	void flush() {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (base != NULL) {
+			commit(MS_SYNC);
+		}
+	}
+
+	std::string directory;
+	std::size_t segmentSize;
+	std::size_t commitBytes;
+	int64_t indexIntervalNs;
+
+	std::mutex mutex;
+	uint64_t sequence;
+	int fd;
+	char* base;
+	std::size_t offset;
+	std::size_t committed;
+	std::vector<IndexEntry> index;
+	int64_t nextIndexUtcNs;
+	int64_t lastUtcNs;
+};
+
+NmeaJournal::NmeaJournal(const std::string& directory, std::size_t segmentSize,
+		std::size_t commitBytes, int64_t indexIntervalNs) :
+		pimpl(new impl(directory, segmentSize, commitBytes, indexIntervalNs)) {
+}
+
+NmeaJournal::~NmeaJournal() {
+}
+
+void NmeaJournal::writeSentence(const char* sentence, std::size_t length) {
+	pimpl->append(sentence, length, clockNs(CLOCK_MONOTONIC),
+			clockNs(CLOCK_REALTIME));
+}
+
+void NmeaJournal::append(const char* sentence, std::size_t length,
+		int64_t monotonicNs, int64_t utcNs) {
+	pimpl->append(sentence, length, monotonicNs, utcNs);
+}
+
+void NmeaJournal::flushSentences() {
+	pimpl->flush();
+}
+
+class NmeaJournalReader::impl {
+public:
+	struct Segment {
+		const char* base;
+		std::size_t size;
+		std::size_t dataEnd;
+		int64_t firstUtcNs;
+		const IndexEntry* index;
+		std::size_t indexCount;
+		std::vector<IndexEntry> rebuiltIndex;
+	};
+
+	explicit impl(const std::string& directory) :
+			current(0), offset(0) {
+		std::vector<uint64_t> sequences = listSegments(directory);
+		segments.reserve(sequences.size());
+		for (uint64_t sequence : sequences) {
+			mapSegment(segmentPath(directory, sequence));
+		}
+		rewind();
+	}
+
+	~impl() {
+		for (Segment& segment : segments) {
+			munmap(const_cast<char*>(segment.base), segment.size);
+		}
+	}
+
+	void mapSegment(const std::string& path) {
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw systemError("Cannot open journal segment " + path);
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			int error = errno;
+			close(fd);
+			errno = error;
+			throw systemError("Cannot stat journal segment " + path);
+		}
+		std::size_t size = st.st_size;
+		if (size < sizeof(SegmentHeader)) {
+			close(fd);
+			return;
+		}
+		void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+		int error = errno;
+		close(fd);
+		if (mapping == MAP_FAILED) {
+			errno = error;
+			throw systemError("Cannot map journal segment " + path);
+		}
+
+		Segment segment;
+		segment.base = static_cast<const char*>(mapping);
+		segment.size = size;
+		const SegmentHeader* header =
+				reinterpret_cast<const SegmentHeader*>(segment.base);
+		if (std::memcmp(header->magic, segmentMagic, sizeof(segmentMagic)) != 0
+				|| header->version != segmentVersion) {
+			munmap(mapping, size);
+			return;
+		}
+
+		if (header->dataEnd != 0
+				&& header->indexOffset
+						+ header->indexCount * sizeof(IndexEntry) <= size) {
+			segment.dataEnd = header->dataEnd;
+			segment.index = reinterpret_cast<const IndexEntry*>(segment.base
+					+ header->indexOffset);
+			segment.indexCount = header->indexCount;
+		} else {
+			// Active or unsealed segment: index every record.
+			segment.dataEnd = size;
+			std::size_t position = sizeof(SegmentHeader);
+			while (const RecordHeader* record = recordAt(segment, position)) {
+				IndexEntry entry = { record->utcNs, position };
+				segment.rebuiltIndex.push_back(entry);
+				position += recordSize(record->length);
+			}
+			segment.dataEnd = position;
+			segment.index = segment.rebuiltIndex.data();
+			segment.indexCount = segment.rebuiltIndex.size();
+		}
+
+		if (segment.indexCount == 0) {
+			munmap(mapping, size);
+			return;
+		}
+		segment.firstUtcNs = segment.index[0].utcNs;
+		segments.push_back(std::move(segment));
+		Segment& stored = segments.back();
+		if (!stored.rebuiltIndex.empty()) {
+			stored.index = stored.rebuiltIndex.data();
+		}
+	}
+
+	static const RecordHeader* recordAt(const Segment& segment,
+			std::size_t position) {
+		if (position + sizeof(RecordHeader) > segment.dataEnd) {
+			return NULL;
+		}
+		const RecordHeader* record =
+				reinterpret_cast<const RecordHeader*>(segment.base + position);
+		uint32_t length = record->length;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (length == 0 || position + recordSize(length) > segment.dataEnd) {
+			return NULL;
+		}
+		return record;
+	}
+
+	void rewind() {
+		current = 0;
+		offset = sizeof(SegmentHeader);
+	}
+
+	static bool segmentBefore(int64_t utcNs, const Segment& segment) {
+		return utcNs < segment.firstUtcNs;
+	}
+
+	static bool entryBefore(int64_t utcNs, const IndexEntry& entry) {
+		return utcNs < entry.utcNs;
+	}
+
+	bool seek(int64_t utcNs) {
+		// Last segment starting at or before utcNs, then the last index
+		// entry at or before utcNs, then a short linear scan.
+		std::vector<Segment>::iterator segment = std::upper_bound(
+				segments.begin(), segments.end(), utcNs, segmentBefore);
+		if (segment == segments.begin()) {
+			rewind();
+			return !segments.empty();
+		}
+		--segment;
+
+		const IndexEntry* entry = std::upper_bound(segment->index,
+				segment->index + segment->indexCount, utcNs, entryBefore);
+		--entry;
+
+		current = segment - segments.begin();
+		offset = entry->offset;
+		while (current < segments.size()) {
+			const RecordHeader* record = recordAt(segments[current], offset);
+			if (record == NULL) {
+				++current;
+				offset = sizeof(SegmentHeader);
+				continue;
+			}
+			if (record->utcNs >= utcNs) {
+				return true;
+			}
+			offset += recordSize(record->length);
+		}
+		return false;
+	}
+
+	bool next(NmeaJournalRecord& result) {
+		while (current < segments.size()) {
+			const RecordHeader* record = recordAt(segments[current], offset);
+			if (record == NULL) {
+				++current;
+				offset = sizeof(SegmentHeader);
+				continue;
+			}
+			result.sentence = segments[current].base + offset
+					+ sizeof(RecordHeader);
+			result.length = record->length;
+			result.monotonicNs = record->monotonicNs;
+			result.utcNs = record->utcNs;
+			offset += recordSize(record->length);
+			return true;
+		}
+		return false;
+	}
+
+	std::vector<Segment> segments;
+	std::size_t current;
+	std::size_t offset;
+};
+
+NmeaJournalReader::NmeaJournalReader(const std::string& directory) :
+		pimpl(new impl(directory)) {
+}
+
+NmeaJournalReader::~NmeaJournalReader() {
+}
+
+bool NmeaJournalReader::seek(int64_t utcNs) {
+	return pimpl->seek(utcNs);
+}
+
+bool NmeaJournalReader::seek(const boost::posix_time::ptime& utc) {
+	static const boost::posix_time::ptime epoch(
+			boost::gregorian::date(1970, 1, 1));
+	return pimpl->seek((utc - epoch).total_nanoseconds());
+}
+
+void NmeaJournalReader::rewind() {
+	pimpl->rewind();
+}
+
+bool NmeaJournalReader::next(NmeaJournalRecord& record) {
+	return pimpl->next(record);
+}
+
+std::size_t NmeaJournalReader::segmentCount() const {
+	return pimpl->segments.size();
+}
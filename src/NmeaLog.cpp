@@ -0,0 +1,238 @@
+/*
+ * NmeaLog.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+
+/// @cond
+namespace {
+
+enum RecordKind {
+	RecordField, RecordSentence
+};
+
+const std::size_t recordTextSize = 120;
+
+/*
+ * 128 bytes, two cache lines.
+ */
+struct Record {
+	uint8_t kind;
+	uint8_t type;
+	uint16_t index;
+	uint16_t length;
+	uint8_t truncated;
+	uint8_t reserved;
+	char text[recordTextSize];
+};
+
+const std::size_t ringCapacity = 4096;
+
+/*
+ * Single producer (the owning thread), single consumer (the writer thread).
+ */
+struct Ring {
+	alignas(64) std::atomic<uint64_t> head;
+	alignas(64) std::atomic<uint64_t> tail;
+	std::atomic<bool> abandoned;
+	Record records[ringCapacity];
+
+	Ring() :
+			head(0), tail(0), abandoned(false) {
+	}
+};
+
+class Writer {
+public:
+	Writer() :
+			stopping(false), flushRequested(0), flushCompleted(0), dropCount(0) {
+		// Opening a record creates the Boost.Log singletons the writer thread
+		// uses, so that they are destroyed after the writer drains at exit
+		boost::log::trivial::logger::get().open_record(
+				boost::log::keywords::severity = boost::log::trivial::debug);
+		thread = std::thread(&Writer::run, this);
+	}
+
+	~Writer() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wakeup.notify_all();
+		thread.join();
+	}
+
+	std::shared_ptr<Ring> attach() {
+		std::shared_ptr<Ring> ring = std::make_shared<Ring>();
+		std::lock_guard<std::mutex> lock(mutex);
+		rings.push_back(ring);
+		return ring;
+	}
+
+	void drop() {
+		dropCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t dropped() const {
+		return dropCount.load(std::memory_order_relaxed);
+	}
+
+	void flush() {
+		std::unique_lock<std::mutex> lock(mutex);
+		uint64_t request = ++flushRequested;
+		wakeup.notify_all();
+		flushed.wait(lock, [&] {return flushCompleted >= request;});
+	}
+
+private:
+	void run() {
+		std::vector<std::shared_ptr<Ring> > active;
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			uint64_t request = flushRequested;
+			bool stop = stopping;
+			active = rings;
+			lock.unlock();
+
+			bool idle = true;
+			for (const std::shared_ptr<Ring>& ring : active) {
+				idle = drain(*ring) == 0 && idle;
+			}
+
+			lock.lock();
+			rings.erase(
+					std::remove_if(rings.begin(), rings.end(),
+							[](const std::shared_ptr<Ring>& ring) {
+								return ring->abandoned.load(std::memory_order_acquire)
+										&& ring->tail.load(std::memory_order_relaxed)
+												== ring->head.load(std::memory_order_acquire);
+							}), rings.end());
+			if (request > flushCompleted) {
+				flushCompleted = request;
+				flushed.notify_all();
+			}
+			if (stop) {
+				break;
+			}
+			if (idle && flushRequested == flushCompleted && !stopping) {
+				wakeup.wait_for(lock, std::chrono::milliseconds(10));
+			}
+		}
+	}
+
+	std::size_t drain(Ring& ring) {
+		uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+		uint64_t head = ring.head.load(std::memory_order_acquire);
+		for (uint64_t i = tail; i != head; ++i) {
+			write(ring.records[i % ringCapacity]);
+		}
+		ring.tail.store(head, std::memory_order_release);
+		return head - tail;
+	}
+
+	void write(const Record& record) {
+		line.str("");
+		NmeaEnumName type = nmeaEnumName(
+				static_cast<Nmea_SentenceType>(record.type));
+		line.write(type.name, type.length);
+		if (record.kind == RecordField) {
+			line << " field " << record.index << ": ";
+		} else {
+			line << " sentence: ";
+		}
+		line.write(record.text, record.length);
+		if (record.truncated) {
+			line << "...";
+		}
+		BOOST_LOG_TRIVIAL(debug)<< line.str();
+	}
+
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::condition_variable flushed;
+	std::vector<std::shared_ptr<Ring> > rings;
+	bool stopping;
+	uint64_t flushRequested;
+	uint64_t flushCompleted;
+	std::atomic<uint64_t> dropCount;
+	std::ostringstream line;
+	std::thread thread;
+};
+
+Writer& writer() {
+	static Writer instance;
+	return instance;
+}
+
+/*
+ * Releases the ring of an exiting thread once the writer has drained it.
+ */
+struct ThreadRing {
+	std::shared_ptr<Ring> ring;
+
+	~ThreadRing() {
+		if (ring) {
+			ring->abandoned.store(true, std::memory_order_release);
+		}
+	}
+};
+
+thread_local ThreadRing threadRing;
+
+void append(RecordKind kind, Nmea_SentenceType type, std::size_t index,
+		const char* text, std::size_t length) {
+	if (!threadRing.ring) {
+		threadRing.ring = writer().attach();
+	}
+	Ring& ring = *threadRing.ring;
+	uint64_t head = ring.head.load(std::memory_order_relaxed);
+	if (head - ring.tail.load(std::memory_order_acquire) == ringCapacity) {
+		writer().drop();
+		return;
+	}
+	Record& record = ring.records[head % ringCapacity];
+	record.kind = kind;
+	record.type = type;
+	record.index = index;
+	record.length = std::min(length, recordTextSize);
+	record.truncated = length > recordTextSize;
+	std::memcpy(record.text, text, record.length);
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace
+/// @endcond
+
+void NmeaLog::field(Nmea_SentenceType type, std::size_t index,
+		const char* text, std::size_t length) {
+	append(RecordField, type, index, text, length);
+}
+
+void NmeaLog::sentence(Nmea_SentenceType type, const char* text,
+		std::size_t length) {
+	append(RecordSentence, type, 0, text, length);
+}
+
+void NmeaLog::flush() {
+	writer().flush();
+}
+
+uint64_t NmeaLog::dropped() {
+	return writer().dropped();
+}
@@ -0,0 +1,243 @@
+/*
+ * NmeaOnChange.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaOnChange.h"
+
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+/// @cond
+namespace {
+
+/*
+ * Inputs of the last emitted sentence of one type, talker and stream.
+ */
+struct Emitted {
+	NmeaComposerValid validity;
+	int64_t monotonicNs;
+	std::vector<double> inputs;
+	std::string discrete;
+};
+
+struct Config {
+	double deadband;
+	std::vector<double> deadbands; // per input, NaN when not set
+	int64_t keepAliveNs;
+};
+
+uint64_t key(Nmea_SentenceType type, const std::string& talkerid,
+		uint32_t stream) {
+	uint32_t talker = 0;
+	if (talkerid.size() == 2) {
+		talker = (static_cast<uint8_t>(talkerid[0]) << 8)
+				| static_cast<uint8_t>(talkerid[1]);
+	}
+	return (static_cast<uint64_t>(stream) << 32)
+			| (static_cast<uint32_t>(type) << 16) | talker;
+}
+
+double difference(double previous, double current, bool angle) {
+	double change = std::abs(current - previous);
+	if (angle) {
+		change = std::fmod(change, 360);
+		change = std::min(change, 360 - change);
+	}
+	return change;
+}
+
+} // namespace
+/// @endcond
+
+class NmeaOnChange::impl {
+public:
+	impl() {
+		for (Config& config : configs) {
+			config.deadband = 0;
+			config.keepAliveNs = 0;
+		}
+	}
+
+	bool changed(Nmea_SentenceType type, const std::string& talkerid,
+			const NmeaComposerValid& validity, const double* inputs,
+			std::size_t count, const std::string& discrete,
+			int64_t monotonicNs, uint32_t angles, uint32_t stream = 0) {
+		const Config& config = configs[type];
+		std::pair<std::unordered_map<uint64_t, Emitted>::iterator, bool> found =
+				emitted.insert(
+						std::make_pair(key(type, talkerid, stream), Emitted()));
+		Emitted& last = found.first->second;
+
+		bool emit = found.second || last.validity != validity
+				|| last.inputs.size() != count || last.discrete != discrete
+				|| (config.keepAliveNs != 0
+						&& monotonicNs - last.monotonicNs >= config.keepAliveNs);
+		for (std::size_t i = 0; i < count && !emit; ++i) {
+			double previous = last.inputs[i];
+			if (std::isnan(previous) || std::isnan(inputs[i])) {
+				emit = std::isnan(previous) != std::isnan(inputs[i]);
+				continue;
+			}
+			double deadband = config.deadband;
+			if (i < config.deadbands.size() && !std::isnan(config.deadbands[i])) {
+				deadband = config.deadbands[i];
+			}
+			bool angle = i < 32 && ((angles >> i) & 1);
+			double change = difference(previous, inputs[i], angle);
+			emit = deadband > 0 ? change >= deadband : change != 0;
+		}
+
+		if (emit) {
+			last.validity = validity;
+			last.monotonicNs = monotonicNs;
+			last.inputs.assign(inputs, inputs + count);
+			last.discrete = discrete;
+		}
+		return emit;
+	}
+
+	Config configs[Nmea_SentenceType_Count];
+	std::unordered_map<uint64_t, Emitted> emitted;
+	std::string discrete; // scratch for the non numeric inputs
+	std::vector<double> inputs; // scratch for the XDR inputs
+};
+
+NmeaOnChange::NmeaOnChange() :
+		pimpl(new impl) {
+}
+
+NmeaOnChange::~NmeaOnChange() {
+}
+
+void NmeaOnChange::setDeadband(Nmea_SentenceType type, double deadband) {
+	pimpl->configs[type].deadband = deadband;
+	pimpl->configs[type].deadbands.clear();
+}
+
+void NmeaOnChange::setDeadband(Nmea_SentenceType type, std::size_t input,
+		double deadband) {
+	std::vector<double>& deadbands = pimpl->configs[type].deadbands;
+	if (deadbands.size() <= input) {
+		deadbands.resize(input + 1, NAN);
+	}
+	deadbands[input] = deadband;
+}
+
+void NmeaOnChange::setKeepAlive(Nmea_SentenceType type, int64_t intervalNs) {
+	pimpl->configs[type].keepAliveNs = intervalNs;
+}
+
+bool NmeaOnChange::changed(Nmea_SentenceType type, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double* inputs,
+		std::size_t count, int64_t monotonicNs, uint32_t angles) {
+	pimpl->discrete.clear();
+	return pimpl->changed(type, talkerid, validity, inputs, count, pimpl->discrete,
+			monotonicNs, angles);
+}
+
+void NmeaOnChange::reset() {
+	pimpl->emitted.clear();
+}
+
+bool NmeaOnChange::composeXDR(std::string& nmea, const std::string& talkerid,
+		const NmeaComposerValid& validity,
+		const std::vector<TransducerMeasurement>& measurements,
+		int64_t monotonicNs) {
+	std::vector<double>& inputs = pimpl->inputs;
+	std::string& discrete = pimpl->discrete;
+	inputs.clear();
+	discrete.clear();
+	for (const TransducerMeasurement& measurement : measurements) {
+		inputs.push_back(measurement.measurementData);
+		discrete += measurement.transducerType;
+		discrete += measurement.unitsOfMeasurement;
+		discrete += measurement.nameOfTransducer;
+		discrete += ',';
+	}
+	// Each set of transducers of a talker is a stream of its own
+	uint32_t stream = static_cast<uint32_t>(std::hash<std::string>()(discrete));
+	if (!pimpl->changed(Nmea_SentenceType_XDR, talkerid, validity,
+			inputs.data(), inputs.size(), discrete, monotonicNs, 0, stream)) {
+		return false;
+	}
+	NmeaComposer::composeXDR(nmea, talkerid, validity, measurements);
+	return true;
+}
+
+bool NmeaOnChange::composeMWV(std::string& nmea, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double windAngle,
+		const Nmea_AngleReference reference, const double windSpeed,
+		const char windSpeedUnits, const char sensorStatus,
+		int64_t monotonicNs) {
+	const double inputs[] = { windAngle, windSpeed };
+	std::string& discrete = pimpl->discrete;
+	discrete.assign(1, static_cast<char>('0' + reference));
+	discrete += windSpeedUnits;
+	discrete += sensorStatus;
+	if (!pimpl->changed(Nmea_SentenceType_MWV, talkerid, validity, inputs,
+			2, discrete, monotonicNs, 1)) {
+		return false;
+	}
+	NmeaComposer::composeMWV(nmea, talkerid, validity, windAngle, reference,
+			windSpeed, windSpeedUnits, sensorStatus);
+	return true;
+}
+
+bool NmeaOnChange::composeMWD(std::string& nmea, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double trueWindDirection,
+		const double magneticWindDirection, const double windSpeedKnots,
+		const double windSpeedMeters, int64_t monotonicNs) {
+	const double inputs[] = { trueWindDirection, magneticWindDirection,
+			windSpeedKnots, windSpeedMeters };
+	if (!changed(Nmea_SentenceType_MWD, talkerid, validity, inputs, 4,
+			monotonicNs, 3)) {
+		return false;
+	}
+	NmeaComposer::composeMWD(nmea, talkerid, validity, trueWindDirection,
+			magneticWindDirection, windSpeedKnots, windSpeedMeters);
+	return true;
+}
+
+bool NmeaOnChange::composeHDT(std::string& nmea, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double headingDegreesTrue,
+		int64_t monotonicNs) {
+	if (!changed(Nmea_SentenceType_HDT, talkerid, validity,
+			&headingDegreesTrue, 1, monotonicNs, 1)) {
+		return false;
+	}
+	NmeaComposer::composeHDT(nmea, talkerid, validity, headingDegreesTrue);
+	return true;
+}
+
+bool NmeaOnChange::composeVLW(std::string& nmea, const std::string& talkerid,
+		const NmeaComposerValid& validity,
+		const double totalCumulativeDistance, const double distanceSinceReset,
+		int64_t monotonicNs) {
+	const double inputs[] = { totalCumulativeDistance, distanceSinceReset };
+	if (!changed(Nmea_SentenceType_VLW, talkerid, validity, inputs, 2,
+			monotonicNs)) {
+		return false;
+	}
+	NmeaComposer::composeVLW(nmea, talkerid, validity,
+			totalCumulativeDistance, distanceSinceReset);
+	return true;
+}
+
+bool NmeaOnChange::composeVHW(std::string& nmea, const std::string& talkerid,
+		const NmeaComposerValid& validity, const double headingTrue,
+		const double headingMagnetic, const double speedInKnots,
+		const double speedInKmH, int64_t monotonicNs) {
+	const double inputs[] = { headingTrue, headingMagnetic, speedInKnots,
+			speedInKmH };
+	if (!changed(Nmea_SentenceType_VHW, talkerid, validity, inputs, 4,
+			monotonicNs, 3)) {
+		return false;
+	}
+	NmeaComposer::composeVHW(nmea, talkerid, validity, headingTrue,
+			headingMagnetic, speedInKnots, speedInKmH);
+	return true;
+}
@@ -0,0 +1,448 @@
+/*
+ * NmeaReplay.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaReplay.h"
+#include "NmeaJournal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @cond
+namespace {
+
+const char indexMagic[8] = { 'N', 'M', 'E', 'A', 'R', 'I', 'D', 'X' };
+
+struct IndexFileHeader {
+	char magic[8];
+	uint64_t fileSize;
+	int64_t fileModifiedNs;
+	uint64_t count;
+};
+
+struct IndexFileEntry {
+	int64_t utcNs;
+	uint64_t offset;
+	uint32_t length;
+	uint32_t reserved;
+};
+
+std::system_error systemError(const std::string& what) {
+	return std::system_error(errno, std::generic_category(), what);
+}
+
+/*
+ * Days since 1970-01-01 of a proleptic Gregorian date.
+ */
+int64_t daysFromCivil(int year, int month, int day) {
+	year -= month <= 2;
+	const int64_t era = (year >= 0 ? year : year - 399) / 400;
+	const int64_t yoe = year - era * 400;
+	const int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day
+			- 1;
+	const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 719468;
+}
+
+bool parseDigits(const char* p, const char* end, int count, int& value) {
+	if (end - p < count) {
+		return false;
+	}
+	value = 0;
+	for (int i = 0; i < count; ++i) {
+		if (p[i] < '0' || p[i] > '9') {
+			return false;
+		}
+		value = value * 10 + (p[i] - '0');
+	}
+	return true;
+}
+
+/*
+ * hhmmss[.fff] into nanoseconds of the day.
+ */
+bool parseTimeOfDay(const char* p, const char* end, int64_t& ns) {
+	int hours, minutes, seconds;
+	if (!parseDigits(p, end, 2, hours) || !parseDigits(p + 2, end, 2, minutes)
+			|| !parseDigits(p + 4, end, 2, seconds)) {
+		return false;
+	}
+	ns = ((hours * 60 + minutes) * 60 + seconds) * 1000000000LL;
+	p += 6;
+	if (p < end && *p == '.') {
+		int64_t scale = 100000000LL;
+		for (++p; p < end && *p >= '0' && *p <= '9' && scale > 0; ++p) {
+			ns += (*p - '0') * scale;
+			scale /= 10;
+		}
+	}
+	return true;
+}
+
+/*
+ * Splits the fields of the sentence starting at p, up to the checksum.
+ */
+int splitFields(const char* p, const char* end, const char** fields,
+		const char** fieldEnds, int maxFields) {
+	int count = 0;
+	fields[0] = p;
+	for (; p < end && *p != '*'; ++p) {
+		if (*p == ',') {
+			fieldEnds[count++] = p;
+			if (count == maxFields) {
+				return count;
+			}
+			fields[count] = p + 1;
+		}
+	}
+	fieldEnds[count++] = p;
+	return count;
+}
+
+/*
+ * UTC timestamp of a recorded line, from its TAG block or from the time and
+ * date fields of RMC and ZDA sentences.
+ */
+bool lineTimestamp(const char* p, const char* end, int64_t& utcNs) {
+	if (p < end && *p == '\\') {
+		const char* tagEnd = static_cast<const char*>(std::memchr(p + 1, '\\',
+				end - p - 1));
+		if (tagEnd == NULL) {
+			return false;
+		}
+		for (const char* field = p + 1; field < tagEnd;) {
+			if (field + 2 < tagEnd && field[0] == 'c' && field[1] == ':') {
+				int64_t value = 0;
+				for (const char* d = field + 2; d < tagEnd && *d >= '0'
+						&& *d <= '9'; ++d) {
+					value = value * 10 + (*d - '0');
+				}
+				// Unix seconds, or milliseconds as written by some equipment
+				utcNs = value > 99999999999LL ?
+						value * 1000000LL : value * 1000000000LL;
+				return true;
+			}
+			const char* comma = static_cast<const char*>(std::memchr(field, ',',
+					tagEnd - field));
+			field = comma != NULL ? comma + 1 : tagEnd;
+		}
+		p = tagEnd + 1;
+	}
+
+	if (end - p < 6 || (*p != '$' && *p != '!')) {
+		return false;
+	}
+
+	const char* fields[10];
+	const char* fieldEnds[10];
+	int count = splitFields(p + 1, end, fields, fieldEnds, 10);
+	if (fieldEnds[0] - fields[0] != 5) {
+		return false;
+	}
+
+	int64_t timeNs;
+	int day, month, year;
+	const char* type = fields[0] + 2;
+	if (std::memcmp(type, "RMC", 3) == 0 && count >= 10) {
+		if (!parseTimeOfDay(fields[1], fieldEnds[1], timeNs)
+				|| fieldEnds[9] - fields[9] != 6
+				|| !parseDigits(fields[9], fieldEnds[9], 2, day)
+				|| !parseDigits(fields[9] + 2, fieldEnds[9], 2, month)
+				|| !parseDigits(fields[9] + 4, fieldEnds[9], 2, year)) {
+			return false;
+		}
+		year += year < 80 ? 2000 : 1900;
+	} else if (std::memcmp(type, "ZDA", 3) == 0 && count >= 5) {
+		if (!parseTimeOfDay(fields[1], fieldEnds[1], timeNs)
+				|| !parseDigits(fields[2], fieldEnds[2], 2, day)
+				|| !parseDigits(fields[3], fieldEnds[3], 2, month)
+				|| !parseDigits(fields[4], fieldEnds[4], 4, year)) {
+			return false;
+		}
+	} else {
+		return false;
+	}
+	utcNs = daysFromCivil(year, month, day) * 86400000000000LL + timeNs;
+	return true;
+}
+
+} // namespace
+/// @endcond
+
+class NmeaReplay::impl {
+public:
+	struct Sentence {
+		int64_t utcNs;
+		const char* data;
+		uint32_t length;
+	};
+
+	explicit impl(const std::string& path) :
+			mapping(NULL), mappingSize(0), speed(1.0), position(0), stopped(
+					false) {
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0) {
+			throw systemError("Cannot open recording " + path);
+		}
+		if (S_ISDIR(st.st_mode)) {
+			loadJournal(path);
+		} else {
+			mapText(path, st);
+			if (!loadIndex(path + ".idx", st)) {
+				buildIndex();
+				saveIndex(path + ".idx", st);
+			}
+		}
+	}
+
+	~impl() {
+		if (mapping != NULL) {
+			munmap(mapping, mappingSize);
+		}
+	}
+
+	void loadJournal(const std::string& path) {
+		journal.reset(new NmeaJournalReader(path));
+		NmeaJournalRecord record;
+		while (journal->next(record)) {
+			Sentence sentence = { record.utcNs, record.sentence,
+					static_cast<uint32_t>(record.length) };
+			sentences.push_back(sentence);
+		}
+	}
+
+	void mapText(const std::string& path, const struct stat& st) {
+		if (st.st_size == 0) {
+			return;
+		}
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw systemError("Cannot open recording " + path);
+		}
+		void* address = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		int error = errno;
+		close(fd);
+		if (address == MAP_FAILED) {
+			errno = error;
+			throw systemError("Cannot map recording " + path);
+		}
+		madvise(address, st.st_size, MADV_SEQUENTIAL);
+		mapping = static_cast<char*>(address);
+		mappingSize = st.st_size;
+	}
+
+	static int64_t modifiedNs(const struct stat& st) {
+		return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL
+				+ st.st_mtim.tv_nsec;
+	}
+
+	void buildIndex() {
+		const char* end = mapping + mappingSize;
+		bool timestamped = false;
+		int64_t utcNs = 0;
+
+		// One entry per non empty line, pointing into the mapping
+		for (const char* line = mapping; line < end;) {
+			const char* lineEnd = static_cast<const char*>(std::memchr(line,
+					'\n', end - line));
+			const char* next = lineEnd != NULL ? lineEnd + 1 : end;
+			if (lineEnd == NULL) {
+				lineEnd = end;
+			}
+			while (lineEnd > line && (lineEnd[-1] == '\r' || lineEnd[-1] == ' ')) {
+				--lineEnd;
+			}
+			if (lineEnd > line) {
+				int64_t lineUtcNs;
+				if (lineTimestamp(line, lineEnd, lineUtcNs)) {
+					if (!timestamped) {
+						// Lines before the first timestamp take it as their own
+						for (Sentence& sentence : sentences) {
+							sentence.utcNs = lineUtcNs;
+						}
+						timestamped = true;
+					}
+					utcNs = lineUtcNs;
+				}
+				Sentence sentence = { utcNs, line, static_cast<uint32_t>(lineEnd
+						- line) };
+				sentences.push_back(sentence);
+			}
+			line = next;
+		}
+	}
+
+	bool loadIndex(const std::string& indexPath, const struct stat& st) {
+		FILE* file = std::fopen(indexPath.c_str(), "rb");
+		if (file == NULL) {
+			return false;
+		}
+		IndexFileHeader header;
+		bool valid = std::fread(&header, sizeof(header), 1, file) == 1
+				&& std::memcmp(header.magic, indexMagic, sizeof(indexMagic))
+						== 0
+				&& header.fileSize == static_cast<uint64_t>(st.st_size)
+				&& header.fileModifiedNs == modifiedNs(st);
+		if (valid) {
+			std::vector<IndexFileEntry> entries(header.count);
+			valid = std::fread(entries.data(), sizeof(IndexFileEntry),
+					entries.size(), file) == entries.size();
+			sentences.reserve(entries.size());
+			for (std::size_t i = 0; valid && i < entries.size(); ++i) {
+				valid = entries[i].offset + entries[i].length <= mappingSize;
+				Sentence sentence = { entries[i].utcNs, mapping
+						+ entries[i].offset, entries[i].length };
+				sentences.push_back(sentence);
+			}
+			if (!valid) {
+				sentences.clear();
+			}
+		}
+		std::fclose(file);
+		return valid;
+	}
+
+	void saveIndex(const std::string& indexPath, const struct stat& st) {
+		// Best effort, the recording may live on read-only media.
+		std::string temporaryPath = indexPath + ".tmp";
+		FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+		if (file == NULL) {
+			return;
+		}
+		IndexFileHeader header;
+		std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+		header.fileSize = st.st_size;
+		header.fileModifiedNs = modifiedNs(st);
+		header.count = sentences.size();
+
+		bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+		for (std::size_t i = 0; written && i < sentences.size(); ++i) {
+			IndexFileEntry entry = { sentences[i].utcNs,
+					static_cast<uint64_t>(sentences[i].data - mapping),
+					sentences[i].length, 0 };
+			written = std::fwrite(&entry, sizeof(entry), 1, file) == 1;
+		}
+		written = std::fclose(file) == 0 && written;
+		if (!written || std::rename(temporaryPath.c_str(), indexPath.c_str())
+				!= 0) {
+			std::remove(temporaryPath.c_str());
+		}
+	}
+
+	static bool sentenceBefore(const Sentence& sentence, int64_t utcNs) {
+		return sentence.utcNs < utcNs;
+	}
+
+	bool seek(int64_t utcNs) {
+		position = std::lower_bound(sentences.begin(), sentences.end(), utcNs,
+				sentenceBefore) - sentences.begin();
+		return position < sentences.size();
+	}
+
+	std::size_t run() {
+		typedef std::chrono::steady_clock clock;
+
+		std::size_t replayed = 0;
+		const clock::time_point wallStart = clock::now();
+		const int64_t recordStart =
+				position < sentences.size() ? sentences[position].utcNs : 0;
+
+		for (; position < sentences.size() && !stopped; ++position) {
+			const Sentence& sentence = sentences[position];
+			if (speed > 0.0) {
+				clock::time_point target = wallStart
+						+ std::chrono::nanoseconds(
+								static_cast<int64_t>((sentence.utcNs
+										- recordStart) / speed));
+				if (target > clock::now()) {
+					std::unique_lock<std::mutex> lock(mutex);
+					if (wakeup.wait_until(lock, target, [this] {return stopped.load();})) {
+						break;
+					}
+				}
+			}
+			for (NmeaSink* sink : sinks) {
+				sink->write(sentence.data, sentence.length);
+			}
+			++replayed;
+		}
+
+		for (NmeaSink* sink : sinks) {
+			sink->flush();
+		}
+		// Cleared on return, not on entry, so that a stop() issued before
+		// run() is reached is not lost
+		stopped = false;
+		return replayed;
+	}
+
+	void stop() {
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+		wakeup.notify_all();
+	}
+
+	std::unique_ptr<NmeaJournalReader> journal;
+	char* mapping;
+	std::size_t mappingSize;
+	std::vector<Sentence> sentences;
+	std::vector<NmeaSink*> sinks;
+	double speed;
+	std::size_t position;
+
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::atomic<bool> stopped;
+};
+
+NmeaReplay::NmeaReplay(const std::string& path) :
+		pimpl(new impl(path)) {
+}
+
+NmeaReplay::~NmeaReplay() {
+}
+
+void NmeaReplay::addSink(NmeaSink& sink) {
+	pimpl->sinks.push_back(&sink);
+}
+
+void NmeaReplay::setSpeed(double speed) {
+	pimpl->speed = speed;
+}
+
+bool NmeaReplay::seek(int64_t utcNs) {
+	return pimpl->seek(utcNs);
+}
+
+bool NmeaReplay::seek(const boost::posix_time::ptime& utc) {
+	static const boost::posix_time::ptime epoch(
+			boost::gregorian::date(1970, 1, 1));
+	return pimpl->seek((utc - epoch).total_nanoseconds());
+}
+
+std::size_t NmeaReplay::run() {
+	return pimpl->run();
+}
+
+void NmeaReplay::stop() {
+	pimpl->stop();
+}
+
+std::size_t NmeaReplay::size() const {
+	return pimpl->sentences.size();
+}
@@ -0,0 +1,320 @@
+/*
+ * NmeaRouter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaRouter.h"
+#include "NmeaStatistics.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+/// @cond
+namespace {
+
+const std::size_t poolCapacity = 4096;
+
+/*
+ * Header of a routed sentence, the text follows it.
+ */
+struct Buffer {
+	std::atomic<unsigned> references;
+	Nmea_SentenceType type;
+	std::size_t capacity;
+	std::size_t length;
+	int64_t sensorMonotonicNs;
+
+	char* text() {
+		return reinterpret_cast<char*>(this + 1);
+	}
+
+	static Buffer* of(char* text) {
+		return reinterpret_cast<Buffer*>(text) - 1;
+	}
+};
+
+uint16_t talkerCode(const char* talkerid) {
+	if (std::strlen(talkerid) != 2) {
+		return 0;
+	}
+	return (static_cast<uint8_t>(talkerid[0]) << 8)
+			| static_cast<uint8_t>(talkerid[1]);
+}
+
+/*
+ * A sink with its queue and delivery thread. A null buffer in the queue
+ * requests a flush.
+ */
+struct Destination {
+	NmeaSink* sink;
+	unsigned decimation;
+	std::atomic<uint32_t> counters[Nmea_SentenceType_Count];
+
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::condition_variable flushed;
+	std::deque<Buffer*> queue;
+	uint64_t flushRequested;
+	uint64_t flushCompleted;
+	bool stopping;
+	std::thread thread;
+};
+
+} // namespace
+/// @endcond
+
+class NmeaRouter::impl {
+public:
+	impl() :
+			anyTalker(0), decimated(0) {
+		for (uint64_t& sinks : typeSinks) {
+			sinks = 0;
+		}
+	}
+
+	~impl() {
+		flush();
+		for (std::unique_ptr<Destination>& destination : destinations) {
+			{
+				std::lock_guard<std::mutex> lock(destination->mutex);
+				destination->stopping = true;
+			}
+			destination->wakeup.notify_all();
+			destination->thread.join();
+		}
+		for (Buffer* buffer : pool) {
+			::operator delete(buffer);
+		}
+	}
+
+	std::size_t add(NmeaSink& sink, const NmeaRouteFilter& filter) {
+		if (destinations.size() == maxSinks) {
+			throw std::length_error("NmeaRouter: too many sinks");
+		}
+		std::size_t index = destinations.size();
+		uint64_t bit = uint64_t(1) << index;
+		for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+			if (filter.types[type]) {
+				typeSinks[type] |= bit;
+			}
+		}
+		if (filter.talkers.empty()) {
+			anyTalker |= bit;
+		}
+		for (const std::string& talker : filter.talkers) {
+			talkerSinks[talkerCode(talker.c_str())] |= bit;
+		}
+		if (filter.decimation > 1) {
+			decimated |= bit;
+		}
+
+		std::unique_ptr<Destination> destination(new Destination);
+		destination->sink = &sink;
+		destination->decimation = std::max(filter.decimation, 1u);
+		for (std::atomic<uint32_t>& counter : destination->counters) {
+			counter.store(0, std::memory_order_relaxed);
+		}
+		destination->flushRequested = 0;
+		destination->flushCompleted = 0;
+		destination->stopping = false;
+		destination->thread = std::thread(&impl::deliver, this,
+				destination.get());
+		destinations.push_back(std::move(destination));
+		return index;
+	}
+
+	uint64_t match(Nmea_SentenceType type, const char* talkerid) {
+		uint64_t sinks = typeSinks[type] & anyTalker;
+		if (!talkerSinks.empty()) {
+			std::unordered_map<uint16_t, uint64_t>::const_iterator found =
+					talkerSinks.find(talkerCode(talkerid));
+			if (found != talkerSinks.end()) {
+				sinks |= typeSinks[type] & found->second;
+			}
+		}
+		for (uint64_t pending = sinks & decimated; pending != 0;
+				pending &= pending - 1) {
+			Destination& destination = *destinations[__builtin_ctzll(pending)];
+			if (destination.counters[type].fetch_add(1,
+					std::memory_order_relaxed) % destination.decimation != 0) {
+				sinks &= ~(pending & -pending);
+			}
+		}
+		return sinks;
+	}
+
+	Buffer* allocate(std::size_t size) {
+		if (size <= defaultSize) {
+			std::lock_guard<std::mutex> lock(poolMutex);
+			if (!pool.empty()) {
+				Buffer* buffer = pool.back();
+				pool.pop_back();
+				return buffer;
+			}
+			size = defaultSize;
+		}
+		Buffer* buffer = static_cast<Buffer*>(::operator new(
+				sizeof(Buffer) + size));
+		new (&buffer->references) std::atomic<unsigned>(0);
+		buffer->capacity = size;
+		return buffer;
+	}
+
+	void release(Buffer* buffer) {
+		if (buffer->references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+			return;
+		}
+		if (buffer->capacity == defaultSize) {
+			std::lock_guard<std::mutex> lock(poolMutex);
+			if (pool.size() < poolCapacity) {
+				pool.push_back(buffer);
+				return;
+			}
+		}
+		::operator delete(buffer);
+	}
+
+	std::size_t send(Buffer* buffer, uint64_t sinks) {
+		std::size_t count = __builtin_popcountll(sinks);
+		buffer->references.store(count, std::memory_order_relaxed);
+		for (; sinks != 0; sinks &= sinks - 1) {
+			Destination& destination = *destinations[__builtin_ctzll(sinks)];
+			{
+				std::lock_guard<std::mutex> lock(destination.mutex);
+				destination.queue.push_back(buffer);
+			}
+			destination.wakeup.notify_one();
+		}
+		return count;
+	}
+
+	void flush() {
+		std::vector<uint64_t> requests;
+		for (std::unique_ptr<Destination>& destination : destinations) {
+			{
+				std::lock_guard<std::mutex> lock(destination->mutex);
+				requests.push_back(++destination->flushRequested);
+				destination->queue.push_back(NULL);
+			}
+			destination->wakeup.notify_one();
+		}
+		for (std::size_t i = 0; i < destinations.size(); ++i) {
+			Destination& destination = *destinations[i];
+			std::unique_lock<std::mutex> lock(destination.mutex);
+			destination.flushed.wait(lock, [&] {
+				return destination.flushCompleted >= requests[i];
+			});
+		}
+	}
+
+	std::vector<std::unique_ptr<Destination> > destinations;
+
+private:
+	void deliver(Destination* destination) {
+		std::deque<Buffer*> batch;
+		std::unique_lock<std::mutex> lock(destination->mutex);
+		for (;;) {
+			destination->wakeup.wait(lock, [&] {
+				return destination->stopping || !destination->queue.empty();
+			});
+			if (destination->queue.empty()) {
+				return;
+			}
+			batch.swap(destination->queue);
+			lock.unlock();
+
+			uint64_t flushes = 0;
+			for (Buffer* buffer : batch) {
+				if (buffer == NULL) {
+					destination->sink->flush();
+					++flushes;
+					continue;
+				}
+				destination->sink->write(buffer->text(), buffer->length);
+				if (buffer->sensorMonotonicNs != 0) {
+					NmeaStatistics::recordSensorToWire(buffer->type,
+							buffer->sensorMonotonicNs);
+				}
+				release(buffer);
+			}
+			batch.clear();
+
+			lock.lock();
+			if (flushes != 0) {
+				destination->flushCompleted += flushes;
+				destination->flushed.notify_all();
+			}
+		}
+	}
+
+	uint64_t typeSinks[Nmea_SentenceType_Count];
+	uint64_t anyTalker;
+	uint64_t decimated;
+	std::unordered_map<uint16_t, uint64_t> talkerSinks;
+
+	std::mutex poolMutex;
+	std::vector<Buffer*> pool;
+};
+
+const std::size_t NmeaRouter::maxSinks;
+const std::size_t NmeaRouter::defaultSize;
+
+NmeaRouter::NmeaRouter() :
+		pimpl(new impl) {
+}
+
+NmeaRouter::~NmeaRouter() {
+}
+
+std::size_t NmeaRouter::addSink(NmeaSink& sink, const NmeaRouteFilter& filter) {
+	return pimpl->add(sink, filter);
+}
+
+std::size_t NmeaRouter::route(Nmea_SentenceType type, const char* talkerid,
+		const char* sentence, std::size_t length, int64_t sensorMonotonicNs) {
+	return route(type, talkerid, [&](char* buffer, std::size_t size) {
+		std::memcpy(buffer, sentence, std::min(length, size));
+		return length;
+	}, sensorMonotonicNs);
+}
+
+void NmeaRouter::flush() {
+	pimpl->flush();
+}
+
+std::size_t NmeaRouter::sinks() const {
+	return pimpl->destinations.size();
+}
+
+uint64_t NmeaRouter::destinations(Nmea_SentenceType type,
+		const char* talkerid) {
+	return pimpl->match(type, talkerid);
+}
+
+char* NmeaRouter::allocate(std::size_t size) {
+	Buffer* buffer = pimpl->allocate(size);
+	buffer->references.store(1, std::memory_order_relaxed);
+	return buffer->text();
+}
+
+void NmeaRouter::release(char* text) {
+	pimpl->release(Buffer::of(text));
+}
+
+std::size_t NmeaRouter::send(char* text, std::size_t length, uint64_t sinks,
+		Nmea_SentenceType type, int64_t sensorMonotonicNs) {
+	Buffer* buffer = Buffer::of(text);
+	buffer->type = type;
+	buffer->length = length;
+	buffer->sensorMonotonicNs = sensorMonotonicNs;
+	return pimpl->send(buffer, sinks);
+}
@@ -0,0 +1,19 @@
+/*
+ * NmeaSink.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaSink.h"
+#include "NmeaProbes.h"
+
+void NmeaSink::write(const char* sentence, std::size_t length) {
+	NP_PROBE3(sink_write, this, length, sentence);
+	writeSentence(sentence, length);
+}
+
+void NmeaSink::flush() {
+	NP_PROBE1(sink_flush, this);
+	flushSentences();
+}
@@ -0,0 +1,419 @@
+/*
+ * NmeaStatistics.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaStatistics.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/// @cond
+namespace {
+
+enum Counter {
+	CounterComposed, CounterBytes, CounterInvalidFields, CounterErrors, CounterCount
+};
+
+const std::size_t shardCount = 32;
+
+struct alignas(64) Shard {
+	std::atomic<uint64_t> counters[Nmea_SentenceType_Count][CounterCount];
+};
+
+Shard shards[shardCount];
+std::atomic<unsigned> nextShard(0);
+
+/*
+ * Threads are spread over the shards round robin on first use.
+ */
+Shard& threadShard() {
+	static thread_local Shard* shard = &shards[nextShard.fetch_add(1,
+			std::memory_order_relaxed) % shardCount];
+	return *shard;
+}
+
+void add(std::atomic<uint64_t>& counter, uint64_t value) {
+	counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+/*
+ * Log-linear histogram: values below 32 ns have a bucket each, then every
+ * power of two is split in 32 equal buckets, up to 2^41 ns (about 36 min).
+ */
+enum Latency {
+	LatencyCompose, LatencySensorToWire, LatencyCount
+};
+
+const int subBucketBits = 5;
+const int64_t subBuckets = 1 << subBucketBits;
+const int maxExponent = 40;
+const std::size_t bucketCount = (maxExponent - subBucketBits + 2) * subBuckets;
+
+/*
+ * Histograms are only written by sampled calls, so fewer shards than
+ * counters are enough.
+ */
+const std::size_t histogramShardCount = 8;
+
+struct alignas(64) HistogramShard {
+	std::atomic<uint64_t> buckets[LatencyCount][Nmea_SentenceType_Count][bucketCount];
+	std::atomic<uint64_t> sumsNs[LatencyCount][Nmea_SentenceType_Count];
+};
+
+HistogramShard histogramShards[histogramShardCount];
+std::atomic<unsigned> latencySampling(64);
+
+HistogramShard& threadHistogramShard() {
+	static thread_local HistogramShard* shard =
+			&histogramShards[nextShard.fetch_add(1, std::memory_order_relaxed)
+					% histogramShardCount];
+	return *shard;
+}
+
+/*
+ * Returns true once every latencySampling calls of a histogram on the calling
+ * thread. Each histogram counts its own calls, so that calls interleaved in a
+ * fixed pattern do not all land on the same histogram. A lowered rate applies
+ * from the next call.
+ */
+bool sampled(Latency latency, Nmea_SentenceType type) {
+	static thread_local unsigned countdowns[LatencyCount][Nmea_SentenceType_Count] =
+			{ };
+	unsigned& countdown = countdowns[latency][type];
+	unsigned everyN = latencySampling.load(std::memory_order_relaxed);
+	if (everyN == 0) {
+		return false;
+	}
+	if (countdown == 0 || countdown > everyN) {
+		countdown = everyN;
+	}
+	return --countdown == 0;
+}
+
+int64_t monotonicNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::size_t bucketIndex(int64_t value) {
+	if (value < subBuckets) {
+		return value < 0 ? 0 : value;
+	}
+	int exponent = 63 - __builtin_clzll(value);
+	if (exponent > maxExponent) {
+		return bucketCount - 1;
+	}
+	return (exponent - subBucketBits + 1) * subBuckets
+			+ ((value >> (exponent - subBucketBits)) & (subBuckets - 1));
+}
+
+/*
+ * Highest value falling in a bucket.
+ */
+int64_t bucketHighest(std::size_t index) {
+	if (index < static_cast<std::size_t>(subBuckets)) {
+		return index;
+	}
+	int shift = index / subBuckets - 1;
+	int64_t lowest = (subBuckets + index % subBuckets) << shift;
+	return lowest + (int64_t(1) << shift) - 1;
+}
+
+void addLatency(Latency latency, Nmea_SentenceType type, int64_t ns) {
+	HistogramShard& shard = threadHistogramShard();
+	add(shard.buckets[latency][type][bucketIndex(ns)], 1);
+	add(shard.sumsNs[latency][type], ns < 0 ? 0 : ns);
+}
+
+void percentiles(Latency latency, Nmea_SentenceType type,
+		NmeaLatencyPercentiles& result) {
+	uint64_t merged[bucketCount] = { };
+	uint64_t samples = 0;
+	uint64_t sumNs = 0;
+	for (const HistogramShard& shard : histogramShards) {
+		sumNs += shard.sumsNs[latency][type].load(std::memory_order_relaxed);
+		const std::atomic<uint64_t>* buckets = shard.buckets[latency][type];
+		for (std::size_t i = 0; i < bucketCount; ++i) {
+			uint64_t count = buckets[i].load(std::memory_order_relaxed);
+			merged[i] += count;
+			samples += count;
+		}
+	}
+
+	std::memset(&result, 0, sizeof(result));
+	result.samples = samples;
+	result.sumNs = sumNs;
+	if (samples == 0) {
+		return;
+	}
+	struct Quantile {
+		double quantile;
+		int64_t NmeaLatencyPercentiles::*value;
+	};
+	const Quantile quantiles[] = { { 0.5, &NmeaLatencyPercentiles::p50Ns }, {
+			0.99, &NmeaLatencyPercentiles::p99Ns }, { 0.999,
+			&NmeaLatencyPercentiles::p999Ns } };
+	std::size_t next = 0;
+	uint64_t seen = 0;
+	for (std::size_t i = 0; i < bucketCount; ++i) {
+		if (merged[i] == 0) {
+			continue;
+		}
+		seen += merged[i];
+		while (next < 3 && seen >= quantiles[next].quantile * samples) {
+			result.*quantiles[next].value = bucketHighest(i);
+			++next;
+		}
+		result.maxNs = bucketHighest(i);
+	}
+}
+
+struct LatencyMetric {
+	const char* name;
+	const char* help;
+	NmeaLatencyPercentiles (NmeaLatencySnapshot::*histogram)[Nmea_SentenceType_Count];
+};
+
+const LatencyMetric latencyMetrics[] = { { "nmea_compose_latency_seconds",
+		"Time spent composing a sentence, sampled.",
+		&NmeaLatencySnapshot::compose }, {
+		"nmea_sensor_to_wire_latency_seconds",
+		"Time from sensor sample to sink handoff, sampled.",
+		&NmeaLatencySnapshot::sensorToWire } };
+
+struct Metric {
+	const char* name;
+	const char* help;
+	uint64_t NmeaSentenceCounters::*counter;
+};
+
+const Metric metrics[] = {
+		{ "nmea_sentences_composed_total", "Sentences composed.",
+				&NmeaSentenceCounters::composed },
+		{ "nmea_bytes_total", "Bytes of composed sentences.",
+				&NmeaSentenceCounters::bytes },
+		{ "nmea_invalid_fields_total", "Fields flagged as invalid.",
+				&NmeaSentenceCounters::invalidFields },
+		{ "nmea_errors_total", "Composition errors.",
+				&NmeaSentenceCounters::errors } };
+
+std::system_error systemError(const std::string& what) {
+	return std::system_error(errno, std::generic_category(), what);
+}
+
+/*
+ * Sends the whole text over a connected socket. A scraper closing early is
+ * reported as EPIPE instead of raising SIGPIPE.
+ */
+bool sendAll(int fd, const std::string& text) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+	int on = 1;
+	if (setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on)) != 0) {
+		return false;
+	}
+#endif
+#ifdef MSG_NOSIGNAL
+	const int flags = MSG_NOSIGNAL;
+#else
+	const int flags = 0;
+#endif
+	const char* p = text.data();
+	std::size_t left = text.size();
+	while (left > 0) {
+		ssize_t written = send(fd, p, left, flags);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		p += written;
+		left -= written;
+	}
+	return true;
+}
+
+} // namespace
+/// @endcond
+
+void NmeaStatistics::record(Nmea_SentenceType type, std::size_t bytes,
+		std::size_t invalidFields, bool error, int64_t sampleStartNs) {
+	if (sampleStartNs != 0) {
+		addLatency(LatencyCompose, type, monotonicNs() - sampleStartNs);
+	}
+	std::atomic<uint64_t>* counters = threadShard().counters[type];
+	add(counters[CounterComposed], 1);
+	add(counters[CounterBytes], bytes);
+	if (invalidFields != 0) {
+		add(counters[CounterInvalidFields], invalidFields);
+	}
+	if (error) {
+		add(counters[CounterErrors], 1);
+	}
+}
+
+int64_t NmeaStatistics::startSample(Nmea_SentenceType type) {
+	return sampled(LatencyCompose, type) ? monotonicNs() : 0;
+}
+
+void NmeaStatistics::recordSensorToWire(Nmea_SentenceType type,
+		int64_t sensorMonotonicNs) {
+	if (sampled(LatencySensorToWire, type)) {
+		addLatency(LatencySensorToWire, type, monotonicNs() - sensorMonotonicNs);
+	}
+}
+
+void NmeaStatistics::setLatencySampling(unsigned everyN) {
+	latencySampling.store(everyN, std::memory_order_relaxed);
+}
+
+void NmeaStatistics::latencySnapshot(NmeaLatencySnapshot& snapshot) {
+	for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+		percentiles(LatencyCompose, static_cast<Nmea_SentenceType>(type),
+				snapshot.compose[type]);
+		percentiles(LatencySensorToWire, static_cast<Nmea_SentenceType>(type),
+				snapshot.sensorToWire[type]);
+	}
+}
+
+void NmeaStatistics::snapshot(NmeaStatisticsSnapshot& snapshot) {
+	std::memset(&snapshot, 0, sizeof(snapshot));
+	for (const Shard& shard : shards) {
+		for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+			const std::atomic<uint64_t>* counters = shard.counters[type];
+			NmeaSentenceCounters& sum = snapshot.sentences[type];
+			sum.composed += counters[CounterComposed].load(
+					std::memory_order_relaxed);
+			sum.bytes += counters[CounterBytes].load(std::memory_order_relaxed);
+			sum.invalidFields += counters[CounterInvalidFields].load(
+					std::memory_order_relaxed);
+			sum.errors += counters[CounterErrors].load(
+					std::memory_order_relaxed);
+		}
+	}
+}
+
+void NmeaStatistics::reset() {
+	for (Shard& shard : shards) {
+		for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+			for (int counter = 0; counter < CounterCount; ++counter) {
+				shard.counters[type][counter].store(0,
+						std::memory_order_relaxed);
+			}
+		}
+	}
+	for (HistogramShard& shard : histogramShards) {
+		for (auto& latency : shard.buckets) {
+			for (auto& buckets : latency) {
+				for (std::atomic<uint64_t>& bucket : buckets) {
+					bucket.store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+		for (auto& latency : shard.sumsNs) {
+			for (std::atomic<uint64_t>& sum : latency) {
+				sum.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+void NmeaStatistics::writePrometheus(std::string& text) {
+	NmeaStatisticsSnapshot counters;
+	snapshot(counters);
+
+	std::ostringstream out;
+	for (const Metric& metric : metrics) {
+		out << "# HELP " << metric.name << ' ' << metric.help << '\n';
+		out << "# TYPE " << metric.name << " counter\n";
+		for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+			out << metric.name << "{type=\""
+					<< static_cast<Nmea_SentenceType>(type) << "\"} "
+					<< counters.sentences[type].*metric.counter << '\n';
+		}
+	}
+
+	NmeaLatencySnapshot latencies;
+	latencySnapshot(latencies);
+	for (const LatencyMetric& metric : latencyMetrics) {
+		out << "# HELP " << metric.name << ' ' << metric.help << '\n';
+		out << "# TYPE " << metric.name << " summary\n";
+		for (int type = 0; type < Nmea_SentenceType_Count; ++type) {
+			const NmeaLatencyPercentiles& latency =
+					(latencies.*metric.histogram)[type];
+			std::ostringstream label;
+			label << "type=\"" << static_cast<Nmea_SentenceType>(type) << '"';
+			const std::pair<const char*, int64_t> quantiles[] = { { "0.5",
+					latency.p50Ns }, { "0.99", latency.p99Ns }, { "0.999",
+					latency.p999Ns } };
+			for (const auto& quantile : quantiles) {
+				out << metric.name << '{' << label.str() << ",quantile=\""
+						<< quantile.first << "\"} " << quantile.second * 1e-9
+						<< '\n';
+			}
+			out << metric.name << "_sum{" << label.str() << "} "
+					<< latency.sumNs * 1e-9 << '\n';
+			out << metric.name << "_count{" << label.str() << "} "
+					<< latency.samples << '\n';
+		}
+	}
+	text = out.str();
+}
+
+void NmeaStatistics::exportPrometheusFile(const std::string& path) {
+	std::string text;
+	writePrometheus(text);
+
+	std::string temporaryPath = path + ".tmp";
+	FILE* file = std::fopen(temporaryPath.c_str(), "w");
+	if (file == NULL) {
+		throw systemError("Cannot create " + temporaryPath);
+	}
+	bool written = std::fwrite(text.data(), 1, text.size(), file)
+			== text.size();
+	written = std::fclose(file) == 0 && written;
+	if (!written || std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+		int error = errno;
+		std::remove(temporaryPath.c_str());
+		errno = error;
+		throw systemError("Cannot write " + path);
+	}
+}
+
+void NmeaStatistics::exportPrometheusSocket(const std::string& path) {
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path)) {
+		errno = ENAMETOOLONG;
+		throw systemError("Cannot connect to " + path);
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size());
+
+	std::string text;
+	writePrometheus(text);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		throw systemError("Cannot create socket");
+	}
+	if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address))
+			!= 0 || !sendAll(fd, text)) {
+		int error = errno;
+		close(fd);
+		errno = error;
+		throw systemError("Cannot send statistics to " + path);
+	}
+	close(fd);
+}
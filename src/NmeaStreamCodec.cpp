@@ -0,0 +1,574 @@
+/*
+ * NmeaStreamCodec.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaStreamCodec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// @cond
+namespace {
+
+/*
+ * Binary adaptive range coder, as used by LZMA. Probabilities are 11 bit
+ * estimates of the next bit being zero.
+ */
+const int probabilityBits = 11;
+const uint16_t probabilityInit = 1 << (probabilityBits - 1);
+const int adaptationShift = 5;
+const uint32_t topValue = 1 << 24;
+
+class RangeEncoder {
+public:
+	RangeEncoder() {
+		reset();
+	}
+
+	void reset() {
+		low = 0;
+		range = 0xFFFFFFFF;
+		cache = 0;
+		cacheSize = 1;
+		out.clear();
+	}
+
+	void bit(uint16_t& probability, unsigned value) {
+		uint32_t bound = (range >> probabilityBits) * probability;
+		if (value == 0) {
+			range = bound;
+			probability += ((1 << probabilityBits) - probability)
+					>> adaptationShift;
+		} else {
+			low += bound;
+			range -= bound;
+			probability -= probability >> adaptationShift;
+		}
+		while (range < topValue) {
+			range <<= 8;
+			shiftLow();
+		}
+	}
+
+	void tree(uint16_t* probabilities, int bits, unsigned value) {
+		unsigned node = 1;
+		for (int i = bits - 1; i >= 0; --i) {
+			unsigned b = (value >> i) & 1;
+			bit(probabilities[node], b);
+			node = (node << 1) | b;
+		}
+	}
+
+	void flush() {
+		for (int i = 0; i < 5; ++i) {
+			shiftLow();
+		}
+	}
+
+	std::string out;
+
+private:
+	void shiftLow() {
+		if (static_cast<uint32_t>(low) < 0xFF000000 || (low >> 32) != 0) {
+			uint8_t carry = static_cast<uint8_t>(low >> 32);
+			uint8_t temp = cache;
+			do {
+				out.push_back(static_cast<char>(temp + carry));
+				temp = 0xFF;
+			} while (--cacheSize != 0);
+			cache = static_cast<uint8_t>(low >> 24);
+		}
+		++cacheSize;
+		low = (low & 0x00FFFFFF) << 8;
+	}
+
+	uint64_t low;
+	uint32_t range;
+	uint8_t cache;
+	uint64_t cacheSize;
+};
+
+class RangeDecoder {
+public:
+	RangeDecoder(const char* data, std::size_t length) :
+			data(reinterpret_cast<const uint8_t*>(data)), length(length), position(
+					0), range(0xFFFFFFFF), code(0) {
+		for (int i = 0; i < 5; ++i) {
+			code = (code << 8) | next();
+		}
+	}
+
+	unsigned bit(uint16_t& probability) {
+		uint32_t bound = (range >> probabilityBits) * probability;
+		unsigned value;
+		if (code < bound) {
+			range = bound;
+			probability += ((1 << probabilityBits) - probability)
+					>> adaptationShift;
+			value = 0;
+		} else {
+			code -= bound;
+			range -= bound;
+			probability -= probability >> adaptationShift;
+			value = 1;
+		}
+		while (range < topValue) {
+			range <<= 8;
+			code = (code << 8) | next();
+		}
+		return value;
+	}
+
+	unsigned tree(uint16_t* probabilities, int bits) {
+		unsigned node = 1;
+		for (int i = 0; i < bits; ++i) {
+			node = (node << 1) | bit(probabilities[node]);
+		}
+		return node - (1u << bits);
+	}
+
+	/*
+	 * A valid frame never needs more than one byte past its end; stops
+	 * garbage input from decoding forever.
+	 */
+	bool exhausted() const {
+		return position >= length + 4;
+	}
+
+private:
+	uint8_t next() {
+		uint8_t value = position < length ? data[position] : 0;
+		++position;
+		return value;
+	}
+
+	const uint8_t* data;
+	std::size_t length;
+	std::size_t position;
+	uint32_t range;
+	uint32_t code;
+};
+
+const std::size_t maxKeys = 64;
+const unsigned newKey = 127;
+const std::size_t maxKeyLength = 15;
+const std::size_t maxFields = 127;
+const std::size_t maxFieldLength = 127;
+const std::size_t maxTailLength = 15;
+const std::size_t maxRawLength = 65535;
+const std::size_t fieldContexts = 32;
+
+/*
+ * Adaptive statistics, identical on both ends of the link.
+ */
+struct Models {
+	Models() {
+		uint16_t* first = &more;
+		uint16_t* last = reinterpret_cast<uint16_t*>(this + 1);
+		for (uint16_t* p = first; p < last; ++p) {
+			*p = probabilityInit;
+		}
+	}
+
+	uint16_t more;
+	uint16_t structured;
+	uint16_t exclamation;
+	uint16_t sameFieldCount;
+	uint16_t checksumMatches;
+	uint16_t key[128];
+	uint16_t keyLength[16];
+	uint16_t keyChar[256];
+	uint16_t fieldCount[128];
+	uint16_t changed[maxKeys][fieldContexts];
+	uint16_t prefixLength[fieldContexts][128];
+	uint16_t suffixLength[fieldContexts][128];
+	uint16_t fieldChar[fieldContexts][256];
+	uint16_t checksumChar[256];
+	uint16_t tailLength[16];
+	uint16_t tailChar[256];
+	uint16_t rawLength[2][256];
+	uint16_t rawChar[256];
+};
+
+/*
+ * Last sentence seen for one address field.
+ */
+struct Slot {
+	std::string key;
+	std::vector<std::string> fields;
+};
+
+/*
+ * State shared by encoder and decoder: statistics and previous sentences.
+ */
+class CodecState {
+public:
+	CodecState() :
+			models(new Models), nextSlot(0) {
+	}
+
+	void reset() {
+		models.reset(new Models);
+		slots.clear();
+		nextSlot = 0;
+	}
+
+	std::size_t find(const char* key, std::size_t length) const {
+		for (std::size_t i = 0; i < slots.size(); ++i) {
+			if (slots[i].key.size() == length
+					&& std::memcmp(slots[i].key.data(), key, length) == 0) {
+				return i;
+			}
+		}
+		return slots.size();
+	}
+
+	/*
+	 * Table slot for a new address field, recycled round robin when full.
+	 */
+	std::size_t insert(const char* key, std::size_t length) {
+		std::size_t slot;
+		if (slots.size() < maxKeys) {
+			slot = slots.size();
+			slots.push_back(Slot());
+		} else {
+			slot = nextSlot;
+			nextSlot = (nextSlot + 1) % maxKeys;
+		}
+		slots[slot].key.assign(key, length);
+		slots[slot].fields.clear();
+		return slot;
+	}
+
+	static std::size_t fieldContext(std::size_t field) {
+		return field < fieldContexts ? field : fieldContexts - 1;
+	}
+
+	std::unique_ptr<Models> models;
+	std::vector<Slot> slots;
+	std::size_t nextSlot;
+};
+
+const char hexDigits[] = "0123456789ABCDEF";
+
+struct Field {
+	const char* data;
+	std::size_t length;
+};
+
+std::size_t commonPrefix(const std::string& previous, const Field& field) {
+	std::size_t length = std::min(previous.size(), field.length);
+	std::size_t i = 0;
+	while (i < length && previous[i] == field.data[i]) {
+		++i;
+	}
+	return i;
+}
+
+} // namespace
+/// @endcond
+
+class NmeaStreamEncoder::impl {
+public:
+	/*
+	 * Splits a sentence into address, fields, checksum and tail. Returns false
+	 * for anything the structured coding cannot represent.
+	 */
+	bool parse(const char* sentence, std::size_t length) {
+		if (length < 4 || (sentence[0] != '$' && sentence[0] != '!')) {
+			return false;
+		}
+		const char* star = static_cast<const char*>(std::memchr(sentence, '*',
+				length));
+		if (star == NULL || sentence + length - star < 3) {
+			return false;
+		}
+		tail = star + 3;
+		tailLength = sentence + length - tail;
+		if (tailLength > maxTailLength) {
+			return false;
+		}
+
+		checksum = 0;
+		for (const char* p = sentence + 1; p < star; ++p) {
+			checksum ^= static_cast<uint8_t>(*p);
+		}
+		checksumText = star + 1;
+
+		fields.clear();
+		Field field = { sentence + 1, 0 };
+		for (const char* p = sentence + 1; p <= star; ++p) {
+			if (p == star || *p == ',') {
+				field.length = p - field.data;
+				if (field.length > maxFieldLength) {
+					return false;
+				}
+				fields.push_back(field);
+				field.data = p + 1;
+			}
+		}
+		return fields[0].length <= maxKeyLength
+				&& fields.size() - 1 <= maxFields;
+	}
+
+	void encodeRaw(const char* sentence, std::size_t length) {
+		Models& m = *state.models;
+		// Parts of maxRawLength bytes are followed by another part, possibly
+		// empty, so that input of any length is sent whole
+		for (;;) {
+			std::size_t part = std::min(length, maxRawLength);
+			coder.tree(m.rawLength[0], 8, part >> 8);
+			coder.tree(m.rawLength[1], 8, part & 0xFF);
+			for (std::size_t i = 0; i < part; ++i) {
+				coder.tree(m.rawChar, 8, static_cast<uint8_t>(sentence[i]));
+			}
+			if (part < maxRawLength) {
+				return;
+			}
+			sentence += part;
+			length -= part;
+		}
+	}
+
+	void encode(const char* sentence, std::size_t length) {
+		Models& m = *state.models;
+		coder.bit(m.more, 1);
+
+		bool structured = parse(sentence, length);
+		coder.bit(m.structured, structured);
+		if (!structured) {
+			encodeRaw(sentence, length);
+			return;
+		}
+
+		coder.bit(m.exclamation, sentence[0] == '!');
+
+		const Field& key = fields[0];
+		std::size_t slot = state.find(key.data, key.length);
+		if (slot < state.slots.size()) {
+			coder.tree(m.key, 7, slot);
+		} else {
+			coder.tree(m.key, 7, newKey);
+			coder.tree(m.keyLength, 4, key.length);
+			for (std::size_t i = 0; i < key.length; ++i) {
+				coder.tree(m.keyChar, 8, static_cast<uint8_t>(key.data[i]));
+			}
+			slot = state.insert(key.data, key.length);
+		}
+
+		std::vector<std::string>& previous = state.slots[slot].fields;
+		std::size_t count = fields.size() - 1;
+		coder.bit(m.sameFieldCount, count == previous.size());
+		if (count != previous.size()) {
+			coder.tree(m.fieldCount, 7, count);
+		}
+
+		for (std::size_t i = 0; i < count; ++i) {
+			const Field& field = fields[i + 1];
+			const std::size_t context = CodecState::fieldContext(i);
+			if (i < previous.size()) {
+				bool changed = previous[i].size() != field.length
+						|| std::memcmp(previous[i].data(), field.data,
+								field.length) != 0;
+				coder.bit(m.changed[slot][context], changed);
+				if (!changed) {
+					continue;
+				}
+			}
+			std::size_t prefix =
+					i < previous.size() ? commonPrefix(previous[i], field) : 0;
+			coder.tree(m.prefixLength[context], 7, prefix);
+			coder.tree(m.suffixLength[context], 7, field.length - prefix);
+			for (std::size_t c = prefix; c < field.length; ++c) {
+				coder.tree(m.fieldChar[context], 8,
+						static_cast<uint8_t>(field.data[c]));
+			}
+		}
+
+		previous.resize(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			previous[i].assign(fields[i + 1].data, fields[i + 1].length);
+		}
+
+		bool matches = checksumText[0] == hexDigits[checksum >> 4]
+				&& checksumText[1] == hexDigits[checksum & 0xF];
+		coder.bit(m.checksumMatches, matches);
+		if (!matches) {
+			coder.tree(m.checksumChar, 8, static_cast<uint8_t>(checksumText[0]));
+			coder.tree(m.checksumChar, 8, static_cast<uint8_t>(checksumText[1]));
+		}
+
+		coder.tree(m.tailLength, 4, tailLength);
+		for (std::size_t i = 0; i < tailLength; ++i) {
+			coder.tree(m.tailChar, 8, static_cast<uint8_t>(tail[i]));
+		}
+	}
+
+	void finish(std::string& frame) {
+		coder.bit(state.models->more, 0);
+		coder.flush();
+		frame.swap(coder.out);
+		coder.reset();
+	}
+
+	CodecState state;
+	RangeEncoder coder;
+
+	std::vector<Field> fields;
+	uint8_t checksum;
+	const char* checksumText;
+	const char* tail;
+	std::size_t tailLength;
+};
+
+NmeaStreamEncoder::NmeaStreamEncoder() :
+		pimpl(new impl) {
+}
+
+NmeaStreamEncoder::~NmeaStreamEncoder() {
+}
+
+void NmeaStreamEncoder::encode(const char* sentence, std::size_t length) {
+	pimpl->encode(sentence, length);
+}
+
+void NmeaStreamEncoder::finish(std::string& frame) {
+	pimpl->finish(frame);
+}
+
+void NmeaStreamEncoder::reset() {
+	pimpl->state.reset();
+	pimpl->coder.reset();
+}
+
+class NmeaStreamDecoder::impl {
+public:
+	bool decodeSentence(RangeDecoder& coder) {
+		Models& m = *state.models;
+		sentence.clear();
+
+		if (!coder.bit(m.structured)) {
+			std::size_t length;
+			do {
+				length = coder.tree(m.rawLength[0], 8) << 8;
+				length |= coder.tree(m.rawLength[1], 8);
+				for (std::size_t i = 0; i < length; ++i) {
+					sentence.push_back(
+							static_cast<char>(coder.tree(m.rawChar, 8)));
+				}
+			} while (length == maxRawLength);
+			return true;
+		}
+
+		sentence.push_back(coder.bit(m.exclamation) ? '!' : '$');
+
+		std::size_t slot = coder.tree(m.key, 7);
+		if (slot == newKey) {
+			std::size_t length = coder.tree(m.keyLength, 4);
+			key.clear();
+			for (std::size_t i = 0; i < length; ++i) {
+				key.push_back(static_cast<char>(coder.tree(m.keyChar, 8)));
+			}
+			slot = state.insert(key.data(), key.size());
+		} else if (slot >= state.slots.size()) {
+			return false;
+		}
+		sentence.append(state.slots[slot].key);
+
+		std::vector<std::string>& previous = state.slots[slot].fields;
+		std::size_t count = previous.size();
+		if (!coder.bit(m.sameFieldCount)) {
+			count = coder.tree(m.fieldCount, 7);
+		}
+
+		for (std::size_t i = 0; i < count; ++i) {
+			const std::size_t context = CodecState::fieldContext(i);
+			sentence.push_back(',');
+			if (i < previous.size() && !coder.bit(m.changed[slot][context])) {
+				sentence.append(previous[i]);
+				continue;
+			}
+			std::size_t prefix = coder.tree(m.prefixLength[context], 7);
+			std::size_t suffix = coder.tree(m.suffixLength[context], 7);
+			if (i < previous.size() && prefix <= previous[i].size()) {
+				sentence.append(previous[i], 0, prefix);
+			} else if (prefix != 0) {
+				return false;
+			}
+			for (std::size_t c = 0; c < suffix; ++c) {
+				sentence.push_back(
+						static_cast<char>(coder.tree(m.fieldChar[context], 8)));
+			}
+		}
+
+		// Remember the fields of this sentence for the next one
+		previous.resize(count);
+		const char* p = sentence.data() + 1 + state.slots[slot].key.size();
+		for (std::size_t i = 0; i < count; ++i) {
+			const char* start = p + 1;
+			const char* end = static_cast<const char*>(std::memchr(start, ',',
+					sentence.data() + sentence.size() - start));
+			if (end == NULL) {
+				end = sentence.data() + sentence.size();
+			}
+			previous[i].assign(start, end);
+			p = end;
+		}
+
+		uint8_t checksum = 0;
+		for (std::size_t i = 1; i < sentence.size(); ++i) {
+			checksum ^= static_cast<uint8_t>(sentence[i]);
+		}
+		sentence.push_back('*');
+		if (coder.bit(m.checksumMatches)) {
+			sentence.push_back(hexDigits[checksum >> 4]);
+			sentence.push_back(hexDigits[checksum & 0xF]);
+		} else {
+			sentence.push_back(static_cast<char>(coder.tree(m.checksumChar, 8)));
+			sentence.push_back(static_cast<char>(coder.tree(m.checksumChar, 8)));
+		}
+
+		std::size_t tailLength = coder.tree(m.tailLength, 4);
+		for (std::size_t i = 0; i < tailLength; ++i) {
+			sentence.push_back(static_cast<char>(coder.tree(m.tailChar, 8)));
+		}
+		return true;
+	}
+
+	std::size_t decode(const char* frame, std::size_t length, NmeaSink& sink) {
+		RangeDecoder coder(frame, length);
+		std::size_t decoded = 0;
+		while (!coder.exhausted() && coder.bit(state.models->more)) {
+			if (!decodeSentence(coder)) {
+				break;
+			}
+			sink.write(sentence.data(), sentence.size());
+			++decoded;
+		}
+		return decoded;
+	}
+
+	CodecState state;
+	std::string sentence;
+	std::string key;
+};
+
+NmeaStreamDecoder::NmeaStreamDecoder() :
+		pimpl(new impl) {
+}
+
+NmeaStreamDecoder::~NmeaStreamDecoder() {
+}
+
+std::size_t NmeaStreamDecoder::decode(const char* frame, std::size_t length,
+		NmeaSink& sink) {
+	return pimpl->decode(frame, length, sink);
+}
+
+void NmeaStreamDecoder::reset() {
+	pimpl->state.reset();
+}
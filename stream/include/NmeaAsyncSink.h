@@ -0,0 +1,122 @@
+/*
+ * NmeaAsyncSink.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAASYNCSINK_H_
+#define NMEAASYNCSINK_H_
+
+#include "NmeaStream.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Bounded output buffer awaited by the coroutines writing to it.
+ *
+ * Coroutines co_await write() for each sentence. The sentence and its CRLF
+ * are copied to the buffer right away while there is room; otherwise the
+ * writer is suspended, and resumed once the I/O side has made room for it,
+ * writers being served in the order they came. A slow link thus slows the
+ * streams down instead of growing a queue.
+ *
+ * The I/O side takes the buffered characters with pending() and releases
+ * them with consume() once written, for instance on a non-blocking socket:
+ * @code
+ * std::size_t length;
+ * const char* data = sink.pending(length);
+ * ssize_t written = ::send(fd, data, length, 0);
+ * if (written > 0) sink.consume(written);
+ * @endcode
+ * The writers made room for are resumed within consume().
+ */
+class NmeaAsyncSink {
+public:
+	/// @cond
+	class WriteAwaiter {
+	public:
+		bool await_ready();
+		void await_suspend(std::coroutine_handle<> writer) noexcept;
+		void await_resume() const noexcept {
+		}
+
+	private:
+		friend class NmeaAsyncSink;
+		WriteAwaiter(NmeaAsyncSink& sink, const NmeaSentenceView& sentence) :
+				sink(sink), sentence(sentence), next(nullptr) {
+		}
+
+		NmeaAsyncSink& sink;
+		NmeaSentenceView sentence;
+		std::coroutine_handle<> writer;
+		WriteAwaiter* next;
+	};
+	/// @endcond
+
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param [in] capacity Characters buffered, CRLF included.
+	 */
+	explicit NmeaAsyncSink(std::size_t capacity);
+
+	NmeaAsyncSink(const NmeaAsyncSink&) = delete;
+	NmeaAsyncSink& operator=(const NmeaAsyncSink&) = delete;
+
+	/**
+	 * @brief Awaits room for a sentence and writes it with CRLF.
+	 *
+	 * The sentence is copied: the view may be released once resumed.
+	 *
+	 * @throw std::length_error if the sentence and its CRLF are larger than
+	 * the whole buffer.
+	 */
+	WriteAwaiter write(const NmeaSentenceView& sentence) noexcept {
+		return WriteAwaiter(*this, sentence);
+	}
+
+	/**
+	 * @brief Buffered characters to be written out.
+	 *
+	 * @param [out] length Number of characters.
+	 * @return First character, valid until the next write() or consume().
+	 */
+	const char* pending(std::size_t& length) const noexcept {
+		length = end - begin;
+		return buffer.get() + begin;
+	}
+
+	/**
+	 * @brief Releases written characters, resuming the writers that now fit.
+	 *
+	 * @param [in] length Number of characters written out, at most the
+	 * length given by pending().
+	 */
+	void consume(std::size_t length);
+
+	/**
+	 * @brief Whether writers are waiting for room.
+	 */
+	bool waiting() const noexcept {
+		return first != nullptr;
+	}
+
+private:
+	bool fits(std::size_t length) const noexcept {
+		return end - begin + length <= capacity;
+	}
+
+	void append(const NmeaSentenceView& sentence) noexcept;
+
+	std::unique_ptr<char[]> buffer;
+	std::size_t capacity;
+	std::size_t begin;
+	std::size_t end;
+	WriteAwaiter* first;
+	WriteAwaiter* last;
+};
+
+#endif /* NMEAASYNCSINK_H_ */
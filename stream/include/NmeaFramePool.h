@@ -0,0 +1,70 @@
+/*
+ * NmeaFramePool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEAFRAMEPOOL_H_
+#define NMEAFRAMEPOOL_H_
+
+#include <cstddef>
+
+/**
+ * @brief Pool of coroutine frames.
+ *
+ * Frames are rounded up to a multiple of classSize and kept, once freed, in
+ * a free list of their size class local to the freeing thread, so a
+ * coroutine started again in a loop takes the frame of the previous one
+ * instead of going to the heap. Frames larger than maxPooled, and frames
+ * freed while their free list already holds maxFrames, go to the heap.
+ */
+class NmeaFramePool {
+public:
+	static const std::size_t classSize = 64; //!< Granularity of the frame sizes
+	static const std::size_t maxPooled = 4096; //!< Largest frame pooled
+	static const std::size_t maxFrames = 256; //!< Frames kept per size class and thread
+
+	/**
+	 * @brief Takes a frame of at least size bytes.
+	 *
+	 * @throw std::bad_alloc if the heap is exhausted.
+	 */
+	static void* allocate(std::size_t size);
+
+	/**
+	 * @brief Gives a frame back.
+	 *
+	 * @param [in] frame Frame taken with allocate().
+	 * @param [in] size Size it was taken with.
+	 */
+	static void deallocate(void* frame, std::size_t size) noexcept;
+
+	/**
+	 * @brief Number of frames kept by the calling thread.
+	 */
+	static std::size_t pooled() noexcept;
+
+private:
+	/**
+	 * @brief Private constructor. Prevents creating of class instance.
+	 */
+	NmeaFramePool();
+};
+
+/**
+ * @brief Base of the promise types, taking their frames from NmeaFramePool.
+ */
+struct NmeaPooledFrame {
+	/// Frame allocation
+	static void* operator new(std::size_t size) {
+		return NmeaFramePool::allocate(size);
+	}
+
+	/// Frame release
+	static void operator delete(void* frame, std::size_t size) noexcept {
+		NmeaFramePool::deallocate(frame, size);
+	}
+};
+
+#endif /* NMEAFRAMEPOOL_H_ */
@@ -0,0 +1,131 @@
+/*
+ * NmeaSensorFeed.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASENSORFEED_H_
+#define NMEASENSORFEED_H_
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded queue of sensor data awaited by a stream.
+ *
+ * The sensor side pushes data, the stream co_awaits it. A push to a feed a
+ * stream is waiting on resumes the stream at once, on the pushing thread,
+ * so that the sentences depending on the data are produced, and written to
+ * the sink, before push() returns.
+ *
+ * A full feed refuses the data: the sensor side decides whether to drop it
+ * or to retry once the stream has caught up.
+ *
+ * @tparam T Sensor data.
+ */
+template<typename T>
+class NmeaSensorFeed {
+public:
+	/// @cond
+	class NextAwaiter {
+	public:
+		bool await_ready() const noexcept {
+			return feed.count != 0 || feed.closed;
+		}
+		void await_suspend(std::coroutine_handle<> reader) noexcept {
+			feed.reader = reader;
+		}
+		std::optional<T> await_resume() {
+			if (feed.count == 0) {
+				return std::nullopt;
+			}
+			std::optional<T> data = std::move(feed.slots[feed.head]);
+			feed.slots[feed.head].reset();
+			feed.head = (feed.head + 1) % feed.slots.size();
+			--feed.count;
+			return data;
+		}
+
+	private:
+		friend class NmeaSensorFeed;
+		explicit NextAwaiter(NmeaSensorFeed& feed) :
+				feed(feed) {
+		}
+		NmeaSensorFeed& feed;
+	};
+	/// @endcond
+
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param [in] capacity Data held until awaited, at least 1.
+	 */
+	explicit NmeaSensorFeed(std::size_t capacity) :
+			slots(capacity != 0 ? capacity : 1), head(0), count(0), closed(
+					false) {
+	}
+
+	NmeaSensorFeed(const NmeaSensorFeed&) = delete;
+	NmeaSensorFeed& operator=(const NmeaSensorFeed&) = delete;
+
+	/**
+	 * @brief Queues data, resuming the stream waiting for it.
+	 *
+	 * @return false if the feed is full or closed, the data is then left out.
+	 */
+	bool push(T data) {
+		if (closed || count == slots.size()) {
+			return false;
+		}
+		slots[(head + count) % slots.size()].emplace(std::move(data));
+		++count;
+		wake();
+		return true;
+	}
+
+	/**
+	 * @brief Ends the feed.
+	 *
+	 * The data already queued is still given, then next() gives no value.
+	 */
+	void close() {
+		closed = true;
+		wake();
+	}
+
+	/**
+	 * @brief Awaits the next data.
+	 *
+	 * @return Awaitable giving the data, or no value once the feed is closed
+	 * and empty.
+	 */
+	NextAwaiter next() noexcept {
+		return NextAwaiter(*this);
+	}
+
+	/**
+	 * @brief Number of data queued.
+	 */
+	std::size_t size() const noexcept {
+		return count;
+	}
+
+private:
+	void wake() {
+		if (reader) {
+			std::exchange(reader, nullptr).resume();
+		}
+	}
+
+	std::vector<std::optional<T>> slots;
+	std::size_t head;
+	std::size_t count;
+	bool closed;
+	std::coroutine_handle<> reader;
+};
+
+#endif /* NMEASENSORFEED_H_ */
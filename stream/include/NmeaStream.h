@@ -0,0 +1,250 @@
+/*
+ * NmeaStream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEASTREAM_H_
+#define NMEASTREAM_H_
+
+#include "NmeaCoreEnums.h"
+#include "NmeaFramePool.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Sentence produced by a stream.
+ *
+ * The characters are owned by the stream and stay valid until the stream is
+ * resumed again. Not null terminated, no CRLF.
+ */
+struct NmeaSentenceView {
+	const char* data; //!< First character, the '$' or '!'
+	std::size_t length; //!< Number of characters
+	Nmea_SentenceType type; //!< Sentence type, Nmea_SentenceType_Count when not known
+};
+
+/**
+ * @brief Sentence to compose in the buffer of the stream.
+ *
+ * Made by nmeaCompose() and yielded by a stream.
+ */
+template<typename Composer>
+struct NmeaComposition {
+	Nmea_SentenceType type; //!< Sentence type
+	Composer composer; //!< Called with (char* buffer, std::size_t size), returns the sentence length
+};
+
+/**
+ * @brief Sentence composed in the buffer of the stream when yielded.
+ *
+ * @param [in] type Sentence type.
+ * @param [in] composer Called with the buffer and its size, returns the
+ * length of the sentence as the NmeaComposerCore composers do:
+ * @code
+ * co_yield nmeaCompose(Nmea_SentenceType_HDT, [&](char* buffer, std::size_t size) {
+ *     return NmeaComposerCore::composeHDT(buffer, size, "HE", validity, heading);
+ * });
+ * @endcode
+ */
+template<typename Composer>
+NmeaComposition<Composer> nmeaCompose(Nmea_SentenceType type,
+		Composer composer) {
+	return NmeaComposition<Composer> { type, std::move(composer) };
+}
+
+/**
+ * @brief Asynchronous generator of sentences.
+ *
+ * A stream is a coroutine yielding sentences, either views of its own or
+ * compositions, and free to co_await between them, for instance on an
+ * NmeaSensorFeed for the next sensor data:
+ * @code
+ * NmeaStream headings(NmeaSensorFeed<double>& feed) {
+ *     while (std::optional<double> heading = co_await feed.next()) {
+ *         co_yield nmeaCompose(Nmea_SentenceType_HDT, ...);
+ *     }
+ * }
+ * @endcode
+ * Sentences are composed in a buffer held by the stream and reused for
+ * every sentence, so that a stream allocates nothing but its frame, which
+ * comes from NmeaFramePool.
+ *
+ * It is consumed from another coroutine, one sentence at a time:
+ * @code
+ * while (const NmeaSentenceView* sentence = co_await stream.next()) { ... }
+ * @endcode
+ * The stream runs until its next sentence, then resumes the consumer
+ * directly. An exception leaving the stream is thrown by next().
+ *
+ * Streams, feeds and sinks are not thread safe: they run on the thread
+ * resuming them.
+ */
+class NmeaStream {
+public:
+	static const std::size_t inlineBuffer = 256; //!< Size of the buffer held in the frame
+
+	/// @cond
+	class promise_type: public NmeaPooledFrame {
+	public:
+		typedef std::coroutine_handle<promise_type> handle;
+
+		promise_type() :
+				sentence { buffer, 0, Nmea_SentenceType_Count }, capacity(
+						inlineBuffer) {
+		}
+
+		NmeaStream get_return_object() {
+			return NmeaStream(handle::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() noexcept {
+			return {};
+		}
+
+		struct Transfer {
+			bool await_ready() noexcept {
+				return false;
+			}
+			std::coroutine_handle<> await_suspend(handle producer) noexcept {
+				std::coroutine_handle<> consumer = producer.promise().consumer;
+				return consumer ? consumer : std::noop_coroutine();
+			}
+			void await_resume() noexcept {
+			}
+		};
+
+		Transfer final_suspend() noexcept {
+			return {};
+		}
+
+		Transfer yield_value(const NmeaSentenceView& view) noexcept {
+			sentence = view;
+			return {};
+		}
+
+		template<typename Composer>
+		Transfer yield_value(NmeaComposition<Composer> composition) {
+			std::size_t length = composition.composer(data(), capacity);
+			if (length >= capacity) {
+				grow(length + 1);
+				length = composition.composer(data(), capacity);
+			}
+			sentence = NmeaSentenceView { data(), length, composition.type };
+			return {};
+		}
+
+		void return_void() noexcept {
+		}
+
+		void unhandled_exception() noexcept {
+			exception = std::current_exception();
+		}
+
+	private:
+		friend class NmeaStream;
+
+		char* data() {
+			return heap ? heap.get() : buffer;
+		}
+
+		void grow(std::size_t size);
+
+		NmeaSentenceView sentence;
+		std::coroutine_handle<> consumer;
+		std::exception_ptr exception;
+		std::unique_ptr<char[]> heap;
+		std::size_t capacity;
+		char buffer[inlineBuffer];
+	};
+
+	class NextAwaiter {
+	public:
+		bool await_ready() const noexcept {
+			return !producer || producer.done();
+		}
+		std::coroutine_handle<> await_suspend(
+				std::coroutine_handle<> consumer) noexcept {
+			producer.promise().consumer = consumer;
+			return producer;
+		}
+		const NmeaSentenceView* await_resume() const;
+
+	private:
+		friend class NmeaStream;
+		explicit NextAwaiter(promise_type::handle producer) :
+				producer(producer) {
+		}
+		promise_type::handle producer;
+	};
+	/// @endcond
+
+	/**
+	 * @brief Stream of no sentence.
+	 */
+	NmeaStream() noexcept = default;
+
+	NmeaStream(NmeaStream&& other) noexcept :
+			coroutine(std::exchange(other.coroutine, nullptr)) {
+	}
+
+	NmeaStream& operator=(NmeaStream&& other) noexcept {
+		if (this != &other) {
+			reset();
+			coroutine = std::exchange(other.coroutine, nullptr);
+		}
+		return *this;
+	}
+
+	NmeaStream(const NmeaStream&) = delete;
+	NmeaStream& operator=(const NmeaStream&) = delete;
+
+	/**
+	 * @brief Destroys the coroutine where it is suspended.
+	 *
+	 * A stream waiting on an NmeaSensorFeed must not be destroyed while the
+	 * feed may still resume it.
+	 */
+	~NmeaStream() {
+		reset();
+	}
+
+	/**
+	 * @brief Awaits the next sentence.
+	 *
+	 * @return Awaitable giving the next sentence, or nullptr once the stream
+	 * has ended.
+	 * @throw Whatever exception left the stream.
+	 */
+	NextAwaiter next() noexcept {
+		return NextAwaiter(coroutine);
+	}
+
+	/**
+	 * @brief Whether the stream has ended.
+	 */
+	bool done() const noexcept {
+		return !coroutine || coroutine.done();
+	}
+
+private:
+	explicit NmeaStream(promise_type::handle coroutine) noexcept :
+			coroutine(coroutine) {
+	}
+
+	void reset() noexcept {
+		if (coroutine) {
+			coroutine.destroy();
+			coroutine = nullptr;
+		}
+	}
+
+	promise_type::handle coroutine;
+};
+
+#endif /* NMEASTREAM_H_ */
@@ -0,0 +1,106 @@
+/*
+ * NmeaTask.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#ifndef NMEATASK_H_
+#define NMEATASK_H_
+
+#include "NmeaFramePool.h"
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+class NmeaStream;
+class NmeaAsyncSink;
+
+/**
+ * @brief Coroutine run for its effects, such as one consuming a stream.
+ *
+ * It starts at once and runs until it first suspends; whoever resumes what
+ * it awaits (an NmeaSensorFeed push, an NmeaAsyncSink consume) then drives
+ * it. Its frame comes from NmeaFramePool and is destroyed with the task.
+ */
+class NmeaTask {
+public:
+	/// @cond
+	class promise_type: public NmeaPooledFrame {
+	public:
+		NmeaTask get_return_object() {
+			return NmeaTask(handle::from_promise(*this));
+		}
+		std::suspend_never initial_suspend() noexcept {
+			return {};
+		}
+		std::suspend_always final_suspend() noexcept {
+			return {};
+		}
+		void return_void() noexcept {
+		}
+		void unhandled_exception() noexcept {
+			exception = std::current_exception();
+		}
+
+	private:
+		friend class NmeaTask;
+		typedef std::coroutine_handle<promise_type> handle;
+
+		std::exception_ptr exception;
+	};
+	/// @endcond
+
+	NmeaTask(NmeaTask&& other) noexcept :
+			coroutine(std::exchange(other.coroutine, nullptr)) {
+	}
+
+	NmeaTask(const NmeaTask&) = delete;
+	NmeaTask& operator=(const NmeaTask&) = delete;
+	NmeaTask& operator=(NmeaTask&&) = delete;
+
+	/**
+	 * @brief Destroys the coroutine where it is suspended.
+	 */
+	~NmeaTask() {
+		if (coroutine) {
+			coroutine.destroy();
+		}
+	}
+
+	/**
+	 * @brief Whether the coroutine has run to its end.
+	 */
+	bool done() const noexcept {
+		return !coroutine || coroutine.done();
+	}
+
+	/**
+	 * @brief Throws the exception that ended the coroutine, if any.
+	 */
+	void get() const {
+		if (coroutine && coroutine.promise().exception) {
+			std::rethrow_exception(coroutine.promise().exception);
+		}
+	}
+
+private:
+	explicit NmeaTask(promise_type::handle coroutine) noexcept :
+			coroutine(coroutine) {
+	}
+
+	promise_type::handle coroutine;
+};
+
+/**
+ * @brief Writes every sentence of a stream to a sink.
+ *
+ * @param [in] stream Stream, owned by the task.
+ * @param [in] sink Sink, which must outlive the task. The task must not be
+ * destroyed while waiting for room in the sink.
+ * @return Task ending with the stream.
+ */
+NmeaTask nmeaPump(NmeaStream stream, NmeaAsyncSink& sink);
+
+#endif /* NMEATASK_H_ */
@@ -0,0 +1,70 @@
+/*
+ * NmeaAsyncSink.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaAsyncSink.h"
+
+#include <cstring>
+#include <stdexcept>
+
+NmeaAsyncSink::NmeaAsyncSink(std::size_t capacity) :
+		buffer(new char[capacity]), capacity(capacity), begin(0), end(0), first(
+				nullptr), last(nullptr) {
+}
+
+bool NmeaAsyncSink::WriteAwaiter::await_ready() {
+	if (sentence.length + 2 > sink.capacity) {
+		throw std::length_error("NMEA sentence larger than the sink buffer");
+	}
+	// Writers already waiting keep their turn
+	if (sink.first == nullptr && sink.fits(sentence.length + 2)) {
+		sink.append(sentence);
+		return true;
+	}
+	return false;
+}
+
+void NmeaAsyncSink::WriteAwaiter::await_suspend(
+		std::coroutine_handle<> writer) noexcept {
+	this->writer = writer;
+	if (sink.last != nullptr) {
+		sink.last->next = this;
+	} else {
+		sink.first = this;
+	}
+	sink.last = this;
+}
+
+void NmeaAsyncSink::consume(std::size_t length) {
+	begin += length;
+	if (begin >= end) {
+		begin = end = 0;
+	}
+	while (first != nullptr && fits(first->sentence.length + 2)) {
+		WriteAwaiter* awaiter = first;
+		first = awaiter->next;
+		if (first == nullptr) {
+			last = nullptr;
+		}
+		append(awaiter->sentence);
+		// The awaiter lives in the writer frame, gone once resumed
+		awaiter->writer.resume();
+	}
+}
+
+void NmeaAsyncSink::append(const NmeaSentenceView& sentence) noexcept {
+	std::size_t length = sentence.length + 2;
+	if (end + length > capacity) {
+		// Keeps the buffered characters contiguous for pending()
+		std::memmove(buffer.get(), buffer.get() + begin, end - begin);
+		end -= begin;
+		begin = 0;
+	}
+	std::memcpy(buffer.get() + end, sentence.data, sentence.length);
+	end += sentence.length;
+	buffer[end++] = '\r';
+	buffer[end++] = '\n';
+}
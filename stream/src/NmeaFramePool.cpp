@@ -0,0 +1,95 @@
+/*
+ * NmeaFramePool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaFramePool.h"
+
+#include <new>
+
+/// @cond
+namespace {
+
+struct FreeFrame {
+	FreeFrame* next;
+};
+
+struct FreeList {
+	FreeFrame* head = nullptr;
+	std::size_t count = 0;
+};
+
+const std::size_t classCount = NmeaFramePool::maxPooled
+		/ NmeaFramePool::classSize;
+
+/*
+ * Free lists of the thread, released with it.
+ */
+struct ThreadFrames {
+	FreeList lists[classCount];
+
+	~ThreadFrames() {
+		for (FreeList& list : lists) {
+			while (list.head != nullptr) {
+				FreeFrame* frame = list.head;
+				list.head = frame->next;
+				::operator delete(frame);
+			}
+		}
+	}
+};
+
+thread_local ThreadFrames threadFrames;
+
+std::size_t sizeClass(std::size_t size) {
+	return (size + NmeaFramePool::classSize - 1) / NmeaFramePool::classSize
+			- 1;
+}
+
+} // namespace
+/// @endcond
+
+const std::size_t NmeaFramePool::classSize;
+const std::size_t NmeaFramePool::maxPooled;
+const std::size_t NmeaFramePool::maxFrames;
+
+void* NmeaFramePool::allocate(std::size_t size) {
+	if (size == 0 || size > maxPooled) {
+		return ::operator new(size);
+	}
+	std::size_t index = sizeClass(size);
+	FreeList& list = threadFrames.lists[index];
+	if (list.head != nullptr) {
+		FreeFrame* frame = list.head;
+		list.head = frame->next;
+		--list.count;
+		return frame;
+	}
+	return ::operator new((index + 1) * classSize);
+}
+
+void NmeaFramePool::deallocate(void* frame, std::size_t size) noexcept {
+	if (size == 0 || size > maxPooled) {
+		::operator delete(frame);
+		return;
+	}
+	FreeList& list = threadFrames.lists[sizeClass(size)];
+	if (list.count == maxFrames) {
+		::operator delete(frame);
+		return;
+	}
+	FreeFrame* free = static_cast<FreeFrame*>(frame);
+	free->next = list.head;
+	list.head = free;
+	++list.count;
+}
+
+std::size_t NmeaFramePool::pooled() noexcept {
+	std::size_t count = 0;
+	for (const FreeList& list : threadFrames.lists) {
+		count += list.count;
+	}
+	return count;
+}
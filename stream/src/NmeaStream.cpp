@@ -0,0 +1,30 @@
+/*
+ * NmeaStream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaStream.h"
+
+const std::size_t NmeaStream::inlineBuffer;
+
+void NmeaStream::promise_type::grow(std::size_t size) {
+	heap.reset(new char[size]);
+	capacity = size;
+}
+
+const NmeaSentenceView* NmeaStream::NextAwaiter::await_resume() const {
+	if (!producer) {
+		return nullptr;
+	}
+	if (producer.done()) {
+		std::exception_ptr exception = std::exchange(
+				producer.promise().exception, nullptr);
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+		return nullptr;
+	}
+	return &producer.promise().sentence;
+}
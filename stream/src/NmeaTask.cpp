@@ -0,0 +1,16 @@
+/*
+ * NmeaTask.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaTask.h"
+#include "NmeaAsyncSink.h"
+#include "NmeaStream.h"
+
+NmeaTask nmeaPump(NmeaStream stream, NmeaAsyncSink& sink) {
+	while (const NmeaSentenceView* sentence = co_await stream.next()) {
+		co_await sink.write(*sentence);
+	}
+}
@@ -0,0 +1,511 @@
+
+#define BOOST_TEST_MODULE libNmeaComposer allocation audit
+#include <boost/test/included/unit_test.hpp>
+#include "NmeaComposer.h"
+#include "NmeaAisReceivers.h"
+#include "NmeaFleetEncoder.h"
+#include "NmeaJsonDelta.h"
+#include "NmeaStreamCodec.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+/*
+ * Every heap allocation of the process goes through countedMalloc(): global
+ * operator new always, and malloc/calloc/realloc too with glibc. Every
+ * operator delete, sized or not, goes through countedFree(). Counting is
+ * only enabled on the measuring thread while a measured loop runs, so that
+ * background threads (the NP_DEBUG log writer) are left out.
+ */
+namespace {
+
+thread_local bool counting = false;
+thread_local unsigned long allocations = 0;
+
+void count() {
+	if (counting) {
+		++allocations;
+	}
+}
+
+} // namespace
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void __libc_free(void* pointer);
+
+void* malloc(std::size_t size) {
+	count();
+	return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) {
+	::count();
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, std::size_t size) {
+	count();
+	return __libc_realloc(pointer, size);
+}
+}
+
+static void* countedMalloc(std::size_t size) {
+	return malloc(size);
+}
+
+/*
+ * Not std::free(), which the compiler sees paired with operator new and warns
+ * about under -Wmismatched-new-delete.
+ */
+static void countedFree(void* pointer) {
+	__libc_free(pointer);
+}
+#else
+static void* countedMalloc(std::size_t size) {
+	count();
+	return std::malloc(size);
+}
+
+static void countedFree(void* pointer) {
+	std::free(pointer);
+}
+#endif
+
+void* operator new(std::size_t size) {
+	void* pointer = countedMalloc(size == 0 ? 1 : size);
+	if (pointer == NULL) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return countedMalloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return countedMalloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* pointer) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+	countedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+	countedFree(pointer);
+}
+
+/*
+ * Average allocations per call of function, after one warm up call.
+ */
+static double allocationsPerCall(const std::function<void()>& function,
+		int calls = 1000) {
+	function();
+	allocations = 0;
+	counting = true;
+	for (int i = 0; i < calls; ++i) {
+		function();
+	}
+	counting = false;
+	return static_cast<double>(allocations) / calls;
+}
+
+struct Composer {
+	const char* name;
+	std::function<std::size_t(char*, std::size_t)> buffer;
+	std::function<void(std::string&)> string;
+};
+
+static std::vector<Composer> composers() {
+	static const std::string talker = "GP";
+	static const NmeaComposerValid validity = 0L;
+	static const boost::posix_time::time_duration mtime(12, 34, 56, 789000);
+	static const boost::gregorian::date mdate(2026, 10, 18);
+	static const std::vector<TransducerMeasurement> measurements = { { 'C',
+			23.4f, 'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "BARO" }, { 'H',
+			55.0f, 'P', "HUMIDITY" } };
+	static const AISPositionReportClassA classA = { 0, 224108000,
+			Nmea_NavigationStatus_UnderWayUsingEngine, 0, 12.3f,
+			Nmea_PositionAccuracy_DGPSQualityFix, -77.1428f, -12.0461f, 166.8f,
+			167, 30, Nmea_ManeuverIndicator_NotAvailable, Nmea_RAIM_NotInUse };
+	static const AISStandardClassBCSPositionReport classB = { 0, 760000123,
+			6.5f, Nmea_PositionAccuracy_UnaugmentedGNSSFix, -77.2f, -12.1f,
+			45.0f, 511, 60 };
+	static const AISMeteorologicalHydrologicalData metHydro = [] {
+		AISMeteorologicalHydrologicalData report = { 0, 2655001, 4.5f,
+				52.25f, Nmea_PositionAccuracy_UnaugmentedGNSSFix, 18, 12, 30,
+				{ } };
+		for (float& observation : report.observations) {
+			observation = NAN;
+		}
+		report.observations[Nmea_MetHydroField_AirTemperature] = 12.3f;
+		report.observations[Nmea_MetHydroField_AirPressure] = 1013.2f;
+		return report;
+	}();
+
+	std::vector<Composer> result;
+	result.push_back(
+			{ "composeRMC", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeRMC(buffer, size, talker, validity,
+						mtime, -12.0461, -77.0428, 12.5, 245.7, mdate, -2.3);
+			}, [](std::string& nmea) {
+				NmeaComposer::composeRMC(nmea, talker, validity, mtime, -12.0461,
+						-77.0428, 12.5, 245.7, mdate, -2.3);
+			} });
+	result.push_back(
+			{ "composeXDR", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeXDR(buffer, size, talker, validity,
+						measurements);
+			}, [](std::string& nmea) {
+				NmeaComposer::composeXDR(nmea, talker, validity, measurements);
+			} });
+	result.push_back(
+			{ "composeMWV", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeMWV(buffer, size, talker, validity,
+						47.2, Nmea_AngleReference_Relative, 14.1, 'N', 'A');
+			}, [](std::string& nmea) {
+				NmeaComposer::composeMWV(nmea, talker, validity, 47.2,
+						Nmea_AngleReference_Relative, 14.1, 'N', 'A');
+			} });
+	result.push_back(
+			{ "composeMWD", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeMWD(buffer, size, talker, validity,
+						212.4, 210.1, 14.1, 7.3);
+			}, [](std::string& nmea) {
+				NmeaComposer::composeMWD(nmea, talker, validity, 212.4, 210.1,
+						14.1, 7.3);
+			} });
+	result.push_back(
+			{ "composeHDT", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeHDT(buffer, size, talker, validity,
+						57.34);
+			}, [](std::string& nmea) {
+				NmeaComposer::composeHDT(nmea, talker, validity, 57.34);
+			} });
+	result.push_back(
+			{ "composeVLW", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeVLW(buffer, size, talker, validity,
+						20.70, 1.20);
+			}, [](std::string& nmea) {
+				NmeaComposer::composeVLW(nmea, talker, validity, 20.70, 1.20);
+			} });
+	result.push_back(
+			{ "composeVHW", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composeVHW(buffer, size, talker, validity,
+						57.3, 59.1, 11.2, 20.7);
+			}, [](std::string& nmea) {
+				NmeaComposer::composeVHW(nmea, talker, validity, 57.3, 59.1,
+						11.2, 20.7);
+			} });
+	result.push_back(
+			{ "composePRDID", [](char* buffer, std::size_t size) {
+				return NmeaComposer::composePRDID(buffer, size, validity, -1.25,
+						2.5, 57.34);
+			}, [](std::string& nmea) {
+				NmeaComposer::composePRDID(nmea, validity, -1.25, 2.5, 57.34);
+			} });
+	result.push_back(
+			{ "composeAISPositionReportClassA", [](char* buffer,
+					std::size_t size) {
+				return NmeaComposer::composeAISPositionReportClassA(buffer, size,
+						classA, 'A');
+			}, [](std::string& nmea) {
+				NmeaComposer::composeAISPositionReportClassA(nmea, classA, 'A');
+			} });
+	result.push_back(
+			{ "composeAISStandardClassBCSPositionReport", [](char* buffer,
+					std::size_t size) {
+				return NmeaComposer::composeAISStandardClassBCSPositionReport(
+						buffer, size, classB, 'B');
+			}, [](std::string& nmea) {
+				NmeaComposer::composeAISStandardClassBCSPositionReport(nmea,
+						classB, 'B');
+			} });
+	result.push_back(
+			{ "composeAISMeteorologicalHydrologicalData", [](char* buffer,
+					std::size_t size) {
+				return NmeaComposer::composeAISMeteorologicalHydrologicalData(
+						buffer, size, metHydro, 'A');
+			}, [](std::string& nmea) {
+				NmeaComposer::composeAISMeteorologicalHydrologicalData(nmea,
+						metHydro, 'A');
+			} });
+	return result;
+}
+
+BOOST_AUTO_TEST_CASE( bufferComposers )
+{
+	for (const Composer& composer : composers()) {
+		char buffer[256];
+		std::size_t length = 0;
+		double perCall = allocationsPerCall([&] {
+			length = composer.buffer(buffer, sizeof(buffer));
+		});
+		BOOST_CHECK_MESSAGE(perCall == 0,
+				composer.name << " allocates " << perCall << " times per call");
+
+		std::string nmea;
+		composer.string(nmea);
+		BOOST_CHECK_EQUAL(std::string(buffer, length), nmea);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( jsonDelta )
+{
+	char buffer[256], json[512];
+	NmeaJsonDelta delta(json, sizeof(json));
+	double perCall = allocationsPerCall([&] {
+		NmeaComposerCore::composeVHW(buffer, sizeof(buffer), "VW",
+				NmeaComposerValid(), 57.3, 59.1, 11.2, 20.7, &delta);
+	});
+	BOOST_CHECK_EQUAL(perCall, 0);
+}
+
+/*
+ * Monotonic arena reset every tick, the C++11 counterpart of a
+ * std::pmr::monotonic_buffer_resource behind std::pmr::string.
+ */
+class Arena {
+public:
+	Arena() :
+			used(0) {
+	}
+
+	void* allocate(std::size_t size) {
+		std::size_t start = (used + alignof(std::max_align_t) - 1)
+				& ~(alignof(std::max_align_t) - 1);
+		if (start + size > sizeof(storage)) {
+			throw std::bad_alloc();
+		}
+		used = start + size;
+		return storage + start;
+	}
+
+	void reset() {
+		used = 0;
+	}
+
+private:
+	alignas(std::max_align_t) char storage[16384];
+	std::size_t used;
+};
+
+template<typename T>
+struct ArenaAllocator {
+	typedef T value_type;
+
+	explicit ArenaAllocator(Arena& arena) :
+			arena(&arena) {
+	}
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) :
+			arena(other.arena) {
+	}
+
+	T* allocate(std::size_t count) {
+		return static_cast<T*>(arena->allocate(count * sizeof(T)));
+	}
+
+	void deallocate(T*, std::size_t) {
+	}
+
+	Arena* arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.arena == b.arena;
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.arena != b.arena;
+}
+
+typedef NmeaString<ArenaAllocator<char> > ArenaString;
+
+BOOST_AUTO_TEST_CASE( arenaStrings )
+{
+	const NmeaComposerValid validity = 0L;
+	const boost::posix_time::time_duration mtime(12, 34, 56, 789000);
+	const boost::gregorian::date mdate(2026, 10, 18);
+	// More measurements than the composers view on the stack
+	std::vector<TransducerMeasurement> measurements;
+	for (int i = 0; i < 24; ++i) {
+		measurements.push_back( { 'C', 20.0f + i, 'C', "T" });
+	}
+	AISMeteorologicalHydrologicalData report = AISMeteorologicalHydrologicalData();
+	NmeaMetHydro mapper;
+
+	std::string rmc, xdr;
+	NmeaComposer::composeRMC(rmc, "GP", validity, mtime, -12.0461, -77.0428, 5.5, 54.7, mdate, -2.0);
+	NmeaComposer::composeXDR(xdr, "WI", validity, measurements);
+
+	Arena arena;
+	double perCall = allocationsPerCall([&] {
+		arena.reset();
+		ArenaString nmea((ArenaAllocator<char>(arena)));
+		ArenaString talker("GP", ArenaAllocator<char>(arena));
+		NmeaComposer::composeRMC(nmea, talker, validity, mtime, -12.0461, -77.0428, 5.5, 54.7, mdate, -2.0);
+		BOOST_REQUIRE(rmc.compare(0, rmc.size(), nmea.data(), nmea.size()) == 0);
+		NmeaComposer::composeXDR(nmea, "WI", validity, measurements);
+		BOOST_REQUIRE(xdr.compare(0, xdr.size(), nmea.data(), nmea.size()) == 0);
+		ArenaString vdmString((ArenaAllocator<char>(arena)));
+		NmeaComposer::composeXDR(nmea, vdmString, "WI", validity, measurements, mapper, report, 'A');
+	});
+	BOOST_CHECK_EQUAL(perCall, 0);
+}
+
+BOOST_AUTO_TEST_CASE( legacyComposers )
+{
+	std::cout << "Allocations per call of the std::string& composers\n"
+			<< std::setw(42) << std::left << "function" << std::setw(12)
+			<< std::right << "new string" << std::setw(16) << "reused string"
+			<< '\n';
+	for (const Composer& composer : composers()) {
+		double fresh = allocationsPerCall([&] {
+			std::string nmea;
+			composer.string(nmea);
+		});
+		std::string nmea;
+		double reused = allocationsPerCall([&] {
+			composer.string(nmea);
+		});
+		std::cout << std::setw(42) << std::left << composer.name
+				<< std::setw(12) << std::right << fresh << std::setw(16)
+				<< reused << '\n';
+	}
+}
+
+BOOST_AUTO_TEST_CASE( streamEncoder )
+{
+	std::vector<std::string> sentences;
+	for (const Composer& composer : composers()) {
+		sentences.emplace_back();
+		composer.string(sentences.back());
+	}
+
+	NmeaStreamEncoder encoder;
+	std::string frame;
+	auto encodeFrame = [&] {
+		for (const std::string& sentence : sentences) {
+			encoder.encode(sentence.data(), sentence.size());
+		}
+		encoder.finish(frame);
+	};
+	// Lets the slot table and both frame buffers reach their final size
+	for (int i = 0; i < 4; ++i) {
+		encodeFrame();
+	}
+	BOOST_CHECK_EQUAL(allocationsPerCall(encodeFrame), 0);
+}
+
+/*
+ * Counts the sentences without keeping them.
+ */
+struct CountingSink: public NmeaSink {
+	std::size_t sentences = 0;
+
+	void writeSentence(const char*, std::size_t) override {
+		++sentences;
+	}
+
+	void flushSentences() override {
+	}
+};
+
+static std::vector<NmeaAisTarget> fleet(std::size_t count) {
+	std::vector<NmeaAisTarget> targets(count);
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		NmeaAisTarget& target = targets[i];
+		target.slotTime = (i * 7919) % 2250;
+		target.channel = i % 2 ? 'B' : 'A';
+		uint mmsi = 200000000 + i;
+		float latitude = -12.0f + (i % 50) * 0.01f;
+		float longitude = -77.2f + (i / 50) * 0.01f;
+		if (i % 3) {
+			target.messageType = Nmea_AisMessageType_PositionReportClassA;
+			target.positionReportClassA = { 0, mmsi,
+					Nmea_NavigationStatus_UnderWayUsingEngine, 0, 12.3f,
+					Nmea_PositionAccuracy_DGPSQualityFix, longitude, latitude,
+					166.8f, 167, 30, Nmea_ManeuverIndicator_NotAvailable,
+					Nmea_RAIM_NotInUse };
+		} else {
+			target.messageType =
+					Nmea_AisMessageType_StandardClassBCSPositionReport;
+			target.standardClassBCSPositionReport = { 0, mmsi, 6.5f,
+					Nmea_PositionAccuracy_UnaugmentedGNSSFix, longitude,
+					latitude, 45.0f, 511, 60 };
+		}
+	}
+	return targets;
+}
+
+BOOST_AUTO_TEST_CASE( fleetEncoder )
+{
+	const std::vector<NmeaAisTarget> targets = fleet(500);
+	// A single thread, so that every allocation of encode() is counted
+	NmeaFleetEncoder encoder(1);
+	std::string output;
+	CountingSink sink;
+	auto encodeFleet = [&] {
+		encoder.encode(targets.data(), targets.size(), NmeaFleetOrder_Mmsi,
+				output);
+		encoder.encode(targets.data(), targets.size(), NmeaFleetOrder_SlotTime,
+				sink);
+	};
+	// Lets the chunk buffers, the order and the output reach their final size
+	for (int i = 0; i < 4; ++i) {
+		encodeFleet();
+	}
+	BOOST_CHECK_EQUAL(allocationsPerCall(encodeFleet, 100), 0);
+	BOOST_CHECK_GT(sink.sentences, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( aisReceivers )
+{
+	const std::vector<NmeaAisTarget> targets = fleet(500);
+	NmeaAisReceivers network(20);
+	std::vector<CountingSink> sinks(4);
+	for (std::size_t r = 0; r < sinks.size(); ++r) {
+		network.addReceiver(-11.8 + r * 0.05, -77.0 - r * 0.05, 10, sinks[r]);
+	}
+	auto broadcast = [&] {
+		network.broadcast(targets.data(), targets.size());
+	};
+	// Lets the grid and the shared sentence buffer reach their final size
+	for (int i = 0; i < 4; ++i) {
+		broadcast();
+	}
+	BOOST_CHECK_EQUAL(allocationsPerCall(broadcast, 100), 0);
+	BOOST_CHECK_GT(network.composed(), 0u);
+}
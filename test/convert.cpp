@@ -0,0 +1,230 @@
+#define BOOST_TEST_MODULE libNmeaComposer convert
+#include <boost/test/included/unit_test.hpp>
+#include "NmeaComposerCore.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+/*
+ * Runs the converter given as first argument on generated CSV and binary
+ * logs, one thread and several, and checks its output against the
+ * sentences of NmeaComposerCore.
+ */
+namespace {
+
+// Layout of a binary record, as documented in tools/convert.cpp
+struct BinaryRecord {
+	uint8_t type;
+	char talker[2];
+	uint8_t spare;
+	uint16_t validity;
+	uint16_t reserved;
+	int64_t utcNs;
+	double values[6];
+};
+
+// 2016-04-20T00:00:00Z
+const int64_t midnight = 1461110400;
+const NmeaDate date = { 2016, 4, 20 };
+
+// Enough records for several chunks of 1 MiB
+const int csvLines = 80000;
+const int binaryRecords = 50000;
+
+void append(std::string& expected, const char* buffer, std::size_t length) {
+	expected.append(buffer, length);
+	expected += "\r\n";
+}
+
+std::string readFile(const char* path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+}
+
+/*
+ * Converts input to output with the given threads and 1 MiB chunks.
+ */
+std::string convert(const char* format, const char* input, int threads) {
+	const boost::unit_test::master_test_suite_t& suite =
+			boost::unit_test::framework::master_test_suite();
+	BOOST_REQUIRE_EQUAL(suite.argc, 2);
+	char command[1024];
+	std::snprintf(command, sizeof(command),
+			"'%s' --format %s --threads %d --chunk 1 %s %s.out 2>/dev/null",
+			suite.argv[1], format, threads, input, input);
+	BOOST_REQUIRE_EQUAL(std::system(command), 0);
+	std::string output = readFile((std::string(input) + ".out").c_str());
+	std::remove((std::string(input) + ".out").c_str());
+	return output;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE( csv )
+{
+	std::string input = "# type,talker,fields\n";
+	std::string expected;
+	char line[256];
+	char buffer[256];
+	NmeaComposerValid valid;
+	for (int i = 0; i < csvLines; ++i) {
+		double value = i * 0.37 - 1000;
+		std::size_t length = 0;
+		switch (i % 9) {
+		case 0: {
+			int64_t seconds = i % 86400;
+			std::snprintf(line, sizeof(line), "RMC,GP,%lld,%.17g,%.17g,12.5,"
+					"166.87,-1.4\n",
+					static_cast<long long>(midnight + seconds), value / 100,
+					value / 50);
+			length = NmeaComposerCore::composeRMC(buffer, sizeof(buffer), "GP",
+					valid, std::chrono::microseconds(seconds * 1000000),
+					value / 100, value / 50, 12.5, 166.87, date, -1.4);
+			break;
+		}
+		case 1: {
+			std::snprintf(line, sizeof(line), "XDR,WI,C,%.17g,C,AIRTEMP,"
+					"P,1.0132,B,BARO\n", value);
+			NmeaTransducer transducers[] = { { 'C', static_cast<float>(value),
+					'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "BARO" } };
+			length = NmeaComposerCore::composeXDR(buffer, sizeof(buffer), "WI",
+					valid, transducers, 2);
+			break;
+		}
+		case 2:
+			std::snprintf(line, sizeof(line), "MWV,WI,%.17g,T,7.5,N,A\n",
+					value);
+			length = NmeaComposerCore::composeMWV(buffer, sizeof(buffer), "WI",
+					valid, value, Nmea_AngleReference_True, 7.5, 'N', 'A');
+			break;
+		case 3:
+			std::snprintf(line, sizeof(line), "MWD,WI,%.17g,10,7.5,3.8\n",
+					value);
+			length = NmeaComposerCore::composeMWD(buffer, sizeof(buffer), "WI",
+					valid, value, 10, 7.5, 3.8);
+			break;
+		case 4:
+			std::snprintf(line, sizeof(line), "HDT,HE,%.17g\n", value);
+			length = NmeaComposerCore::composeHDT(buffer, sizeof(buffer), "HE",
+					valid, value);
+			break;
+		case 5: {
+			// An empty field is invalid
+			std::snprintf(line, sizeof(line), "VLW,VW,,%.17g\r\n", value);
+			NmeaComposerValid validity;
+			validity.set(0);
+			length = NmeaComposerCore::composeVLW(buffer, sizeof(buffer), "VW",
+					validity, 0, value);
+			break;
+		}
+		case 6:
+			std::snprintf(line, sizeof(line), "VHW,VW,%.17g,1,2,3\n", value);
+			length = NmeaComposerCore::composeVHW(buffer, sizeof(buffer), "VW",
+					valid, value, 1, 2, 3);
+			break;
+		case 7:
+			std::snprintf(line, sizeof(line), "PRDID,-1.5,2.5,%.17g\n", value);
+			length = NmeaComposerCore::composePRDID(buffer, sizeof(buffer),
+					valid, -1.5, 2.5, value);
+			break;
+		default:
+			// Skipped
+			std::snprintf(line, sizeof(line), "%s\n", i % 2 ? "GGA,GP,1" : "#");
+			break;
+		}
+		input += line;
+		if (length != 0) {
+			append(expected, buffer, length);
+		}
+	}
+	BOOST_REQUIRE_GT(input.size(), 2u << 20);
+	std::ofstream("convert-test.csv", std::ios::binary) << input;
+
+	BOOST_CHECK(convert("csv", "convert-test.csv", 1) == expected);
+	BOOST_CHECK(convert("csv", "convert-test.csv", 4) == expected);
+	std::remove("convert-test.csv");
+}
+
+BOOST_AUTO_TEST_CASE( binary )
+{
+	std::string input;
+	std::string expected;
+	char buffer[256];
+	for (int i = 0; i < binaryRecords; ++i) {
+		BinaryRecord record = BinaryRecord();
+		record.talker[0] = 'G';
+		record.talker[1] = 'P';
+		double* values = record.values;
+		for (int v = 0; v < 6; ++v) {
+			values[v] = i * 0.37 - 1000 + v;
+		}
+		NmeaComposerValid validity(i % 5 == 0 ? 2 : 0);
+		record.validity = static_cast<uint16_t>(validity.to_ulong());
+		std::size_t length = 0;
+		switch (i % 8) {
+		case 0: {
+			int64_t seconds = i % 86400;
+			record.type = Nmea_SentenceType_RMC;
+			record.utcNs = (midnight + seconds) * 1000000000LL;
+			length = NmeaComposerCore::composeRMC(buffer, sizeof(buffer), "GP",
+					validity, std::chrono::microseconds(seconds * 1000000),
+					values[0], values[1], values[2], values[3], date,
+					values[4]);
+			break;
+		}
+		case 1:
+			record.type = Nmea_SentenceType_MWV;
+			values[2] = 1;
+			values[3] = 'K';
+			values[4] = 'A';
+			length = NmeaComposerCore::composeMWV(buffer, sizeof(buffer), "GP",
+					validity, values[0], Nmea_AngleReference_Relative,
+					values[1], 'K', 'A');
+			break;
+		case 2:
+			record.type = Nmea_SentenceType_MWD;
+			length = NmeaComposerCore::composeMWD(buffer, sizeof(buffer), "GP",
+					validity, values[0], values[1], values[2], values[3]);
+			break;
+		case 3:
+			record.type = Nmea_SentenceType_HDT;
+			length = NmeaComposerCore::composeHDT(buffer, sizeof(buffer), "GP",
+					validity, values[0]);
+			break;
+		case 4:
+			record.type = Nmea_SentenceType_VLW;
+			length = NmeaComposerCore::composeVLW(buffer, sizeof(buffer), "GP",
+					validity, values[0], values[1]);
+			break;
+		case 5:
+			record.type = Nmea_SentenceType_VHW;
+			length = NmeaComposerCore::composeVHW(buffer, sizeof(buffer), "GP",
+					validity, values[0], values[1], values[2], values[3]);
+			break;
+		case 6:
+			record.type = Nmea_SentenceType_PRDID;
+			length = NmeaComposerCore::composePRDID(buffer, sizeof(buffer),
+					validity, values[0], values[1], values[2]);
+			break;
+		default:
+			// Skipped
+			record.type = Nmea_SentenceType_Count;
+			break;
+		}
+		input.append(reinterpret_cast<const char*>(&record), sizeof(record));
+		if (length != 0) {
+			append(expected, buffer, length);
+		}
+	}
+	std::ofstream("convert-test.bin", std::ios::binary) << input;
+
+	BOOST_CHECK(convert("binary", "convert-test.bin", 1) == expected);
+	BOOST_CHECK(convert("binary", "convert-test.bin", 4) == expected);
+	std::remove("convert-test.bin");
+}
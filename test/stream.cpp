@@ -0,0 +1,169 @@
+
+#define BOOST_TEST_MODULE libNmeaComposer stream
+#include <boost/test/included/unit_test.hpp>
+#include "NmeaComposerCore.h"
+#include "NmeaAsyncSink.h"
+#include "NmeaSensorFeed.h"
+#include "NmeaStream.h"
+#include "NmeaTask.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string hdt(double heading) {
+	char buffer[128];
+	std::size_t length = NmeaComposerCore::composeHDT(buffer, sizeof(buffer),
+			"HE", NmeaComposerValid(), heading);
+	return std::string(buffer, length) + "\r\n";
+}
+
+std::string drain(NmeaAsyncSink& sink) {
+	std::size_t length;
+	const char* data = sink.pending(length);
+	std::string text(data, length);
+	sink.consume(length);
+	return text;
+}
+
+NmeaStream headings(NmeaSensorFeed<double>& feed) {
+	while (std::optional<double> heading = co_await feed.next()) {
+		double value = *heading;
+		co_yield nmeaCompose(Nmea_SentenceType_HDT,
+				[value](char* buffer, std::size_t size) {
+					return NmeaComposerCore::composeHDT(buffer, size, "HE",
+							NmeaComposerValid(), value);
+				});
+	}
+}
+
+NmeaStream fixed(std::vector<std::string> sentences) {
+	for (const std::string& sentence : sentences) {
+		co_yield NmeaSentenceView { sentence.data(), sentence.size(),
+				Nmea_SentenceType_Count };
+	}
+}
+
+NmeaStream failing() {
+	co_yield NmeaSentenceView { "$A", 2, Nmea_SentenceType_Count };
+	throw std::runtime_error("sensor lost");
+}
+
+NmeaStream large(std::size_t length) {
+	co_yield nmeaCompose(Nmea_SentenceType_Count,
+			[length](char* buffer, std::size_t size) {
+				if (size > length) {
+					std::memset(buffer, 'X', length);
+					buffer[length] = '\0';
+				}
+				return length;
+			});
+}
+
+NmeaTask collect(NmeaStream stream, std::vector<std::string>& sentences) {
+	while (const NmeaSentenceView* sentence = co_await stream.next()) {
+		sentences.push_back(std::string(sentence->data, sentence->length));
+	}
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE( feedToSink ) {
+	NmeaSensorFeed<double> feed(4);
+	NmeaAsyncSink sink(2 * hdt(0.0).size());
+	NmeaTask pump = nmeaPump(headings(feed), sink);
+
+	// Sentences are written before push returns
+	BOOST_CHECK(!pump.done());
+	BOOST_CHECK(feed.push(57.34));
+	BOOST_CHECK(feed.push(120.5));
+	BOOST_CHECK(!sink.waiting());
+	// Sink full: the stream waits, the feed holds the data behind it
+	BOOST_CHECK(feed.push(240.0));
+	BOOST_CHECK(sink.waiting());
+	BOOST_CHECK(feed.push(1.0));
+	BOOST_CHECK_EQUAL(feed.size(), 1U);
+
+	std::size_t length;
+	sink.pending(length);
+	BOOST_CHECK_EQUAL(length, 2 * hdt(0.0).size());
+	sink.consume(hdt(0.0).size());
+	BOOST_CHECK(sink.waiting());
+	BOOST_CHECK_EQUAL(feed.size(), 0U);
+
+	BOOST_CHECK_EQUAL(drain(sink), hdt(120.5) + hdt(240.0));
+	BOOST_CHECK(!sink.waiting());
+	BOOST_CHECK_EQUAL(drain(sink), hdt(1.0));
+
+	feed.close();
+	BOOST_CHECK(pump.done());
+	BOOST_CHECK_NO_THROW(pump.get());
+	BOOST_CHECK(!feed.push(2.0));
+}
+
+BOOST_AUTO_TEST_CASE( feedFull ) {
+	NmeaSensorFeed<int> feed(2);
+	BOOST_CHECK(feed.push(1));
+	BOOST_CHECK(feed.push(2));
+	BOOST_CHECK(!feed.push(3));
+	feed.close();
+	BOOST_CHECK_EQUAL(feed.size(), 2U);
+}
+
+BOOST_AUTO_TEST_CASE( views ) {
+	std::vector<std::string> sentences;
+	NmeaTask task = collect(fixed( { "$A", "$BC", "!D" }), sentences);
+	BOOST_CHECK(task.done());
+	BOOST_REQUIRE_EQUAL(sentences.size(), 3U);
+	BOOST_CHECK_EQUAL(sentences[0], "$A");
+	BOOST_CHECK_EQUAL(sentences[1], "$BC");
+	BOOST_CHECK_EQUAL(sentences[2], "!D");
+}
+
+BOOST_AUTO_TEST_CASE( largeSentence ) {
+	// Past the buffer of the frame, the stream grows its own
+	std::vector<std::string> sentences;
+	NmeaTask task = collect(large(NmeaStream::inlineBuffer + 100), sentences);
+	BOOST_REQUIRE_EQUAL(sentences.size(), 1U);
+	BOOST_CHECK_EQUAL(sentences[0], std::string(NmeaStream::inlineBuffer + 100, 'X'));
+
+	// But never past the sink
+	NmeaAsyncSink sink(64);
+	NmeaTask pump = nmeaPump(large(63), sink);
+	BOOST_CHECK(pump.done());
+	BOOST_CHECK_THROW(pump.get(), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE( streamException ) {
+	std::vector<std::string> sentences;
+	NmeaTask task = collect(failing(), sentences);
+	BOOST_CHECK(task.done());
+	BOOST_CHECK_EQUAL(sentences.size(), 1U);
+	BOOST_CHECK_THROW(task.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( framePool ) {
+	NmeaSensorFeed<double> feed(1);
+	NmeaAsyncSink sink(256);
+	{
+		NmeaTask pump = nmeaPump(headings(feed), sink);
+		feed.close();
+	}
+	// The frames of a run are taken back by the next one
+	std::size_t pooled = NmeaFramePool::pooled();
+	BOOST_CHECK_GE(pooled, 2U);
+	NmeaSensorFeed<double> again(1);
+	{
+		NmeaTask pump = nmeaPump(headings(again), sink);
+		BOOST_CHECK_EQUAL(NmeaFramePool::pooled(), pooled - 2);
+		again.close();
+	}
+	BOOST_CHECK_EQUAL(NmeaFramePool::pooled(), pooled);
+
+	void* frame = NmeaFramePool::allocate(NmeaFramePool::maxPooled + 1);
+	NmeaFramePool::deallocate(frame, NmeaFramePool::maxPooled + 1);
+	BOOST_CHECK_EQUAL(NmeaFramePool::pooled(), pooled);
+}
@@ -1,7 +1,59 @@
 
 #define BOOST_TEST_MODULE libNmeaParser test
 #include <boost/test/included/unit_test.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/property_tree/json_parser.hpp>
 #include "NmeaComposer.h"
+#include "NmeaAisReceivers.h"
+#include "NmeaFleetEncoder.h"
+#include "NmeaJsonDelta.h"
+#include "NmeaArchive.h"
+#include "NmeaArmor.h"
+#include "NmeaJournal.h"
+#include "NmeaLog.h"
+#include "NmeaOnChange.h"
+#include "NmeaReplay.h"
+#include "NmeaSentencePlan.h"
+#include "NmeaRouter.h"
+#include "NmeaStatistics.h"
+#include "NmeaStreamCodec.h"
+#include "NmeaTagBlock.h"
+
+#include <chrono>
+#include <fstream>
+#include <set>
+#include <thread>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct CaptureSink: public NmeaSink {
+	std::vector<std::string> sentences;
+	int flushes = 0;
+
+	void writeSentence(const char* sentence, std::size_t length) override {
+		sentences.emplace_back(sentence, length);
+	}
+
+	void flushSentences() override {
+		++flushes;
+	}
+};
+
+static void removeDirectory(const std::string& directory) {
+	if (DIR* dir = opendir(directory.c_str())) {
+		while (dirent* entry = readdir(dir)) {
+			if (entry->d_name[0] != '.') {
+				unlink((directory + "/" + entry->d_name).c_str());
+			}
+		}
+		closedir(dir);
+	}
+	rmdir(directory.c_str());
+}
 
 BOOST_AUTO_TEST_CASE( composeRMC ) {
 
@@ -56,6 +108,31 @@ BOOST_AUTO_TEST_CASE( composeXDR ) {
 
 }
 
+BOOST_AUTO_TEST_CASE( composeXDRPastValidity ) {
+
+	NmeaComposerValid validity = 0L;
+	validity[1] = true;
+
+	std::vector<TransducerMeasurement> measurements;
+	for (int i = 0; i < 24; ++i) {
+		TransducerMeasurement tm = { 'C', 20.0f + i, 'C', "T" };
+		measurements.push_back(tm);
+	}
+
+	std::string nmeaXDR;
+	NmeaComposer::composeXDR(nmeaXDR, "WI", validity, measurements);
+
+	std::vector<std::string> fields;
+	std::istringstream sentence(nmeaXDR.substr(0, nmeaXDR.find('*')));
+	for (std::string field; std::getline(sentence, field, ',');) {
+		fields.push_back(field);
+	}
+	BOOST_REQUIRE_EQUAL(fields.size(), 1u + 4 * measurements.size());
+	BOOST_CHECK_EQUAL(fields[2], "");
+	BOOST_CHECK_EQUAL(fields[1 + 4 * 16 + 1], "+036.0");
+	BOOST_CHECK_EQUAL(fields[1 + 4 * 23 + 1], "+043.0");
+}
+
 BOOST_AUTO_TEST_CASE( composeWMV ) {
 
 	std::string nmeaWMV;
@@ -123,3 +200,1134 @@ BOOST_AUTO_TEST_CASE( composePRDID )
 
 	BOOST_REQUIRE_NO_THROW(NmeaComposer::composePRDID(nmeaPRDID, validity, pitch, roll, heading));
 }
+
+BOOST_AUTO_TEST_CASE( composeBuffer )
+{
+	std::string nmeaHDT;
+	NmeaComposerValid validity = 0L;
+	NmeaComposer::composeHDT(nmeaHDT, "HE", validity, 57.34);
+
+	char buffer[64];
+	BOOST_CHECK_EQUAL(NmeaComposer::composeHDT(buffer, sizeof(buffer), "HE", validity, 57.34), nmeaHDT.size());
+	BOOST_CHECK_EQUAL(buffer, nmeaHDT);
+
+	char small[8];
+	BOOST_CHECK_EQUAL(NmeaComposer::composeHDT(small, sizeof(small), "HE", validity, 57.34), nmeaHDT.size());
+	BOOST_CHECK_EQUAL(small, nmeaHDT.substr(0, sizeof(small) - 1));
+	BOOST_CHECK_EQUAL(NmeaComposer::composeHDT(NULL, 0, "HE", validity, 57.34), nmeaHDT.size());
+}
+
+BOOST_AUTO_TEST_CASE( composerCore )
+{
+	NmeaComposerValid validity = 0L;
+	char buffer[128];
+
+	std::string nmeaRMC;
+	NmeaComposer::composeRMC(nmeaRMC, "GP", validity, boost::posix_time::time_duration(12, 34, 56, 789000), -12.0461, -77.0428, 12.5, 245.7, boost::gregorian::date(2026, 10, 18), -2.3);
+	NmeaDate date = { 2026, 10, 18 };
+	std::chrono::microseconds utcTime = std::chrono::hours(12) + std::chrono::minutes(34) + std::chrono::seconds(56) + std::chrono::milliseconds(789);
+	BOOST_CHECK_EQUAL(NmeaComposerCore::composeRMC(buffer, sizeof(buffer), "GP", validity, utcTime, -12.0461, -77.0428, 12.5, 245.7, date, -2.3), nmeaRMC.size());
+	BOOST_CHECK_EQUAL(buffer, nmeaRMC);
+
+	std::string nmeaXDR;
+	std::vector<TransducerMeasurement> measurements = { { 'C', 23.4f, 'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "BARO" } };
+	NmeaComposer::composeXDR(nmeaXDR, "YX", validity, measurements);
+	NmeaTransducer transducers[] = { { 'C', 23.4f, 'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "BARO" } };
+	BOOST_CHECK_EQUAL(NmeaComposerCore::composeXDR(buffer, sizeof(buffer), "YX", validity, transducers, 2), nmeaXDR.size());
+	BOOST_CHECK_EQUAL(buffer, nmeaXDR);
+
+	std::string nmeaPRDID;
+	NmeaComposer::composePRDID(nmeaPRDID, validity, -1.25, 2.5, 57.34);
+	char small[8];
+	BOOST_CHECK_EQUAL(NmeaComposerCore::composePRDID(small, sizeof(small), validity, -1.25, 2.5, 57.34), nmeaPRDID.size());
+	BOOST_CHECK_EQUAL(small, nmeaPRDID.substr(0, sizeof(small) - 1));
+}
+
+BOOST_AUTO_TEST_CASE( composeAIS )
+{
+	AISPositionReportClassA classA = { 0, 477553000, Nmea_NavigationStatus_Moored, 0, 0, Nmea_PositionAccuracy_UnaugmentedGNSSFix, -122.345833f, 47.582833f, 51, 181, 15, Nmea_ManeuverIndicator_NotAvailable, Nmea_RAIM_NotInUse };
+	std::string nmea;
+	NmeaComposer::composeAISPositionReportClassA(nmea, classA, 'B');
+	// gpsd sample !AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C with the radio
+	// status zeroed and the latitude the float holds, 28549699 instead of 28549700
+	BOOST_CHECK_EQUAL(nmea, "!AIVDM,1,1,,B,177KQJ5000G?tO`K>R@iwUbN0000,0*62");
+
+	char buffer[64];
+	BOOST_CHECK_EQUAL(NmeaComposer::composeAISPositionReportClassA(buffer, sizeof(buffer), classA, 'B'), nmea.size());
+	BOOST_CHECK_EQUAL(buffer, nmea);
+
+	AISStandardClassBCSPositionReport classB = { 0, 367430530, 0, Nmea_PositionAccuracy_UnaugmentedGNSSFix, -122.26732f, 37.785035f, 0, 511, 55 };
+	NmeaComposer::composeAISStandardClassBCSPositionReport(nmea, classB, 'A');
+	// gpsd sample !AIVDM,1,1,,A,B5NJ;PP005l4ot5Isbl03wsUkP06,0*76 with the flags
+	// of a CS unit without DSC nor message 22, and the longitude the float
+	// holds, -73360391 instead of -73360392
+	BOOST_CHECK_EQUAL(nmea, "!AIVDM,1,1,,A,B5NJ;PP005l4otUIsbl03wsTSP06,0*2F");
+	BOOST_CHECK_EQUAL(NmeaComposer::composeAISStandardClassBCSPositionReport(buffer, sizeof(buffer), classB, 'A'), nmea.size());
+	BOOST_CHECK_EQUAL(buffer, nmea);
+}
+
+/*
+ * Unsigned field of the armored payload of a single fragment !AIVDM sentence.
+ */
+static unsigned aisField(const std::string& sentence, std::size_t start, std::size_t width) {
+	const std::size_t payload = 14; // after "!AIVDM,1,1,,A,"
+	unsigned value = 0;
+	for (std::size_t bit = start; bit < start + width; ++bit) {
+		unsigned sixBits = sentence[payload + bit / 6] - 48;
+		if (sixBits > 40) {
+			sixBits -= 8;
+		}
+		value = (value << 1) | ((sixBits >> (5 - bit % 6)) & 1);
+	}
+	return value;
+}
+
+BOOST_AUTO_TEST_CASE( composeAISLimits )
+{
+	AISPositionReportClassA report = { 0, 477553000, Nmea_NavigationStatus_Moored, 0, 0, Nmea_PositionAccuracy_UnaugmentedGNSSFix, -122.345833f, 47.582833f, 51, 181, 15, Nmea_ManeuverIndicator_NotAvailable, Nmea_RAIM_NotInUse };
+	std::string nmea;
+	const std::pair<float, unsigned> speeds[] = { { 0.04f, 0 }, { -3, 0 }, { 102.1f, 1021 }, { 102.2f, 1022 }, { 102.25f, 1022 }, { 102.34f, 1022 }, { 150, 1022 }, { INFINITY, 1022 }, { NAN, 1023 } };
+	for (const auto& speed : speeds) {
+		report.speedOverGround = speed.first;
+		NmeaComposer::composeAISPositionReportClassA(nmea, report, 'A');
+		BOOST_CHECK_EQUAL(aisField(nmea, 50, 10), speed.second);
+	}
+	const std::pair<float, unsigned> courses[] = { { 0, 0 }, { 359.9f, 3599 }, { 359.95f, 0 }, { 360, 0 }, { 365.5f, 55 }, { -0.04f, 0 }, { -10, 3500 }, { -725, 3550 }, { INFINITY, 3600 }, { NAN, 3600 } };
+	for (const auto& course : courses) {
+		report.courseOverGround = course.first;
+		NmeaComposer::composeAISPositionReportClassA(nmea, report, 'A');
+		BOOST_CHECK_EQUAL(aisField(nmea, 116, 12), course.second);
+	}
+}
+
+static std::string armorBitByBit(const std::vector<uint8_t>& bits, std::size_t bitCount) {
+	std::string payload;
+	for (std::size_t bit = 0; bit < bitCount; bit += 6) {
+		unsigned sixBits = 0;
+		for (std::size_t i = bit; i < bit + 6; ++i) {
+			sixBits = (sixBits << 1) | (i < bitCount ? (bits[i / 8] >> (7 - i % 8)) & 1 : 0);
+		}
+		payload += static_cast<char>(sixBits < 40 ? sixBits + 48 : sixBits + 56);
+	}
+	return payload;
+}
+
+static uint8_t xorOf(const char* text, std::size_t length) {
+	uint8_t sum = 0;
+	for (std::size_t i = 0; i < length; ++i) {
+		sum ^= text[i];
+	}
+	return sum;
+}
+
+BOOST_AUTO_TEST_CASE( armorKernels )
+{
+	const NmeaArmorKernel kernels[] = { NmeaArmorKernel_Scalar, NmeaArmorKernel_SSE4, NmeaArmorKernel_AVX2 };
+	BOOST_CHECK(NmeaArmor::supported(NmeaArmorKernel_Scalar));
+	BOOST_CHECK(NmeaArmor::supported(NmeaArmor::kernel()));
+
+	// Every 3 byte group, each 4 characters, in consecutive runs shifted so that
+	// the groups land on every position of the SIMD registers
+	const std::size_t groups = 1 << 24;
+	const std::size_t run = 1 << 16;
+	std::vector<uint8_t> bits((run + 8) * 3);
+	std::vector<char> expected((run + 8) * 4);
+	std::vector<char> payload(expected.size());
+	for (std::size_t first = 0; first < groups; first += run) {
+		std::size_t shift = first / run % 8;
+		std::fill(bits.begin(), bits.end(), 0);
+		for (std::size_t g = 0; g < run; ++g) {
+			uint32_t group = first + g;
+			bits[(shift + g) * 3] = group >> 16;
+			bits[(shift + g) * 3 + 1] = group >> 8;
+			bits[(shift + g) * 3 + 2] = group;
+		}
+		std::size_t bitCount = (shift + run) * 24;
+		for (std::size_t g = 0; g < shift + run; ++g) {
+			const uint8_t* in = &bits[g * 3];
+			unsigned sixBits[4] = { static_cast<unsigned>(in[0] >> 2), ((in[0] & 3u) << 4) | (in[1] >> 4), ((in[1] & 15u) << 2) | (in[2] >> 6), in[2] & 63u };
+			for (int c = 0; c < 4; ++c) {
+				expected[g * 4 + c] = static_cast<char>(sixBits[c] < 40 ? sixBits[c] + 48 : sixBits[c] + 56);
+			}
+		}
+		uint8_t expectedChecksum = xorOf(expected.data(), bitCount / 6);
+		for (NmeaArmorKernel kernel : kernels) {
+			if (NmeaArmor::supported(kernel)) {
+				uint8_t checksum = 0;
+				BOOST_REQUIRE_EQUAL(NmeaArmor::armor(kernel, bits.data(), bitCount, payload.data(), checksum), bitCount / 6);
+				BOOST_REQUIRE(std::equal(payload.begin(), payload.begin() + bitCount / 6, expected.begin()));
+				BOOST_REQUIRE_EQUAL(checksum, expectedChecksum);
+			}
+		}
+	}
+
+	// Every length up to a 5 slot message, with garbage past the last bit
+	std::vector<uint8_t> random(126);
+	uint32_t seed = 12345;
+	for (uint8_t& byte : random) {
+		seed = seed * 1103515245 + 12345;
+		byte = seed >> 16;
+	}
+	for (std::size_t bitCount = 0; bitCount <= random.size() * 8; ++bitCount) {
+		std::vector<uint8_t> exact(random.begin(), random.begin() + (bitCount + 7) / 8);
+		std::string reference = armorBitByBit(exact, bitCount);
+		for (NmeaArmorKernel kernel : kernels) {
+			if (NmeaArmor::supported(kernel)) {
+				uint8_t checksum = 0;
+				BOOST_REQUIRE_EQUAL(NmeaArmor::armor(kernel, exact.data(), bitCount, payload.data(), checksum), reference.size());
+				BOOST_REQUIRE_EQUAL(std::string(payload.data(), reference.size()), reference);
+				BOOST_REQUIRE_EQUAL(checksum, xorOf(reference.data(), reference.size()));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( sentencePlan )
+{
+	char planned[128], written[128];
+	NmeaComposerValid validity;
+	NmeaSentencePlan hdt;
+	BOOST_REQUIRE(hdt.compile("--HDT,%06.2f,T"));
+	BOOST_CHECK_EQUAL(hdt.inputs(), 1u);
+	const double heading = 274.07;
+	BOOST_CHECK_EQUAL(NmeaComposerCore::composePlan(planned, sizeof(planned), hdt, "HE", validity, &heading, 1),
+			NmeaComposerCore::composeHDT(written, sizeof(written), "HE", validity, heading));
+	BOOST_CHECK_EQUAL(planned, written);
+	NmeaComposerCore::composePlan(planned, sizeof(planned), hdt, "", validity.set(0), &heading, 1);
+	NmeaComposerCore::composeHDT(written, sizeof(written), "", validity, heading);
+	BOOST_CHECK_EQUAL(planned, written);
+
+	NmeaSentencePlan prdid;
+	BOOST_REQUIRE(prdid.compile("PRDID,%+06.2f,%+06.2f,%06.2f"));
+	const double attitude[] = { -1.5, 2.25, 359.9 };
+	validity.reset().set(1);
+	NmeaComposerCore::composePlan(planned, sizeof(planned), prdid, "GP", validity, attitude, 3);
+	NmeaComposerCore::composePRDID(written, sizeof(written), validity, attitude[0], attitude[1], attitude[2]);
+	BOOST_CHECK_EQUAL(planned, written);
+
+	NmeaSentencePlan gga;
+	BOOST_REQUIRE(gga.compile("--GGA,time,lat,lon,%d,%02d,%.1f,%.1f,M,%.1f,M,%.1f,%04d"));
+	BOOST_CHECK_EQUAL(gga.inputs(), 10u);
+	const double fix[] = { 45319, 48.1173, 11.5166666667, 1, 8, 0.9, 545.4, 46.9, 0, 0 };
+	validity.reset().set(8).set(9);
+	std::size_t length = NmeaComposerCore::composePlan(planned, sizeof(planned), gga, "GP", validity, fix, 10);
+	BOOST_CHECK_EQUAL(planned, "$GPGGA,123519.00,4807.0380,N,01131.0000,E,1,08,0.9,545.4,M,46.9,M,,*69");
+	BOOST_CHECK_EQUAL(length, std::strlen(planned));
+
+	NmeaSentencePlan hdg;
+	BOOST_REQUIRE(hdg.compile("--HDG,%.1f,%.1f:EW,%.1f:EW"));
+	const double magnetic[] = { 98.3, 0, -12.6 };
+	NmeaComposerCore::composePlan(planned, sizeof(planned), hdg, "HC", validity.reset(), magnetic, 3);
+	BOOST_CHECK_EQUAL(planned, "$HCHDG,98.3,0.0,E,12.6,W*57");
+
+	NmeaSentencePlan zda;
+	BOOST_REQUIRE(zda.compile("--ZDA,time,%02d,%02d,%04d,%02d,%02d"));
+	const double date[] = { 72930, 4, 7, 2026, 0, 0 };
+	NmeaComposerCore::composePlan(planned, sizeof(planned), zda, "GP", validity, date, 6);
+	BOOST_CHECK_EQUAL(planned, "$GPZDA,201530.00,04,07,2026,00,00*66");
+
+	// Literals tied to a slot, missing inputs left empty
+	NmeaSentencePlan proprietary;
+	BOOST_REQUIRE(proprietary.compile("PXYZ,%d,%d,x@0"));
+	const double one = 1;
+	NmeaComposerCore::composePlan(planned, sizeof(planned), proprietary, "", validity, &one, 1);
+	BOOST_CHECK_EQUAL(planned, "$PXYZ,1,,x*6E");
+
+	NmeaSentencePlan invalid;
+	BOOST_CHECK(!invalid.compile("--GGA,time,%s"));
+	BOOST_CHECK_EQUAL(invalid.errorOffset(), 11u);
+	BOOST_CHECK(!invalid.compiled());
+	BOOST_CHECK(!invalid.compile("--GGA,%.1f@16"));
+	BOOST_CHECK(!invalid.compile("--GGA,%n"));
+	BOOST_CHECK(!invalid.compile(""));
+	BOOST_CHECK(invalid.compile("--VTG,%.1f,T,%.1f,M,%.1f,N,%.1f,K,A"));
+	BOOST_CHECK(invalid.compile("--GLL,lat,lon,time,A,A"));
+	BOOST_CHECK(invalid.compile("--ROT,%.1f,A"));
+	BOOST_CHECK(invalid.compile("--DPT,%.1f,%.1f,%.1f"));
+}
+
+static int32_t payloadBits(const std::string& sentence, std::size_t offset, unsigned width, bool isSigned = false) {
+	std::string payload = sentence.substr(14, sentence.find(',', 14) - 14);
+	uint32_t value = 0;
+	for (std::size_t bit = offset; bit < offset + width; ++bit) {
+		unsigned sixBits = payload[bit / 6] - 48;
+		sixBits = sixBits > 40 ? sixBits - 8 : sixBits;
+		value = (value << 1) | ((sixBits >> (5 - bit % 6)) & 1);
+	}
+	if (isSigned && (value >> (width - 1)) != 0) {
+		return static_cast<int32_t>(value) - (1 << width);
+	}
+	return value;
+}
+
+BOOST_AUTO_TEST_CASE( composeJsonDelta )
+{
+	char sentence[128], plain[128], json[512];
+	NmeaJsonDelta delta(json, sizeof(json), "bridge");
+	NmeaComposerValid validity;
+
+	// Same sentence with or without the delta, digits shared
+	BOOST_CHECK_EQUAL(NmeaComposerCore::composeHDT(sentence, sizeof(sentence), "HE", validity, 57.34, &delta),
+			NmeaComposerCore::composeHDT(plain, sizeof(plain), "HE", validity, 57.34));
+	BOOST_CHECK_EQUAL(sentence, plain);
+	BOOST_CHECK_EQUAL(json, "{\"updates\":[{\"source\":{\"label\":\"bridge\",\"talker\":\"HE\",\"sentence\":\"HDT\"},"
+			"\"values\":[{\"path\":\"navigation.headingTrue\",\"value\":57.34}]}]}");
+	BOOST_CHECK_EQUAL(delta.length(), std::strlen(json));
+
+	// Signs and leading zeros are not JSON, invalid fields are left out
+	NmeaComposerCore::composePRDID(sentence, sizeof(sentence), NmeaComposerValid().set(2), -1.25, 2.5, 7.0, &delta);
+	BOOST_CHECK_EQUAL(json, "{\"updates\":[{\"source\":{\"label\":\"bridge\",\"sentence\":\"PRDID\"},"
+			"\"values\":[{\"path\":\"navigation.attitude.pitch\",\"value\":-1.25},"
+			"{\"path\":\"navigation.attitude.roll\",\"value\":2.50}]}]}");
+
+	// Position in decimal degrees, variation signed, timestamp from time and date
+	NmeaDate date = { 2026, 10, 18 };
+	NmeaComposerCore::composeRMC(sentence, sizeof(sentence), "GP", validity,
+			std::chrono::microseconds(45296789000LL), -12.0625, -77.125, 5.5, 0.25, date, -2.0, &delta);
+	BOOST_CHECK_EQUAL(json, "{\"updates\":[{\"source\":{\"label\":\"bridge\",\"talker\":\"GP\",\"sentence\":\"RMC\"},"
+			"\"values\":[{\"path\":\"navigation.position\",\"value\":{\"latitude\":-12.0625000,\"longitude\":-77.1250000}},"
+			"{\"path\":\"navigation.speedOverGround\",\"value\":5.50},"
+			"{\"path\":\"navigation.courseOverGroundTrue\",\"value\":0.25},"
+			"{\"path\":\"navigation.magneticVariation\",\"value\":-2.0}],"
+			"\"timestamp\":\"2026-10-18T12:34:56.789Z\"}]}");
+
+	NmeaComposerCore::composeMWV(sentence, sizeof(sentence), "WI", validity, 5.0, Nmea_AngleReference_Relative, 0.4, 'N', 'A', &delta);
+	BOOST_CHECK(std::strstr(json, "{\"path\":\"environment.wind.angleApparent\",\"value\":5.0},"
+			"{\"path\":\"environment.wind.speedApparent\",\"value\":0.4}") != NULL);
+
+	NmeaTransducer measurements[] = { { 'C', 21.5f, 'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "" } };
+	NmeaComposerCore::composeXDR(sentence, sizeof(sentence), "WI", validity, measurements, 2, &delta);
+	BOOST_CHECK(std::strstr(json, "\"values\":[{\"path\":\"transducers.AIRTEMP\",\"value\":21.5}]") != NULL);
+
+	// Names and label escaped, the delta still parses
+	NmeaJsonDelta escaped(json, sizeof(json), "port\tbridge");
+	NmeaTransducer quoted = { 'C', 21.5f, 'C', "AIR\"TEMP\\" };
+	NmeaComposerCore::composeXDR(sentence, sizeof(sentence), "WI", validity, &quoted, 1, &escaped);
+	BOOST_CHECK(std::strstr(json, "{\"path\":\"transducers.AIR\\\"TEMP\\\\\",\"value\":21.5}") != NULL);
+	BOOST_CHECK(std::strstr(json, "\"label\":\"port\\u0009bridge\"") != NULL);
+	std::istringstream text(json);
+	boost::property_tree::ptree tree;
+	BOOST_REQUIRE_NO_THROW(boost::property_tree::read_json(text, tree));
+	const boost::property_tree::ptree& update = tree.get_child("updates").front().second;
+	BOOST_CHECK_EQUAL(update.get<std::string>("source.label"), "port\tbridge");
+	const boost::property_tree::ptree& value = update.get_child("values").front().second;
+	BOOST_CHECK_EQUAL(value.get<std::string>("path"), "transducers.AIR\"TEMP\\");
+	BOOST_CHECK_EQUAL(value.get<double>("value"), 21.5);
+
+	// Truncated like the sentences
+	char small[32];
+	NmeaJsonDelta truncated(small, sizeof(small));
+	std::size_t length = NmeaComposerCore::composeHDT(sentence, sizeof(sentence), "HE", validity, 57.34, &truncated);
+	BOOST_CHECK_EQUAL(truncated.length(), 131u);
+	BOOST_CHECK_EQUAL(std::strlen(small), sizeof(small) - 1);
+	BOOST_CHECK_EQUAL(length, std::strlen(plain));
+}
+
+BOOST_AUTO_TEST_CASE( composeMetHydro )
+{
+	AISMeteorologicalHydrologicalData report = { 0, 2655001, 4.5f, 52.25f, Nmea_PositionAccuracy_UnaugmentedGNSSFix, 18, 12, 30, { } };
+	std::fill(report.observations, report.observations + Nmea_MetHydroField_Count, NAN);
+	report.observations[Nmea_MetHydroField_WindDirection] = -10;
+	report.observations[Nmea_MetHydroField_DewPoint] = -5.5f;
+	report.observations[Nmea_MetHydroField_HorizontalVisibility] = 20;
+
+	std::vector<TransducerMeasurement> measurements = { { 'C', 12.3f, 'C', "AIRTEMP" }, { 'P', 1.0132f, 'B', "BARO" },
+			{ 'H', 81, 'P', "HUMIDITY" }, { 'C', 285.15f, 'K', "WATERTEMP" }, { 'C', 99, 'C', "OTHER" }, { 'A', 3, 'D', "PITCH" } };
+	std::string xdr, vdm, expected;
+	NmeaMetHydro mapper;
+	NmeaComposer::composeXDR(xdr, vdm, "WI", NmeaComposerValid(), measurements, mapper, report, 'A');
+	NmeaComposer::composeXDR(expected, "WI", NmeaComposerValid(), measurements);
+	BOOST_CHECK_EQUAL(xdr, expected);
+	NmeaComposer::composeAISMeteorologicalHydrologicalData(expected, report, 'A');
+	BOOST_CHECK_EQUAL(vdm, expected);
+
+	BOOST_CHECK_EQUAL(vdm.substr(0, 14), "!AIVDM,1,1,,A,");
+	BOOST_CHECK_EQUAL(vdm.size(), 79u);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 0, 6), 8);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 8, 30), 2655001);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 40, 10), 1);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 50, 6), 31);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 56, 25, true), 270000);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 81, 24, true), 3135000);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 106, 5), 18);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 116, 6), 30);
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 122, 7), 127);        // wind speed not available
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 136, 9), 350);        // wind direction
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 154, 11, true), 123); // air temperature, the unnamed 'C' ignored
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 165, 7), 81);         // relative humidity by type
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 172, 10, true), -55); // dew point
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 182, 9), 214);        // 1013 hPa
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 193, 8), 0x80 | 126); // visibility greater than 12.6 nm
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 201, 12), 4001);      // water level not available
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 326, 10, true), 120); // water temperature from kelvin
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 339, 9), 501);        // salinity not available
+	BOOST_CHECK_EQUAL(payloadBits(vdm, 348, 2), 3);          // ice not available
+
+	BOOST_CHECK(mapper.assign("OTHER", Nmea_MetHydroField_WaterTemperature));
+	BOOST_CHECK(!mapper.assign("A_NAME_LONGER_THAN_23_CHARACTERS", Nmea_MetHydroField_Ice));
+	NmeaTransducer other = { 'C', 14.5f, 'C', "OTHER" };
+	BOOST_CHECK_EQUAL(mapper.map(&other, 1, report), 1u);
+	BOOST_CHECK_EQUAL(report.observations[Nmea_MetHydroField_WaterTemperature], 14.5f);
+	BOOST_CHECK_CLOSE(report.observations[Nmea_MetHydroField_AirTemperature], 12.3f, 1e-4);
+
+	// A named measurement replacing the one found by type counts once
+	NmeaTransducer temperatures[] = { { 'C', 11.0f, 'C', "UNNAMED" }, { 'C', 13.5f, 'C', "AIRTEMP" } };
+	BOOST_CHECK_EQUAL(mapper.map(temperatures, 2, report), 1u);
+	BOOST_CHECK_EQUAL(report.observations[Nmea_MetHydroField_AirTemperature], 13.5f);
+}
+
+BOOST_AUTO_TEST_CASE( fleetEncoder )
+{
+	std::vector<NmeaAisTarget> targets(5000);
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		NmeaAisTarget& target = targets[i];
+		target.slotTime = (i * 7919) % 2250;
+		target.channel = i % 2 ? 'B' : 'A';
+		uint mmsi = 200000000 + (i * 104729) % 99999989;
+		if (i % 3) {
+			target.messageType = Nmea_AisMessageType_PositionReportClassA;
+			target.positionReportClassA = { 0, mmsi, Nmea_NavigationStatus_UnderWayUsingEngine, 0, 12.3f, Nmea_PositionAccuracy_DGPSQualityFix, -77.1f + i * 1e-4f, -12.0f - i * 1e-4f, 166.8f, 167, 30, Nmea_ManeuverIndicator_NotAvailable, Nmea_RAIM_NotInUse };
+		} else {
+			target.messageType = Nmea_AisMessageType_StandardClassBCSPositionReport;
+			target.standardClassBCSPositionReport = { 0, mmsi, 6.5f, Nmea_PositionAccuracy_UnaugmentedGNSSFix, -77.2f + i * 1e-4f, -12.1f, 45.0f, 511, 60 };
+		}
+	}
+	targets[10].messageType = Nmea_AisMessageType_BaseStationReport;
+
+	std::vector<std::pair<uint, std::string> > expected;
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		std::string nmea;
+		if (targets[i].messageType == Nmea_AisMessageType_PositionReportClassA) {
+			NmeaComposer::composeAISPositionReportClassA(nmea, targets[i].positionReportClassA, targets[i].channel);
+			expected.emplace_back(targets[i].positionReportClassA.mmsi, nmea + "\r\n");
+		} else if (targets[i].messageType == Nmea_AisMessageType_StandardClassBCSPositionReport) {
+			NmeaComposer::composeAISStandardClassBCSPositionReport(nmea, targets[i].standardClassBCSPositionReport, targets[i].channel);
+			expected.emplace_back(targets[i].standardClassBCSPositionReport.mmsi, nmea + "\r\n");
+		}
+	}
+	std::stable_sort(expected.begin(), expected.end(), [](const std::pair<uint, std::string>& a, const std::pair<uint, std::string>& b) {
+		return a.first < b.first;
+	});
+	std::string byMmsi;
+	for (const auto& sentence : expected) {
+		byMmsi += sentence.second;
+	}
+
+	NmeaFleetEncoder parallel(4);
+	NmeaFleetEncoder single(1);
+	BOOST_CHECK_EQUAL(parallel.threads(), 4u);
+	std::string output;
+	BOOST_CHECK_EQUAL(parallel.encode(targets.data(), targets.size(), NmeaFleetOrder_Mmsi, output), targets.size() - 1);
+	BOOST_CHECK(output == byMmsi);
+
+	std::string bySlot;
+	single.encode(targets.data(), targets.size(), NmeaFleetOrder_SlotTime, bySlot);
+	for (int run = 0; run < 3; ++run) {
+		parallel.encode(targets.data(), targets.size(), NmeaFleetOrder_SlotTime, output);
+		BOOST_CHECK(output == bySlot);
+	}
+
+	CaptureSink sink;
+	BOOST_CHECK_EQUAL(parallel.encode(targets.data(), 100, NmeaFleetOrder_SlotTime, sink), 99u);
+	BOOST_REQUIRE_EQUAL(sink.sentences.size(), 99u);
+	BOOST_CHECK_EQUAL(sink.sentences[0].compare(0, 7, "!AIVDM,"), 0);
+	BOOST_CHECK_EQUAL(parallel.encode(targets.data(), 0, NmeaFleetOrder_Mmsi, output), 0u);
+	BOOST_CHECK(output.empty());
+}
+
+BOOST_AUTO_TEST_CASE( aisReceivers )
+{
+	std::vector<NmeaAisTarget> targets(3000);
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		NmeaAisTarget& target = targets[i];
+		target.slotTime = i;
+		target.channel = 'A';
+		target.messageType = Nmea_AisMessageType_PositionReportClassA;
+		target.positionReportClassA = { 0, static_cast<uint>(200000000 + i), Nmea_NavigationStatus_UnderWayUsingEngine, 0, 10, Nmea_PositionAccuracy_DGPSQualityFix, static_cast<float>(-79 + (i * 7919 % 3001) / 1000.0), static_cast<float>(-13 + (i * 104729 % 2999) / 1000.0), 90, 90, 0, Nmea_ManeuverIndicator_NotAvailable, Nmea_RAIM_NotInUse };
+	}
+	targets[1].positionReportClassA.latitude = 91;
+	targets[2].messageType = Nmea_AisMessageType_BaseStationReport;
+	// Both sides of the antimeridian
+	targets[3].positionReportClassA.longitude = 179.95f;
+	targets[3].positionReportClassA.latitude = 60;
+	targets[4].positionReportClassA.longitude = -179.95f;
+	targets[4].positionReportClassA.latitude = 60;
+
+	NmeaAisReceivers network(20);
+	std::vector<CaptureSink> sinks(12);
+	for (std::size_t r = 0; r + 1 < sinks.size(); ++r) {
+		network.addReceiver(-13 + r * 0.3, -79 + r * 0.25, 15 + r * 2, sinks[r]);
+	}
+	BOOST_CHECK_EQUAL(network.addReceiver(60.05, 179.99, 10, sinks.back()), sinks.size() - 1);
+	network.moveReceiver(0, -11.5, -77.5);
+	BOOST_CHECK_THROW(network.moveReceiver(sinks.size(), 0, 0), std::out_of_range);
+
+	std::size_t written = network.broadcast(targets.data(), targets.size());
+	std::size_t total = 0;
+	for (std::size_t r = 0; r < sinks.size(); ++r) {
+		total += sinks[r].sentences.size();
+		for (const std::string& sentence : sinks[r].sentences) {
+			BOOST_CHECK_EQUAL(sentence.compare(0, 14, "!AIVDM,1,1,,A,"), 0);
+		}
+	}
+	BOOST_CHECK_EQUAL(written, total);
+	BOOST_REQUIRE_EQUAL(sinks.back().sentences.size(), 2u);
+	std::string nmea;
+	NmeaComposer::composeAISPositionReportClassA(nmea, targets[3].positionReportClassA, 'A');
+	BOOST_CHECK_EQUAL(sinks.back().sentences[0], nmea);
+
+	// Same sentences, in the same order, as composing every target for every receiver
+	NmeaAisReceivers bruteForce(1e4);
+	std::vector<CaptureSink> expected(sinks.size());
+	bruteForce.addReceiver(-11.5, -77.5, 15, expected[0]);
+	for (std::size_t r = 1; r + 1 < sinks.size(); ++r) {
+		bruteForce.addReceiver(-13 + r * 0.3, -79 + r * 0.25, 15 + r * 2, expected[r]);
+	}
+	bruteForce.addReceiver(60.05, 179.99, 10, expected.back());
+	BOOST_CHECK_EQUAL(bruteForce.broadcast(targets.data(), targets.size()), written);
+	for (std::size_t r = 0; r < sinks.size(); ++r) {
+		BOOST_CHECK(sinks[r].sentences == expected[r].sentences);
+	}
+	BOOST_CHECK_GT(written, network.composed());
+	BOOST_CHECK_LT(network.composed(), targets.size() - 3);
+	BOOST_CHECK_EQUAL(bruteForce.composed(), network.composed());
+}
+
+BOOST_AUTO_TEST_CASE( enumNames )
+{
+	static_assert(nmeaEnumName(Nmea_SentenceType_PRDID).length == 5, "constexpr name length");
+	BOOST_CHECK_EQUAL(nmeaEnumName(Nmea_NavigationStatus_AtAnchor).name, "AtAnchor");
+	BOOST_CHECK_EQUAL(nmeaEnumName(static_cast<Nmea_RAIM>(7)).name, "Unknown");
+
+	for (std::size_t i = 0; i < NmeaEnumTraits<Nmea_ShipType>::count; ++i) {
+		NmeaEnumName name = nmeaEnumName(static_cast<Nmea_ShipType>(i));
+		Nmea_ShipType shipType = Nmea_ShipType_NotAvailable;
+		BOOST_CHECK(nmeaEnumFromName(name.name, name.length, shipType));
+		BOOST_CHECK_EQUAL(static_cast<std::size_t>(shipType), i);
+	}
+	Nmea_EPFDFix fix = Nmea_EPFDFix_GPS;
+	BOOST_CHECK(!nmeaEnumFromName("Galileox", 8, fix));
+	BOOST_CHECK(nmeaEnumFromName("Galileox", 7, fix));
+	BOOST_CHECK(fix == Nmea_EPFDFix_Galileo);
+
+	std::ostringstream out;
+	out << Nmea_SentenceType_HDT << ' ' << nmeaEnumName(Nmea_AisMessageType_StaticDataReport).name;
+	BOOST_CHECK_EQUAL(out.str(), "HDT StaticDataReport");
+}
+
+BOOST_AUTO_TEST_CASE( onChange )
+{
+	const int64_t second = 1000000000;
+	NmeaOnChange onChange;
+	onChange.setDeadband(Nmea_SentenceType_VLW, 0.1);
+	onChange.setKeepAlive(Nmea_SentenceType_VLW, 10 * second);
+	onChange.setDeadband(Nmea_SentenceType_MWD, 5);
+	onChange.setDeadband(Nmea_SentenceType_MWD, 2, 1.0);
+	onChange.setDeadband(Nmea_SentenceType_MWD, 3, 0.5);
+	NmeaComposerValid validity = 0L;
+	std::string nmea;
+	std::string expected;
+
+	BOOST_CHECK(onChange.composeVLW(nmea, "VW", validity, 100, 10, 0));
+	NmeaComposer::composeVLW(expected, "VW", validity, 100, 10);
+	BOOST_CHECK_EQUAL(nmea, expected);
+	nmea.clear();
+	BOOST_CHECK(!onChange.composeVLW(nmea, "VW", validity, 100.05, 10.05, second));
+	BOOST_CHECK(nmea.empty());
+	BOOST_CHECK(onChange.composeVLW(nmea, "VD", validity, 100.05, 10.05, second));
+	BOOST_CHECK(onChange.composeVLW(nmea, "VW", validity, 100.2, 10.05, 2 * second));
+	BOOST_CHECK(!onChange.composeVLW(nmea, "VW", validity, 100.25, 10.08, 3 * second));
+	BOOST_CHECK(onChange.composeVLW(nmea, "VW", 2L, 100.25, 10.08, 4 * second));
+	BOOST_CHECK(!onChange.composeVLW(nmea, "VW", 2L, 100.25, 10.08, 13 * second));
+	BOOST_CHECK(onChange.composeVLW(nmea, "VW", 2L, 100.25, 10.08, 14 * second));
+	BOOST_CHECK(onChange.composeVLW(nmea, "VW", 2L, NAN, 10.08, 15 * second));
+	BOOST_CHECK(!onChange.composeVLW(nmea, "VW", 2L, NAN, 10.08, 16 * second));
+
+	// Wind direction wraps, speeds have their own deadbands
+	BOOST_CHECK(onChange.composeMWD(nmea, "WI", validity, 358, 356, 10, 5.1, 0));
+	BOOST_CHECK(!onChange.composeMWD(nmea, "WI", validity, 2, 0, 10.9, 5.5, 0));
+	BOOST_CHECK(onChange.composeMWD(nmea, "WI", validity, 4, 0, 10.9, 5.5, 0));
+	BOOST_CHECK(onChange.composeMWD(nmea, "WI", validity, 4, 0, 10.9, 6.0, 0));
+
+	std::vector<TransducerMeasurement> measurements = { { 'C', 23.4f, 'C', "AIRTEMP" } };
+	BOOST_CHECK(onChange.composeXDR(nmea, "YX", validity, measurements, 0));
+	BOOST_CHECK(!onChange.composeXDR(nmea, "YX", validity, measurements, 0));
+	measurements[0].nameOfTransducer = "WATERTEMP";
+	BOOST_CHECK(onChange.composeXDR(nmea, "YX", validity, measurements, 0));
+	measurements.push_back(measurements[0]);
+	BOOST_CHECK(onChange.composeXDR(nmea, "YX", validity, measurements, 0));
+
+	// Groups of transducers of one talker are followed apart
+	std::vector<TransducerMeasurement> temperatures = { { 'C', 12.3f, 'C', "AIRTEMP" }, { 'C', 15.1f, 'C', "WATERTEMP" } };
+	std::vector<TransducerMeasurement> pressures = { { 'P', 1.0132f, 'B', "BARO" } };
+	BOOST_CHECK(onChange.composeXDR(nmea, "WI", validity, temperatures, 0));
+	BOOST_CHECK(onChange.composeXDR(nmea, "WI", validity, pressures, 0));
+	for (int i = 1; i <= 3; ++i) {
+		BOOST_CHECK(!onChange.composeXDR(nmea, "WI", validity, temperatures, i * second));
+		BOOST_CHECK(!onChange.composeXDR(nmea, "WI", validity, pressures, i * second));
+	}
+	pressures[0].measurementData = 1.0135f;
+	BOOST_CHECK(onChange.composeXDR(nmea, "WI", validity, pressures, 4 * second));
+	BOOST_CHECK(!onChange.composeXDR(nmea, "WI", validity, temperatures, 4 * second));
+
+	BOOST_CHECK(onChange.composeMWV(nmea, "WI", validity, 30, Nmea_AngleReference_Relative, 12, 'N', 'A', 0));
+	BOOST_CHECK(onChange.composeMWV(nmea, "WI", validity, 30, Nmea_AngleReference_True, 12, 'N', 'A', 0));
+	BOOST_CHECK(onChange.composeHDT(nmea, "HE", validity, 359.5, 0));
+	BOOST_CHECK(!onChange.composeHDT(nmea, "HE", validity, 359.5, 0));
+	const double inputs[] = { 1, 2 };
+	BOOST_CHECK(onChange.changed(Nmea_SentenceType_PRDID, "", validity, inputs, 2, 0));
+	BOOST_CHECK(!onChange.changed(Nmea_SentenceType_PRDID, "", validity, inputs, 2, 0));
+	onChange.reset();
+	BOOST_CHECK(onChange.changed(Nmea_SentenceType_PRDID, "", validity, inputs, 2, 0));
+}
+
+BOOST_AUTO_TEST_CASE( tagBlock )
+{
+	char buffer[128];
+	NmeaTagBlock source("GP0001");
+	BOOST_CHECK_EQUAL(source.write(buffer, sizeof(buffer), 1461168378123456789LL), 30u);
+	BOOST_CHECK_EQUAL(buffer, "\\s:GP0001,c:1461168378,n:1*62\\");
+	NmeaTagBlock untimed("GP0001");
+	std::string tag(buffer, untimed.write(buffer, sizeof(buffer), -1));
+	BOOST_CHECK_EQUAL(tag, "\\s:GP0001,n:1*16\\");
+
+	NmeaTagBlock bridge("II0003", "VR0001", NmeaTagTime_Milliseconds);
+	NmeaComposerValid validity = 0L;
+	std::string nmeaHDT;
+	NmeaComposer::composeHDT(nmeaHDT, "HE", validity, 57.34);
+	std::size_t length = bridge.compose(buffer, sizeof(buffer), 1461168378123456789LL, [&](char* text, std::size_t size) {
+		return NmeaComposerCore::composeHDT(text, size, "HE", validity, 57.34);
+	});
+	std::string expectedTag = "s:II0003,d:VR0001,c:1461168378123,n:1";
+	char checksum[3];
+	std::snprintf(checksum, sizeof(checksum), "%02X", xorOf(expectedTag.data(), expectedTag.size()));
+	std::string expected = "\\" + expectedTag + "*" + checksum + "\\" + nmeaHDT;
+	BOOST_CHECK_EQUAL(length, expected.size());
+	BOOST_CHECK_EQUAL(buffer, expected);
+	char small[20];
+	BOOST_CHECK_EQUAL(bridge.compose(small, sizeof(small), 0, [&](char* text, std::size_t size) {
+		return NmeaComposerCore::composeHDT(text, size, "HE", validity, 57.34);
+	}), std::strlen("\\s:II0003,d:VR0001,c:0,n:2*00\\") + nmeaHDT.size());
+	BOOST_CHECK_EQUAL(small, "\\s:II0003,d:VR0001,");
+
+	std::vector<std::thread> threads;
+	std::vector<std::vector<uint64_t> > lines(4);
+	for (std::size_t t = 0; t < lines.size(); ++t) {
+		threads.emplace_back([&, t] {
+			char line[128];
+			for (int i = 0; i < 1000; ++i) {
+				source.write(line, sizeof(line), 0);
+				lines[t].push_back(std::strtoull(std::strstr(line, "n:") + 2, NULL, 10));
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	BOOST_CHECK_EQUAL(source.lines(), 4001u);
+	std::set<uint64_t> unique;
+	for (const std::vector<uint64_t>& numbers : lines) {
+		BOOST_CHECK(std::is_sorted(numbers.begin(), numbers.end()));
+		unique.insert(numbers.begin(), numbers.end());
+	}
+	BOOST_CHECK_EQUAL(unique.size(), 4000u);
+	BOOST_CHECK_EQUAL(*unique.begin(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE( journal )
+{
+	char directory[] = "/tmp/nmeajournal.XXXXXX";
+	BOOST_REQUIRE(mkdtemp(directory) != NULL);
+
+	std::string nmeaHDT;
+	NmeaComposerValid validity = 0L;
+	const int64_t startUtcNs = 1461168378000000000LL;
+	const int64_t periodNs = 100000000LL;
+
+	{
+		NmeaJournal journal(directory, 4096, 1024);
+		for (int i = 0; i < 600; ++i) {
+			NmeaComposer::composeHDT(nmeaHDT, "HE", validity, i * 0.5);
+			journal.append(nmeaHDT.data(), nmeaHDT.size(), i, startUtcNs + i * periodNs);
+		}
+	}
+
+	NmeaJournalReader reader(directory);
+	BOOST_CHECK_GT(reader.segmentCount(), 1u);
+
+	NmeaJournalRecord record;
+	BOOST_REQUIRE(reader.seek(startUtcNs + 123 * periodNs + periodNs / 2));
+	BOOST_REQUIRE(reader.next(record));
+	BOOST_CHECK_EQUAL(record.utcNs, startUtcNs + 124 * periodNs);
+	BOOST_CHECK_EQUAL(record.monotonicNs, 124);
+	NmeaComposer::composeHDT(nmeaHDT, "HE", validity, 124 * 0.5);
+	BOOST_CHECK_EQUAL(std::string(record.sentence, record.length), nmeaHDT);
+
+	int remaining = 0;
+	while (reader.next(record)) {
+		++remaining;
+	}
+	BOOST_CHECK_EQUAL(remaining, 600 - 125);
+
+	BOOST_CHECK(!reader.seek(startUtcNs + 600 * periodNs));
+	BOOST_CHECK(reader.seek(startUtcNs - periodNs));
+	BOOST_REQUIRE(reader.next(record));
+	BOOST_CHECK_EQUAL(record.utcNs, startUtcNs);
+
+	removeDirectory(directory);
+}
+
+BOOST_AUTO_TEST_CASE( replay )
+{
+	char path[] = "/tmp/nmeareplay.XXXXXX";
+	int fd = mkstemp(path);
+	BOOST_REQUIRE(fd >= 0);
+	close(fd);
+
+	std::string nmeaRMC;
+	std::string nmeaPRDID;
+	NmeaComposerValid validity = 0L;
+	boost::gregorian::date mdate(2016, 4, 20);
+	{
+		std::ofstream out(path, std::ios::binary);
+		for (int i = 0; i < 10; ++i) {
+			boost::posix_time::time_duration mtime(16, 6, 18 + i, 0);
+			NmeaComposer::composeRMC(nmeaRMC, "GP", validity, mtime, -12.042189972, -77.14246383, 0.1, 166.87, mdate, -1.4);
+			NmeaComposer::composePRDID(nmeaPRDID, validity, -10, 37.5, 100 + i);
+			out << nmeaRMC << "\r\n" << nmeaPRDID << "\r\n";
+		}
+	}
+
+	for (int pass = 0; pass < 2; ++pass) {
+		// First pass builds the index, second pass loads it
+		NmeaReplay replay(path);
+		BOOST_CHECK_EQUAL(replay.size(), 20u);
+
+		CaptureSink sink;
+		replay.addSink(sink);
+		replay.setSpeed(0.0);
+		BOOST_CHECK_EQUAL(replay.run(), 20u);
+		BOOST_CHECK_EQUAL(sink.flushes, 1);
+		BOOST_CHECK_EQUAL(sink.sentences.back(), nmeaPRDID);
+
+		sink.sentences.clear();
+		BOOST_REQUIRE(replay.seek(boost::posix_time::ptime(mdate, boost::posix_time::time_duration(16, 6, 25, 500000))));
+		BOOST_CHECK_EQUAL(replay.run(), 4u);
+		BOOST_CHECK_EQUAL(sink.sentences.front().substr(0, 17), "$GPRMC,160626.000");
+	}
+
+	{
+		// A stop before run is not lost, and only affects that run
+		NmeaReplay stopped(path);
+		CaptureSink sink;
+		stopped.addSink(sink);
+		stopped.setSpeed(1.0);
+		stopped.stop();
+		BOOST_CHECK_EQUAL(stopped.run(), 0u);
+		BOOST_CHECK_EQUAL(sink.flushes, 1);
+		stopped.setSpeed(0.0);
+		BOOST_CHECK_EQUAL(stopped.run(), 20u);
+	}
+
+	NmeaReplay replay(path);
+	CaptureSink sink;
+	replay.addSink(sink);
+	replay.setSpeed(100.0);
+	replay.seek(boost::posix_time::ptime(mdate, boost::posix_time::time_duration(16, 6, 24, 0)));
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	BOOST_CHECK_EQUAL(replay.run(), 8u);
+	BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+
+	unlink(path);
+	unlink((std::string(path) + ".idx").c_str());
+}
+
+BOOST_AUTO_TEST_CASE( archive )
+{
+	char path[] = "/tmp/nmeaarchive.XXXXXX";
+	int fd = mkstemp(path);
+	BOOST_REQUIRE(fd >= 0);
+	close(fd);
+
+	std::vector<std::string> expected;
+	std::size_t textBytes = 0;
+	std::string nmea;
+	const int64_t startUtcNs = 1461168378000000000LL;
+	const int64_t periodNs = 1000000000LL;
+	boost::gregorian::date mdate(2016, 4, 20);
+
+	std::vector<TransducerMeasurement> measurements(2);
+	measurements[0].transducerType = 'C';
+	measurements[0].unitsOfMeasurement = 'C';
+	measurements[0].nameOfTransducer = "TEMP";
+	measurements[1].transducerType = 'P';
+	measurements[1].unitsOfMeasurement = 'B';
+	measurements[1].nameOfTransducer = "PRESS";
+
+	{
+		NmeaArchiveWriter writer(path, 1000);
+		for (int i = 0; i < 3000; ++i) {
+			int64_t utcNs = startUtcNs + i * periodNs;
+			NmeaComposerValid validity = (i % 97 == 0) ? 0x5L : 0L;
+			boost::posix_time::time_duration mtime = boost::posix_time::seconds(58000 + i) + boost::posix_time::milliseconds(i % 1000);
+			double latitude = 0.0002 - i * 0.0000001234;
+			double longitude = -77.14246383 + i * 0.00000217;
+			double speedknots = 12.3 + std::sin(i * 0.01);
+			double coursetrue = 166.87 + i * 0.003;
+			double magneticvar = 0.03 - i * 0.00002;
+
+			writer.appendRMC(utcNs, "GP", validity, mtime, latitude, longitude, speedknots, coursetrue, mdate, magneticvar);
+			NmeaComposer::composeRMC(nmea, "GP", validity, mtime, latitude, longitude, speedknots, coursetrue, mdate, magneticvar);
+			expected.push_back(nmea);
+			textBytes += nmea.size();
+
+			if (i % 10 == 0) {
+				measurements[0].measurementData = 16.4f - i * 0.001f;
+				measurements[1].measurementData = 1.0079f + i * 0.00001f;
+				writer.appendXDR(utcNs + 1, "WI", validity, measurements);
+				NmeaComposer::composeXDR(nmea, "WI", validity, measurements);
+				expected.push_back(nmea);
+				textBytes += nmea.size();
+			}
+
+			double pitch = -0.004 + i * 0.0001;
+			writer.appendPRDID(utcNs + 2, validity, pitch, 37.5 - i * 0.01, 100 + i * 0.001);
+			NmeaComposer::composePRDID(nmea, validity, pitch, 37.5 - i * 0.01, 100 + i * 0.001);
+			expected.push_back(nmea);
+			textBytes += nmea.size();
+		}
+	}
+
+	struct stat st;
+	BOOST_REQUIRE(stat(path, &st) == 0);
+	BOOST_CHECK_LT(static_cast<std::size_t>(st.st_size) * 5, textBytes);
+
+	NmeaArchiveReader reader(path);
+	BOOST_CHECK_EQUAL(reader.size(Nmea_SentenceType_RMC), 3000u);
+	BOOST_CHECK_EQUAL(reader.size(Nmea_SentenceType_XDR), 300u);
+
+	CaptureSink sink;
+	BOOST_CHECK_EQUAL(reader.regenerate(startUtcNs, startUtcNs + 3000 * periodNs, sink), expected.size());
+	BOOST_REQUIRE_EQUAL(sink.sentences.size(), expected.size());
+	for (std::size_t i = 0; i < expected.size(); ++i) {
+		BOOST_CHECK_EQUAL(sink.sentences[i], expected[i]);
+	}
+
+	sink.sentences.clear();
+	BOOST_CHECK_EQUAL(reader.regenerate(Nmea_SentenceType_XDR, startUtcNs + 1500 * periodNs, startUtcNs + 1600 * periodNs, sink), 10u);
+
+	unlink(path);
+
+	// A full disk surfaces on flush instead of dropping blocks
+	if (access("/dev/full", W_OK) == 0) {
+		NmeaArchiveWriter full("/dev/full", 1);
+		full.appendPRDID(startUtcNs, NmeaComposerValid(), 1.0, 2.0, 3.0);
+		BOOST_CHECK_THROW(full.flush(), std::system_error);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( streamCodec )
+{
+	NmeaStreamEncoder encoder;
+	NmeaStreamDecoder decoder;
+	CaptureSink sink;
+
+	std::vector<std::string> sentences;
+	std::string nmea;
+	NmeaComposerValid validity = 0L;
+	boost::gregorian::date mdate(2016, 4, 20);
+	for (int i = 0; i < 600; ++i) {
+		boost::posix_time::time_duration mtime = boost::posix_time::seconds(58000 + i);
+		NmeaComposer::composeRMC(nmea, "GP", validity, mtime, -12.042189972 + i * 0.00001, -77.14246383 - i * 0.00002, 12.1 + (i % 7) * 0.1, 166.87, mdate, -1.4);
+		sentences.push_back(nmea);
+		NmeaComposer::composePRDID(nmea, validity, -10 + (i % 5) * 0.01, 37.5, 100 + i * 0.01);
+		sentences.push_back(nmea);
+		NmeaComposer::composeHDT(nmea, "HE", validity, 100 + i * 0.01);
+		sentences.push_back(nmea + "\r\n");
+	}
+	sentences.push_back("$GPHDT,100.00,T*00");
+	sentences.push_back("\\s:GP0001,c:1461168378*5A\\$GPHDT,100.00,T*2B");
+	sentences.push_back("garbage");
+	sentences.push_back("");
+
+	std::size_t rawBytes = 0;
+	std::size_t encodedBytes = 0;
+	std::string frame;
+	for (std::size_t first = 0; first < sentences.size(); first += 30) {
+		std::size_t last = std::min(first + 30, sentences.size());
+		for (std::size_t i = first; i < last; ++i) {
+			encoder.encode(sentences[i]);
+			rawBytes += sentences[i].size();
+		}
+		encoder.finish(frame);
+		encodedBytes += frame.size();
+		BOOST_CHECK_EQUAL(decoder.decode(frame.data(), frame.size(), sink), last - first);
+	}
+
+	BOOST_REQUIRE_EQUAL(sink.sentences.size(), sentences.size());
+	for (std::size_t i = 0; i < sentences.size(); ++i) {
+		BOOST_CHECK_EQUAL(sink.sentences[i], sentences[i]);
+	}
+	BOOST_CHECK_LT(encodedBytes * 5, rawBytes);
+
+	encoder.reset();
+	decoder.reset();
+	encoder.encode(sentences[0]);
+	encoder.finish(frame);
+	sink.sentences.clear();
+	BOOST_CHECK_EQUAL(decoder.decode(frame.data(), frame.size(), sink), 1u);
+	BOOST_CHECK_EQUAL(sink.sentences[0], sentences[0]);
+
+	// Raw input longer than a length field holds, and exactly as long
+	std::string longRaw(70000, 'x');
+	longRaw[65534] = 'y';
+	longRaw[65535] = 'z';
+	encoder.encode(longRaw);
+	encoder.encode(longRaw.substr(0, 65535));
+	encoder.encode(sentences[1]);
+	encoder.finish(frame);
+	sink.sentences.clear();
+	BOOST_CHECK_EQUAL(decoder.decode(frame.data(), frame.size(), sink), 3u);
+	BOOST_REQUIRE_EQUAL(sink.sentences.size(), 3u);
+	BOOST_CHECK(sink.sentences[0] == longRaw);
+	BOOST_CHECK(sink.sentences[1] == longRaw.substr(0, 65535));
+	BOOST_CHECK_EQUAL(sink.sentences[2], sentences[1]);
+}
+
+BOOST_AUTO_TEST_CASE( router )
+{
+	CaptureSink everything;
+	CaptureSink heading;
+	CaptureSink decimated;
+	CaptureSink unused;
+	NmeaRouter router;
+	BOOST_CHECK_EQUAL(router.addSink(everything), 0u);
+	NmeaRouteFilter headingFilter;
+	headingFilter.types.reset();
+	headingFilter.types.set(Nmea_SentenceType_HDT);
+	headingFilter.talkers = { "HE" };
+	router.addSink(heading, headingFilter);
+	NmeaRouteFilter decimatedFilter;
+	decimatedFilter.types.reset(Nmea_SentenceType_HDT);
+	decimatedFilter.talkers = { "GP", "" };
+	decimatedFilter.decimation = 3;
+	router.addSink(decimated, decimatedFilter);
+	NmeaRouteFilter unusedFilter;
+	unusedFilter.types.reset();
+	unusedFilter.types.set(Nmea_SentenceType_MWV);
+	BOOST_CHECK_EQUAL(router.addSink(unused, unusedFilter), 3u);
+	BOOST_CHECK_EQUAL(router.sinks(), 4u);
+
+	NmeaStatistics::reset();
+	NmeaStatistics::setLatencySampling(1);
+	int64_t sensorNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	NmeaComposerValid validity = 0L;
+	std::vector<std::string> headings;
+	std::vector<std::string> others;
+	for (int i = 0; i < 30; ++i) {
+		const char* talker = i % 2 ? "HE" : "GP";
+		BOOST_CHECK_EQUAL(router.route(Nmea_SentenceType_HDT, talker, [&](char* buffer, std::size_t size) {
+			return NmeaComposer::composeHDT(buffer, size, talker, validity, i);
+		}, sensorNs), i % 2 ? 2u : 1u);
+		std::string nmea;
+		NmeaComposer::composeHDT(nmea, talker, validity, i);
+		headings.push_back(nmea);
+
+		NmeaComposer::composePRDID(nmea, validity, i, -i, 100);
+		router.route(Nmea_SentenceType_PRDID, "", nmea.data(), nmea.size());
+		others.push_back(nmea);
+	}
+	std::vector<TransducerMeasurement> measurements(12, TransducerMeasurement { 'C', 23.4f, 'C', "AIRTEMPERATURE" });
+	router.route(Nmea_SentenceType_XDR, "YX", [&](char* buffer, std::size_t size) {
+		return NmeaComposer::composeXDR(buffer, size, "YX", validity, measurements);
+	});
+	std::string nmeaXDR;
+	NmeaComposer::composeXDR(nmeaXDR, "YX", validity, measurements);
+	BOOST_CHECK_GT(nmeaXDR.size(), 128u);
+	// A throwing composer releases its buffer and queues nothing, on either call
+	for (std::size_t fits : { 0u, 1000u }) {
+		BOOST_CHECK_THROW(router.route(Nmea_SentenceType_MWV, "WI", [&](char*, std::size_t size) -> std::size_t {
+			if (size < fits) {
+				return fits;
+			}
+			throw std::runtime_error("compose failed");
+		}), std::runtime_error);
+	}
+	router.flush();
+
+	NmeaRouter windOnly;
+	windOnly.addSink(unused, unusedFilter);
+	BOOST_CHECK_EQUAL(windOnly.route(Nmea_SentenceType_MWD, "WI", [](char*, std::size_t) -> std::size_t {
+		BOOST_ERROR("composed without destination");
+		return 0;
+	}), 0u);
+	NmeaStatistics::setLatencySampling(64);
+
+	BOOST_REQUIRE_EQUAL(everything.sentences.size(), 61u);
+	BOOST_CHECK_EQUAL(everything.sentences[0], headings[0]);
+	BOOST_CHECK_EQUAL(everything.sentences[1], others[0]);
+	BOOST_CHECK_EQUAL(everything.sentences[60], nmeaXDR);
+	BOOST_CHECK_EQUAL(everything.flushes, 1);
+	BOOST_REQUIRE_EQUAL(heading.sentences.size(), 15u);
+	for (std::size_t i = 0; i < heading.sentences.size(); ++i) {
+		BOOST_CHECK_EQUAL(heading.sentences[i], headings[2 * i + 1]);
+	}
+	BOOST_REQUIRE_EQUAL(decimated.sentences.size(), 10u);
+	for (std::size_t i = 0; i < decimated.sentences.size(); ++i) {
+		BOOST_CHECK_EQUAL(decimated.sentences[i], others[3 * i]);
+	}
+	BOOST_CHECK(unused.sentences.empty());
+
+	NmeaStatisticsSnapshot counters;
+	NmeaStatistics::snapshot(counters);
+	BOOST_CHECK_EQUAL(counters.sentences[Nmea_SentenceType_HDT].composed, 60u);
+	NmeaLatencySnapshot latencies;
+	NmeaStatistics::latencySnapshot(latencies);
+	BOOST_CHECK_EQUAL(latencies.sensorToWire[Nmea_SentenceType_HDT].samples, 45u);
+}
+
+BOOST_AUTO_TEST_CASE( statistics )
+{
+	NmeaStatistics::reset();
+
+	std::string nmeaHDT;
+	NmeaComposerValid validity = 0L;
+	NmeaComposer::composeHDT(nmeaHDT, "HE", validity, 57.34);
+	std::size_t bytes = nmeaHDT.size();
+	NmeaComposer::composeHDT(nmeaHDT, "HEX", 0x1L, 57.34);
+	bytes += nmeaHDT.size();
+
+	std::string nmeaVLW;
+	NmeaComposer::composeVLW(nmeaVLW, "VD", 0xFFFFL, 20.70, 1.20);
+
+	NmeaStatisticsSnapshot snapshot;
+	NmeaStatistics::snapshot(snapshot);
+	BOOST_CHECK_EQUAL(snapshot.sentences[Nmea_SentenceType_HDT].composed, 2u);
+	BOOST_CHECK_EQUAL(snapshot.sentences[Nmea_SentenceType_HDT].bytes, bytes);
+	BOOST_CHECK_EQUAL(snapshot.sentences[Nmea_SentenceType_HDT].invalidFields, 1u);
+	BOOST_CHECK_EQUAL(snapshot.sentences[Nmea_SentenceType_HDT].errors, 1u);
+	BOOST_CHECK_EQUAL(snapshot.sentences[Nmea_SentenceType_VLW].invalidFields, 2u);
+	BOOST_CHECK_EQUAL(snapshot.sentences[Nmea_SentenceType_RMC].composed, 0u);
+
+	std::string text;
+	NmeaStatistics::writePrometheus(text);
+	BOOST_CHECK(text.find("nmea_sentences_composed_total{type=\"HDT\"} 2\n") != std::string::npos);
+	BOOST_CHECK(text.find("# TYPE nmea_errors_total counter\n") != std::string::npos);
+
+	char path[] = "/tmp/nmeastatistics.XXXXXX";
+	int fd = mkstemp(path);
+	BOOST_REQUIRE(fd >= 0);
+	close(fd);
+	NmeaStatistics::exportPrometheusFile(path);
+	std::ifstream in(path);
+	std::string exported((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	BOOST_CHECK_EQUAL(exported, text);
+	unlink(path);
+
+	BOOST_CHECK_THROW(NmeaStatistics::exportPrometheusSocket("/tmp/nmeastatistics.missing.sock"), std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE( latency )
+{
+	NmeaStatistics::reset();
+	NmeaStatistics::setLatencySampling(1);
+
+	std::string nmeaHDT;
+	for (int i = 0; i < 100; ++i) {
+		NmeaComposer::composeHDT(nmeaHDT, "HE", 0L, i);
+	}
+	int64_t sensorNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count() - 5000000;
+	NmeaStatistics::recordSensorToWire(Nmea_SentenceType_HDT, sensorNs);
+
+	NmeaStatistics::setLatencySampling(4);
+	for (int i = 0; i < 100; ++i) {
+		NmeaComposer::composeVLW(nmeaHDT, "VD", 0L, i, i);
+	}
+	NmeaStatistics::setLatencySampling(64);
+
+	NmeaLatencySnapshot snapshot;
+	NmeaStatistics::latencySnapshot(snapshot);
+	const NmeaLatencyPercentiles& compose = snapshot.compose[Nmea_SentenceType_HDT];
+	BOOST_CHECK_EQUAL(compose.samples, 100u);
+	BOOST_CHECK(compose.p50Ns > 0);
+	BOOST_CHECK(compose.p50Ns <= compose.p99Ns);
+	BOOST_CHECK(compose.p99Ns <= compose.p999Ns);
+	BOOST_CHECK(compose.p999Ns <= compose.maxNs);
+	BOOST_CHECK_EQUAL(snapshot.compose[Nmea_SentenceType_VLW].samples, 25u);
+	BOOST_CHECK_EQUAL(snapshot.compose[Nmea_SentenceType_RMC].samples, 0u);
+
+	const NmeaLatencyPercentiles& sensorToWire = snapshot.sensorToWire[Nmea_SentenceType_HDT];
+	BOOST_CHECK_EQUAL(sensorToWire.samples, 1u);
+	BOOST_CHECK(sensorToWire.p50Ns >= 5000000);
+	BOOST_CHECK_GE(sensorToWire.sumNs, 5000000u);
+	BOOST_CHECK_GE(compose.sumNs, 100u * compose.p50Ns / 4);
+	BOOST_CHECK_EQUAL(sensorToWire.p999Ns, sensorToWire.p50Ns);
+
+	std::string text;
+	NmeaStatistics::writePrometheus(text);
+	BOOST_CHECK(text.find("# TYPE nmea_compose_latency_seconds summary\n") != std::string::npos);
+	BOOST_CHECK(text.find("nmea_compose_latency_seconds_count{type=\"HDT\"} 100\n") != std::string::npos);
+	BOOST_CHECK(text.find("nmea_sensor_to_wire_latency_seconds_sum{type=\"HDT\"} 0.0") != std::string::npos);
+	BOOST_CHECK(text.find("nmea_compose_latency_seconds_sum{type=\"RMC\"} 0\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE( latencyInterleaved )
+{
+	NmeaStatistics::reset();
+	NmeaStatistics::setLatencySampling(64);
+	int64_t sensorNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	// Compose then hand off, every histogram counts its own calls
+	std::string nmea;
+	for (int i = 0; i < 6400; ++i) {
+		NmeaComposer::composeHDT(nmea, "HE", 0L, i);
+		NmeaStatistics::recordSensorToWire(Nmea_SentenceType_HDT, sensorNs);
+	}
+	NmeaLatencySnapshot snapshot;
+	NmeaStatistics::latencySnapshot(snapshot);
+	BOOST_CHECK_EQUAL(snapshot.compose[Nmea_SentenceType_HDT].samples, 100u);
+	BOOST_CHECK_EQUAL(snapshot.sensorToWire[Nmea_SentenceType_HDT].samples, 100u);
+
+	// Two types composed alternately
+	NmeaStatistics::reset();
+	for (int i = 0; i < 6400; ++i) {
+		NmeaComposer::composeHDT(nmea, "HE", 0L, i);
+		NmeaComposer::composeVLW(nmea, "VD", 0L, i, i);
+	}
+	NmeaStatistics::latencySnapshot(snapshot);
+	BOOST_CHECK_EQUAL(snapshot.compose[Nmea_SentenceType_HDT].samples, 100u);
+	BOOST_CHECK_EQUAL(snapshot.compose[Nmea_SentenceType_VLW].samples, 100u);
+}
+
+BOOST_AUTO_TEST_CASE( asyncLog )
+{
+	typedef boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend> TextSink;
+	boost::shared_ptr<std::ostringstream> stream = boost::make_shared<std::ostringstream>();
+	boost::shared_ptr<TextSink> sink = boost::make_shared<TextSink>();
+	sink->locked_backend()->add_stream(stream);
+	boost::log::core::get()->add_sink(sink);
+
+	NmeaLog::flush();
+	uint64_t dropped = NmeaLog::dropped();
+	std::string field = "057.34";
+	std::string sentence = "$HEHDT,057.34,T*1E";
+	std::string longField(200, 'x');
+	std::thread producer([&] {
+		NmeaLog::field(Nmea_SentenceType_HDT, 1, field.data(), field.size());
+		NmeaLog::sentence(Nmea_SentenceType_HDT, sentence.data(), sentence.size());
+	});
+	producer.join();
+	NmeaLog::field(Nmea_SentenceType_XDR, 3, longField.data(), longField.size());
+	NmeaLog::flush();
+
+	boost::log::core::get()->remove_sink(sink);
+	sink->flush();
+	std::string text = stream->str();
+	BOOST_CHECK(text.find("HDT field 1: 057.34\n") != std::string::npos);
+	BOOST_CHECK(text.find("HDT sentence: $HEHDT,057.34,T*1E\n") != std::string::npos);
+	BOOST_CHECK(text.find("XDR field 3: " + std::string(120, 'x') + "...\n") != std::string::npos);
+	BOOST_CHECK_EQUAL(NmeaLog::dropped(), dropped);
+}
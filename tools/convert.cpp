@@ -0,0 +1,630 @@
+/*
+ * convert.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: steve
+ */
+
+#include "NmeaComposerCore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @cond
+namespace {
+
+/*
+ * Record of a binary log, in native byte order. values by type:
+ * RMC latitude, longitude, speed, course, magnetic variation, time from utcNs;
+ * MWV angle, speed, reference (0 true, 1 relative), units and status as ASCII;
+ * the others their composer parameters in order.
+ */
+struct BinaryRecord {
+	uint8_t type; // Nmea_SentenceType
+	char talker[2];
+	uint8_t spare;
+	uint16_t validity; // NmeaComposerValid bits, set for an invalid field
+	uint16_t reserved;
+	int64_t utcNs;
+	double values[6];
+};
+
+static_assert(sizeof(BinaryRecord) == 64, "BinaryRecord layout");
+
+enum Format {
+	Format_Csv, Format_Binary
+};
+
+const std::size_t maxTransducers = 16;
+const std::size_t maxNameLength = 31;
+
+/*
+ * Sentences of one chunk, CR LF terminated.
+ */
+struct Slot {
+	std::vector<char> text;
+	std::size_t length;
+	bool ready;
+};
+
+/*
+ * Appends a sentence composed by compose(buffer, size), growing the slot
+ * only when it does not fit.
+ */
+template<typename Compose>
+void append(Slot& slot, Compose compose) {
+	std::size_t room = slot.text.size() - slot.length;
+	std::size_t length = compose(slot.text.data() + slot.length, room);
+	if (length + 2 > room) {
+		slot.text.resize(std::max(slot.text.size() * 2,
+				slot.length + length + 2));
+		length = compose(slot.text.data() + slot.length,
+				slot.text.size() - slot.length);
+	}
+	slot.length += length;
+	slot.text[slot.length++] = '\r';
+	slot.text[slot.length++] = '\n';
+}
+
+/*
+ * UTC time of day and date of a Unix time in nanoseconds.
+ */
+void utcOf(int64_t utcNs, std::chrono::microseconds& time, NmeaDate& date) {
+	const int64_t dayNs = 86400000000000LL;
+	int64_t days = utcNs / dayNs;
+	int64_t ns = utcNs % dayNs;
+	if (ns < 0) {
+		ns += dayNs;
+		--days;
+	}
+	time = std::chrono::microseconds(ns / 1000);
+
+	// Civil date of a day count, H. Hinnant's algorithm
+	days += 719468;
+	int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+	int64_t dayOfEra = days - era * 146097;
+	int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524
+			- dayOfEra / 146096) / 365;
+	int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4
+			- yearOfEra / 100);
+	int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+	date.day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+	date.month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 :
+			monthIndex - 9);
+	date.year = static_cast<int>(yearOfEra + era * 400 + (date.month <= 2));
+}
+
+/*
+ * Fields of one CSV line.
+ */
+class CsvLine {
+public:
+	CsvLine(const char* begin, const char* end) :
+			position(begin), end(end), done(false) {
+	}
+
+	bool next(const char*& field, std::size_t& length) {
+		if (done) {
+			return false;
+		}
+		field = position;
+		const char* comma = static_cast<const char*>(std::memchr(position, ',',
+				end - position));
+		if (comma == NULL) {
+			comma = end;
+			done = true;
+		}
+		length = comma - position;
+		position = comma + 1;
+		return true;
+	}
+
+	/*
+	 * Next field as a number, false when missing or empty.
+	 */
+	bool number(double& value) {
+		const char* field;
+		std::size_t length;
+		if (!next(field, length) || length == 0 || length > 63) {
+			return false;
+		}
+		char text[64];
+		std::memcpy(text, field, length);
+		text[length] = '\0';
+		char* stop;
+		value = std::strtod(text, &stop);
+		return stop == text + length;
+	}
+
+	/*
+	 * Next field as a character, false when missing or empty.
+	 */
+	bool character(char& value) {
+		const char* field;
+		std::size_t length;
+		if (!next(field, length) || length == 0) {
+			return false;
+		}
+		value = field[0];
+		return true;
+	}
+
+	/*
+	 * Next field copied null terminated into out, cut to size - 1.
+	 */
+	bool text(char* out, std::size_t size) {
+		const char* field;
+		std::size_t length;
+		if (!next(field, length)) {
+			return false;
+		}
+		length = std::min(length, size - 1);
+		std::memcpy(out, field, length);
+		out[length] = '\0';
+		return true;
+	}
+
+private:
+	const char* position;
+	const char* end;
+	bool done;
+};
+
+/*
+ * Reads count numbers into values, flagging the empty ones invalid from
+ * validity bit first.
+ */
+void numbers(CsvLine& line, double* values, std::size_t count,
+		NmeaComposerValid& validity, std::size_t first) {
+	for (std::size_t i = 0; i < count; ++i) {
+		if (!line.number(values[i])) {
+			values[i] = 0;
+			validity.set(first + i);
+		}
+	}
+}
+
+/*
+ * Parses and composes the chunks of a log in parallel, writing them in order.
+ */
+class Converter {
+public:
+	Converter(const char* data, std::size_t size, Format format,
+			unsigned threads, std::size_t chunkBytes) :
+			records(0), sentences(0), skipped(0), bytes(0), data(data), format(
+					format), threads(threads), slots(threads * 2), nextChunk(0), written(
+					0) {
+		if (format == Format_Binary) {
+			chunkBytes -= chunkBytes % sizeof(BinaryRecord);
+			size -= size % sizeof(BinaryRecord);
+		}
+		boundaries.push_back(0);
+		for (std::size_t offset = chunkBytes; offset < size; offset +=
+				chunkBytes) {
+			std::size_t boundary = offset;
+			if (format == Format_Csv) {
+				const char* newline = static_cast<const char*>(std::memchr(
+						data + offset, '\n', size - offset));
+				boundary = newline != NULL ? newline + 1 - data : size;
+			}
+			if (boundary > boundaries.back() && boundary < size) {
+				boundaries.push_back(boundary);
+			}
+		}
+		boundaries.push_back(size);
+		for (Slot& slot : slots) {
+			slot.text.resize(chunkBytes + chunkBytes / 2 + 256);
+			slot.length = 0;
+			slot.ready = false;
+		}
+	}
+
+	/*
+	 * Returns false on a write error, errno telling which.
+	 */
+	bool run(int fd) {
+		std::vector<std::thread> workers;
+		for (unsigned i = 0; i < threads; ++i) {
+			workers.push_back(std::thread(&Converter::work, this));
+		}
+		bool ok = true;
+		for (std::size_t chunk = 0; chunk + 1 < boundaries.size(); ++chunk) {
+			Slot& slot = slots[chunk % slots.size()];
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				chunkComposed.wait(lock, [&] {
+					return slot.ready;
+				});
+			}
+			ok = ok && writeAll(fd, slot.text.data(), slot.length);
+			bytes += slot.length;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				slot.ready = false;
+				++written;
+			}
+			slotWritten.notify_all();
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		return ok;
+	}
+
+	uint64_t records;
+	uint64_t sentences;
+	uint64_t skipped;
+	uint64_t bytes;
+
+private:
+	void work() {
+		uint64_t chunkRecords = 0, chunkSentences = 0, chunkSkipped = 0;
+		for (;;) {
+			std::size_t chunk = nextChunk.fetch_add(1);
+			if (chunk + 1 >= boundaries.size()) {
+				break;
+			}
+			Slot& slot = slots[chunk % slots.size()];
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				slotWritten.wait(lock, [&] {
+					return chunk < written + slots.size();
+				});
+			}
+			slot.length = 0;
+			const char* begin = data + boundaries[chunk];
+			const char* end = data + boundaries[chunk + 1];
+			if (format == Format_Csv) {
+				while (begin < end) {
+					const char* newline = static_cast<const char*>(std::memchr(
+							begin, '\n', end - begin));
+					const char* lineEnd = newline != NULL ? newline : end;
+					const char* textEnd = lineEnd;
+					if (textEnd > begin && textEnd[-1] == '\r') {
+						--textEnd;
+					}
+					if (textEnd > begin && *begin != '#') {
+						++chunkRecords;
+						if (composeCsv(slot, begin, textEnd)) {
+							++chunkSentences;
+						} else {
+							++chunkSkipped;
+						}
+					}
+					begin = lineEnd + 1;
+				}
+			} else {
+				for (; begin < end; begin += sizeof(BinaryRecord)) {
+					BinaryRecord record;
+					std::memcpy(&record, begin, sizeof(record));
+					++chunkRecords;
+					if (composeBinary(slot, record)) {
+						++chunkSentences;
+					} else {
+						++chunkSkipped;
+					}
+				}
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				slot.ready = true;
+			}
+			chunkComposed.notify_one();
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		records += chunkRecords;
+		sentences += chunkSentences;
+		skipped += chunkSkipped;
+	}
+
+	/*
+	 * Record line: TYPE,TALKER,fields as in the composer; RMC time in Unix
+	 * seconds, MWV reference T or R; PRDID has no talker. Empty fields are
+	 * invalid.
+	 */
+	static bool composeCsv(Slot& slot, const char* begin, const char* end) {
+		CsvLine line(begin, end);
+		const char* name;
+		std::size_t nameLength;
+		Nmea_SentenceType type;
+		line.next(name, nameLength);
+		if (!nmeaEnumFromName(name, nameLength, type)) {
+			return false;
+		}
+		char talker[3] = "";
+		if (type != Nmea_SentenceType_PRDID) {
+			line.text(talker, sizeof(talker));
+		}
+		NmeaComposerValid validity;
+		double values[6];
+
+		switch (type) {
+		case Nmea_SentenceType_RMC: {
+			double seconds;
+			if (!line.number(seconds)) {
+				seconds = 0;
+				validity.set(0);
+				validity.set(5);
+			}
+			numbers(line, values, 4, validity, 1);
+			numbers(line, values + 4, 1, validity, 6);
+			std::chrono::microseconds time;
+			NmeaDate date;
+			utcOf(static_cast<int64_t>(seconds * 1e9), time, date);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeRMC(buffer, size, talker,
+						validity, time, values[0], values[1], values[2],
+						values[3], date, values[4]);
+			});
+			return true;
+		}
+		case Nmea_SentenceType_XDR: {
+			NmeaTransducer transducers[maxTransducers];
+			char names[maxTransducers][maxNameLength + 1];
+			std::size_t count = 0;
+			char transducerType;
+			while (count < maxTransducers && line.character(transducerType)) {
+				NmeaTransducer& transducer = transducers[count];
+				std::size_t bit = count * 4;
+				double value = 0;
+				transducer.transducerType = transducerType;
+				if (!line.number(value) && bit + 1 < validity.size()) {
+					validity.set(bit + 1);
+				}
+				transducer.measurementData = static_cast<float>(value);
+				if (!line.character(transducer.unitsOfMeasurement)) {
+					transducer.unitsOfMeasurement = ' ';
+				}
+				line.text(names[count], sizeof(names[count]));
+				transducer.nameOfTransducer = names[count];
+				++count;
+			}
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeXDR(buffer, size, talker,
+						validity, transducers, count);
+			});
+			return true;
+		}
+		case Nmea_SentenceType_MWV: {
+			char reference = 'R', units = 'N', status = 'A';
+			numbers(line, values, 1, validity, 0);
+			if (!line.character(reference)) {
+				validity.set(1);
+			}
+			numbers(line, values + 1, 1, validity, 2);
+			if (!line.character(units)) {
+				validity.set(3);
+			}
+			if (!line.character(status)) {
+				validity.set(4);
+			}
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeMWV(buffer, size, talker,
+						validity, values[0], reference == 'T' ?
+								Nmea_AngleReference_True :
+								Nmea_AngleReference_Relative, values[1],
+						units, status);
+			});
+			return true;
+		}
+		case Nmea_SentenceType_MWD:
+			numbers(line, values, 4, validity, 0);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeMWD(buffer, size, talker,
+						validity, values[0], values[1], values[2], values[3]);
+			});
+			return true;
+		case Nmea_SentenceType_HDT:
+			numbers(line, values, 1, validity, 0);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeHDT(buffer, size, talker,
+						validity, values[0]);
+			});
+			return true;
+		case Nmea_SentenceType_VLW:
+			numbers(line, values, 2, validity, 0);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeVLW(buffer, size, talker,
+						validity, values[0], values[1]);
+			});
+			return true;
+		case Nmea_SentenceType_VHW:
+			numbers(line, values, 4, validity, 0);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeVHW(buffer, size, talker,
+						validity, values[0], values[1], values[2], values[3]);
+			});
+			return true;
+		case Nmea_SentenceType_PRDID:
+			numbers(line, values, 3, validity, 0);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composePRDID(buffer, size, validity,
+						values[0], values[1], values[2]);
+			});
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static bool composeBinary(Slot& slot, const BinaryRecord& record) {
+		char talker[3] = { record.talker[0], record.talker[1], '\0' };
+		NmeaComposerValid validity(record.validity);
+		const double* values = record.values;
+
+		switch (record.type) {
+		case Nmea_SentenceType_RMC: {
+			std::chrono::microseconds time;
+			NmeaDate date;
+			utcOf(record.utcNs, time, date);
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeRMC(buffer, size, talker,
+						validity, time, values[0], values[1], values[2],
+						values[3], date, values[4]);
+			});
+			return true;
+		}
+		case Nmea_SentenceType_MWV:
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeMWV(buffer, size, talker,
+						validity, values[0], values[2] == 0 ?
+								Nmea_AngleReference_True :
+								Nmea_AngleReference_Relative, values[1],
+						static_cast<char>(values[3]),
+						static_cast<char>(values[4]));
+			});
+			return true;
+		case Nmea_SentenceType_MWD:
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeMWD(buffer, size, talker,
+						validity, values[0], values[1], values[2], values[3]);
+			});
+			return true;
+		case Nmea_SentenceType_HDT:
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeHDT(buffer, size, talker,
+						validity, values[0]);
+			});
+			return true;
+		case Nmea_SentenceType_VLW:
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeVLW(buffer, size, talker,
+						validity, values[0], values[1]);
+			});
+			return true;
+		case Nmea_SentenceType_VHW:
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composeVHW(buffer, size, talker,
+						validity, values[0], values[1], values[2], values[3]);
+			});
+			return true;
+		case Nmea_SentenceType_PRDID:
+			append(slot, [&](char* buffer, std::size_t size) {
+				return NmeaComposerCore::composePRDID(buffer, size, validity,
+						values[0], values[1], values[2]);
+			});
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static bool writeAll(int fd, const char* text, std::size_t length) {
+		while (length != 0) {
+			ssize_t count = ::write(fd, text, length);
+			if (count < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return false;
+			}
+			text += count;
+			length -= count;
+		}
+		return true;
+	}
+
+	const char* data;
+	Format format;
+	unsigned threads;
+	std::vector<std::size_t> boundaries;
+	std::vector<Slot> slots;
+	std::atomic<std::size_t> nextChunk;
+
+	std::mutex mutex;
+	std::condition_variable slotWritten;
+	std::condition_variable chunkComposed;
+	std::size_t written;
+};
+
+void usage() {
+	std::fprintf(stderr, "Usage: convert.libNmeaComposer [--format csv|binary] "
+			"[--threads N] [--chunk MIB] INPUT OUTPUT\n");
+}
+
+} // namespace
+/// @endcond
+
+int main(int argc, char* argv[]) {
+	Format format = Format_Csv;
+	unsigned threads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::size_t chunkBytes = std::size_t(8) << 20;
+	std::vector<const char*> paths;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+			format = std::strcmp(argv[++i], "binary") == 0 ?
+					Format_Binary : Format_Csv;
+		} else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+			threads = std::max(std::atoi(argv[++i]), 1);
+		} else if (std::strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+			chunkBytes = std::size_t(std::max(std::atoi(argv[++i]), 1)) << 20;
+		} else {
+			paths.push_back(argv[i]);
+		}
+	}
+	if (paths.size() != 2) {
+		usage();
+		return 2;
+	}
+
+	int input = ::open(paths[0], O_RDONLY);
+	struct stat status;
+	if (input < 0 || ::fstat(input, &status) != 0) {
+		std::perror(paths[0]);
+		return 1;
+	}
+	std::size_t size = status.st_size;
+	const char* data = static_cast<const char*>(size != 0 ?
+			::mmap(NULL, size, PROT_READ, MAP_PRIVATE, input, 0) : NULL);
+	if (data == MAP_FAILED) {
+		std::perror("mmap");
+		return 1;
+	}
+	if (size != 0) {
+		::madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+	}
+	int output = ::open(paths[1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (output < 0) {
+		std::perror(paths[1]);
+		return 1;
+	}
+
+	std::chrono::steady_clock::time_point start =
+			std::chrono::steady_clock::now();
+	Converter converter(data, size, format, threads, chunkBytes);
+	if (!converter.run(output)) {
+		std::perror(paths[1]);
+		return 1;
+	}
+	if (::close(output) != 0) {
+		std::perror(paths[1]);
+		return 1;
+	}
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	std::fprintf(stderr, "%llu records, %llu sentences, %llu skipped, "
+			"%.1f MB in, %.1f MB out, %.3f s, %.1f MB/s in\n",
+			static_cast<unsigned long long>(converter.records),
+			static_cast<unsigned long long>(converter.sentences),
+			static_cast<unsigned long long>(converter.skipped), size / 1e6,
+			converter.bytes / 1e6, seconds, size / 1e6 / seconds);
+	if (size != 0) {
+		::munmap(const_cast<char*>(data), size);
+	}
+	::close(input);
+	return 0;
+}